@@ -0,0 +1,433 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+#include "spatula/layouts.hpp"
+
+// data types and data structures
+#include <cstddef>
+#include <array>
+#include <utility>
+
+// algorithms
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace sp {
+
+/** An affine transform of N-dimensional points.
+ *
+ * The transform is stored as the top N rows of a row-major (N+1)×(N+1)
+ * matrix, whose last column is the translation. Transforms compose with *,
+ * where (a * b) applies b first and then a, like matrix products.
+ *
+ * Example:
+ *     auto const model = sp::affine3::translation(position) *
+ *                        sp::affine3::rotation(up, yaw) *
+ *                        sp::affine3::scaling(2.f);
+ *     sp::transform_points(model, vertices, world.begin());
+ */
+template<std::floating_point Scalar, std::size_t N>
+    requires (N == 2 or N == 3)
+struct affine {
+    using scalar = Scalar;
+    static constexpr std::size_t dimension = N;
+
+    std::array<std::array<Scalar, N + 1>, N> rows{};
+
+    /** The transform that leaves every point where it is. */
+    static constexpr affine identity()
+    {
+        affine result;
+        for (std::size_t i = 0; i < N; ++i) { result.rows[i][i] = Scalar{1}; }
+        return result;
+    }
+
+    /** The transform that moves every point by an offset. */
+    template<semivector Vector>
+        requires (dimension_v<Vector> == N)
+    static constexpr affine translation(Vector const & offset)
+    {
+        affine result = identity();
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((result.rows[I][N] = static_cast<Scalar>(get_component<I>(offset))), ...);
+        }(std::make_index_sequence<N>{});
+        return result;
+    }
+
+    /** The transform that scales every axis by the same factor. */
+    static constexpr affine scaling(Scalar factor)
+    {
+        affine result;
+        for (std::size_t i = 0; i < N; ++i) { result.rows[i][i] = factor; }
+        return result;
+    }
+
+    /** The transform that scales each axis by the matching component. */
+    template<semivector Vector>
+        requires (dimension_v<Vector> == N)
+    static constexpr affine scaling(Vector const & factors)
+    {
+        affine result;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((result.rows[I][I] = static_cast<Scalar>(get_component<I>(factors))), ...);
+        }(std::make_index_sequence<N>{});
+        return result;
+    }
+
+    /** The counterclockwise rotation about the origin by an angle in radians. */
+    static affine rotation(Scalar radians) requires (N == 2)
+    {
+        Scalar const c = std::cos(radians);
+        Scalar const s = std::sin(radians);
+        return affine{{{{c, -s, Scalar{0}}, {s, c, Scalar{0}}}}};
+    }
+
+    /** The rotation by an angle in radians about an axis through the origin,
+     * counterclockwise when the axis points towards the viewer. The axis
+     * doesn't need to be normalized, but it can't be zero.
+     */
+    template<semivector Vector>
+        requires (dimension_v<Vector> == 3)
+    static affine rotation(Vector const & axis, Scalar radians) requires (N == 3)
+    {
+        Scalar x = static_cast<Scalar>(get_x(axis));
+        Scalar y = static_cast<Scalar>(get_y(axis));
+        Scalar z = static_cast<Scalar>(get_z(axis));
+        Scalar const length = std::sqrt(x * x + y * y + z * z);
+        x /= length;
+        y /= length;
+        z /= length;
+
+        Scalar const c = std::cos(radians);
+        Scalar const s = std::sin(radians);
+        Scalar const t = Scalar{1} - c;
+        return affine{{{
+            {t * x * x + c,     t * x * y - s * z, t * x * z + s * y, Scalar{0}},
+            {t * x * y + s * z, t * y * y + c,     t * y * z - s * x, Scalar{0}},
+            {t * x * z - s * y, t * y * z + s * x, t * z * z + c,     Scalar{0}}
+        }}};
+    }
+
+    /** The transform that applies b and then a. */
+    friend constexpr affine operator*(affine const & a, affine const & b)
+    {
+        affine result;
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j <= N; ++j) {
+                Scalar sum = j == N? a.rows[i][N] : Scalar{0};
+                for (std::size_t k = 0; k < N; ++k) {
+                    sum += a.rows[i][k] * b.rows[k][j];
+                }
+                result.rows[i][j] = sum;
+            }
+        }
+        return result;
+    }
+
+    constexpr affine & operator*=(affine const & other)
+    {
+        return *this = *this * other;
+    }
+
+    friend constexpr bool operator==(affine const &, affine const &) = default;
+};
+
+using affine2 = affine<float, 2>;
+using affine3 = affine<float, 3>;
+using daffine2 = affine<double, 2>;
+using daffine3 = affine<double, 3>;
+
+/** The determinant of the linear part of a transform, which is how much it
+ * scales areas or volumes by, negative if it mirrors them.
+ */
+template<class Scalar, std::size_t N>
+constexpr Scalar determinant(affine<Scalar, N> const & m)
+{
+    auto const & r = m.rows;
+    if constexpr (N == 2) {
+        return r[0][0] * r[1][1] - r[0][1] * r[1][0];
+    }
+    else {
+        return r[0][0] * (r[1][1] * r[2][2] - r[1][2] * r[2][1]) -
+               r[0][1] * (r[1][0] * r[2][2] - r[1][2] * r[2][0]) +
+               r[0][2] * (r[1][0] * r[2][1] - r[1][1] * r[2][0]);
+    }
+}
+
+/** The transform that undoes another.
+ *
+ * Throws
+ *   std::domain_error if the transform is singular, collapsing space onto a
+ *   line or a plane so that it can't be undone
+ */
+template<class Scalar, std::size_t N>
+constexpr affine<Scalar, N> inverse(affine<Scalar, N> const & m)
+{
+    Scalar const det = determinant(m);
+    if (not (det < Scalar{0} or det > Scalar{0})) {
+        throw std::domain_error{"affine transform is singular"};
+    }
+
+    // the linear part is inverted through its adjugate
+    auto const & r = m.rows;
+    affine<Scalar, N> result;
+    auto & q = result.rows;
+    if constexpr (N == 2) {
+        q[0][0] = r[1][1];
+        q[0][1] = -r[0][1];
+        q[1][0] = -r[1][0];
+        q[1][1] = r[0][0];
+    }
+    else {
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                // the cofactor of the transposed entry, with the sign folded
+                // into the cyclic order of the rows and columns
+                std::size_t const i1 = (j + 1) % 3, i2 = (j + 2) % 3;
+                std::size_t const j1 = (i + 1) % 3, j2 = (i + 2) % 3;
+                q[i][j] = r[i1][j1] * r[i2][j2] - r[i1][j2] * r[i2][j1];
+            }
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) { q[i][j] /= det; }
+    }
+
+    // and the translation is moved back through the inverted linear part
+    for (std::size_t i = 0; i < N; ++i) {
+        Scalar sum{0};
+        for (std::size_t k = 0; k < N; ++k) { sum -= q[i][k] * r[k][N]; }
+        q[i][N] = sum;
+    }
+    return result;
+}
+
+/** Transform a point, translation included. */
+template<class Scalar, std::size_t N, semivector Vector>
+    requires (dimension_v<Vector> == N)
+
+constexpr Vector transform_point(affine<Scalar, N> const & m, Vector const & p)
+{
+    using component = scalar_field_t<Vector>;
+    Vector result{};
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        std::array<Scalar, N> const x{static_cast<Scalar>(get_component<I>(p))...};
+        auto const row = [&](std::size_t i) {
+            return m.rows[i][N] + ((m.rows[i][I] * x[I]) + ...);
+        };
+        ((get_component<I>(result) = static_cast<component>(row(I))), ...);
+    }(std::make_index_sequence<N>{});
+    return result;
+}
+
+/** Transform a direction or displacement, which only the linear part of a
+ * transform applies to.
+ */
+template<class Scalar, std::size_t N, semivector Vector>
+    requires (dimension_v<Vector> == N)
+
+constexpr Vector transform_vector(affine<Scalar, N> const & m, Vector const & v)
+{
+    using component = scalar_field_t<Vector>;
+    Vector result{};
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        std::array<Scalar, N> const x{static_cast<Scalar>(get_component<I>(v))...};
+        auto const row = [&](std::size_t i) {
+            return ((m.rows[i][I] * x[I]) + ...);
+        };
+        ((get_component<I>(result) = static_cast<component>(row(I))), ...);
+    }(std::make_index_sequence<N>{});
+    return result;
+}
+
+namespace detail {
+
+#if defined(__AVX__)
+// load eight packed float points of three components into registers of x, y
+// and z coordinates
+inline void load_points3(float const * p, __m256 & x, __m256 & y, __m256 & z)
+{
+    // the low lanes hold points 0-3 and the high lanes points 4-7
+    __m256 const a = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+    __m256 const b = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+    __m256 const c = _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+
+    // x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3 -> x0 x1 x2 x3, ...
+    __m256 const xy = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+    __m256 const yz = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm256_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm256_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+// the inverse of load_points3
+inline void store_points3(float * p, __m256 x, __m256 y, __m256 z)
+{
+    __m256 const u = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 const v = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+    __m256 const w = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+    __m256 const a = _mm256_shuffle_ps(u, w, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 const b = _mm256_shuffle_ps(v, u, _MM_SHUFFLE(3, 1, 2, 0));
+    __m256 const c = _mm256_shuffle_ps(w, v, _MM_SHUFFLE(3, 1, 3, 1));
+    _mm256_storeu_ps(p, _mm256_permute2f128_ps(a, b, 0x20));
+    _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(c, a, 0x30));
+    _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(b, c, 0x31));
+}
+
+inline __m256 multiply_add(__m256 a, __m256 b, __m256 c)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+// the rows of a float transform broadcast across registers
+template<std::size_t N>
+struct broadcast_affine {
+    __m256 rows[N][N + 1];
+
+    explicit broadcast_affine(affine<float, N> const & m)
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j <= N; ++j) {
+                rows[i][j] = _mm256_set1_ps(m.rows[i][j]);
+            }
+        }
+    }
+
+    // one row of the transform applied to eight points at once
+    __m256 row(std::size_t i, __m256 x, __m256 y) const
+    {
+        __m256 const sum = multiply_add(rows[i][0], x, rows[i][2]);
+        return multiply_add(rows[i][1], y, sum);
+    }
+
+    __m256 row(std::size_t i, __m256 x, __m256 y, __m256 z) const
+    {
+        __m256 sum = multiply_add(rows[i][0], x, rows[i][3]);
+        sum = multiply_add(rows[i][1], y, sum);
+        return multiply_add(rows[i][2], z, sum);
+    }
+};
+#endif
+
+// transform packed float points, eight at a time with AVX when it's enabled:
+// each block of eight is transposed into registers of x, y (and z)
+// coordinates, transformed, and transposed back, so that the points can be
+// transformed in place
+template<std::size_t N>
+void transform_floats(affine<float, N> const & m, float const * in,
+                      std::size_t count, float * out)
+{
+    std::size_t k = 0;
+#if defined(__AVX__)
+    broadcast_affine<N> const b{m};
+    if constexpr (N == 2) {
+        for (; k + 8 <= count; k += 8) {
+            // x0 x1 x4 x5 | x2 x3 x6 x7, and likewise for y
+            __m256 const low = _mm256_loadu_ps(in + 2 * k);
+            __m256 const high = _mm256_loadu_ps(in + 2 * k + 8);
+            __m256 const x = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+            __m256 const y = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+
+            __m256 const tx = b.row(0, x, y);
+            __m256 const ty = b.row(1, x, y);
+            _mm256_storeu_ps(out + 2 * k, _mm256_unpacklo_ps(tx, ty));
+            _mm256_storeu_ps(out + 2 * k + 8, _mm256_unpackhi_ps(tx, ty));
+        }
+    }
+    else {
+        for (; k + 8 <= count; k += 8) {
+            __m256 x, y, z;
+            load_points3(in + 3 * k, x, y, z);
+            store_points3(out + 3 * k, b.row(0, x, y, z), b.row(1, x, y, z),
+                          b.row(2, x, y, z));
+        }
+    }
+#endif
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        for (; k < count; ++k) {
+            std::array<float, N> const p{in[N * k + I]...};
+            auto const row = [&](std::size_t i) {
+                return m.rows[i][N] + ((m.rows[i][I] * p[I]) + ...);
+            };
+            ((out[N * k + I] = row(I)), ...);
+        }
+    }(std::make_index_sequence<N>{});
+}
+}
+
+/** Transform a range of points.
+ *
+ * Return
+ *   An iterator past the last transformed point.
+ *
+ * Parameters
+ *   m - the transform to apply
+ *   points - the points to transform
+ *   out - iterator to the start of the transformed points, which may be the
+ *         start of the points themselves
+ *
+ * Contiguous ranges of packed float points are transformed eight at a time
+ * with AVX when it's enabled, transposing each block of eight into registers
+ * of one coordinate each. Other points are transformed one at a time.
+ *
+ * Example:
+ *     std::vector<vec3> world(vertices.size());
+ *     sp::transform_points(model, vertices, world.begin());
+ */
+template<class Scalar, std::size_t N, ranges::input_range Range,
+         std::weakly_incrementable Out>
+    requires semivector<ranges::range_value_t<Range>> and
+             (dimension_v<ranges::range_value_t<Range>> == N) and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out transform_points(affine<Scalar, N> const & m, Range && points, Out out)
+{
+    using Vector = ranges::range_value_t<Range>;
+    if constexpr (std::same_as<Scalar, float> and
+                  std::same_as<scalar_field_t<Vector>, float> and
+                  packed_layout<Vector> and
+                  ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+                  detail::contiguous_output<Out, Vector>) {
+        auto const count = static_cast<std::size_t>(ranges::size(points));
+        detail::transform_floats(
+            m, reinterpret_cast<float const *>(ranges::data(points)), count,
+            reinterpret_cast<float *>(std::to_address(out)));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        for (auto const & p : points) {
+            *out = transform_point(m, p);
+            ++out;
+        }
+        return out;
+    }
+}
+
+/** Transform a range of points in place. */
+template<class Scalar, std::size_t N, ranges::forward_range Range>
+    requires semivector<ranges::range_value_t<Range>> and
+             (dimension_v<ranges::range_value_t<Range>> == N) and
+             std::indirectly_writable<ranges::iterator_t<Range>,
+                                      ranges::range_value_t<Range>>
+
+void transform_points(affine<Scalar, N> const & m, Range && points)
+{
+    transform_points(m, points, ranges::begin(points));
+}
+}
@@ -0,0 +1,715 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <memory>
+
+// algorithms
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace sp {
+
+namespace ranges = std::ranges;
+
+/** A color of four 8-bit channels r, g, b and a, stored in that order.
+ *
+ * Example:
+ *     static_assert(sp::rgba8_color<SDL_Color>);
+ *     static_assert(sp::rgba8_color<sf::Color>);
+ */
+template<class Color>
+concept rgba8_color = std::semiregular<Color> and
+                      std::is_trivially_copyable_v<Color> and
+                      std::is_standard_layout_v<Color> and
+                      (sizeof(Color) == 4) and
+requires(Color c) {
+    requires std::same_as<decltype(c.r), std::uint8_t>;
+    requires std::same_as<decltype(c.g), std::uint8_t>;
+    requires std::same_as<decltype(c.b), std::uint8_t>;
+    requires std::same_as<decltype(c.a), std::uint8_t>;
+} and (offsetof(Color, r) == 0) and (offsetof(Color, g) == 1) and
+      (offsetof(Color, b) == 2) and (offsetof(Color, a) == 3);
+
+namespace detail {
+
+// x / 255 rounded to nearest, for x in [0, 255²]
+constexpr std::uint8_t div255(unsigned x)
+{
+    x += 128;
+    return static_cast<std::uint8_t>((x + (x >> 8)) >> 8);
+}
+
+// (a * (255 - w) + b * w) / 255 rounded to nearest
+constexpr std::uint8_t mix8(std::uint8_t a, std::uint8_t b, unsigned w)
+{
+    return div255(a * (255u - w) + b * w);
+}
+
+inline std::array<std::uint8_t, 256> const & srgb_decode_table()
+{
+    static auto const table = [] {
+        std::array<std::uint8_t, 256> values{};
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            double const c = static_cast<double>(i) / 255.0;
+            double const linear = c <= 0.04045? c / 12.92 :
+                                  std::pow((c + 0.055) / 1.055, 2.4);
+            values[i] = static_cast<std::uint8_t>(std::lround(linear * 255.0));
+        }
+        return values;
+    }();
+    return table;
+}
+
+inline std::array<std::uint8_t, 256> const & srgb_encode_table()
+{
+    static auto const table = [] {
+        std::array<std::uint8_t, 256> values{};
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            double const linear = static_cast<double>(i) / 255.0;
+            double const c = linear <= 0.0031308? linear * 12.92 :
+                             1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+            values[i] = static_cast<std::uint8_t>(std::lround(c * 255.0));
+        }
+        return values;
+    }();
+    return table;
+}
+
+inline std::array<float, 256> const & srgb_linear_table()
+{
+    static auto const table = [] {
+        std::array<float, 256> values{};
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            double const c = static_cast<double>(i) / 255.0;
+            values[i] = static_cast<float>(c <= 0.04045? c / 12.92 :
+                                           std::pow((c + 0.055) / 1.055, 2.4));
+        }
+        return values;
+    }();
+    return table;
+}
+
+// the linear light halfway between each pair of consecutive sRGB levels, in
+// sRGB terms, so counting the thresholds below a value rounds it to a level
+inline std::array<float, 255> const & srgb_thresholds()
+{
+    static auto const table = [] {
+        std::array<float, 255> values{};
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            double const c = (static_cast<double>(i) + 0.5) / 255.0;
+            values[i] = static_cast<float>(c <= 0.04045? c / 12.92 :
+                                           std::pow((c + 0.055) / 1.055, 2.4));
+        }
+        return values;
+    }();
+    return table;
+}
+}
+
+//
+// Color operations
+//
+
+/** Scale the color channels of a straight-alpha color by its alpha. */
+template<rgba8_color Color>
+constexpr Color premultiply(Color c)
+{
+    c.r = detail::div255(c.r * unsigned{c.a});
+    c.g = detail::div255(c.g * unsigned{c.a});
+    c.b = detail::div255(c.b * unsigned{c.a});
+    return c;
+}
+
+/** Divide the color channels of a premultiplied color by its alpha.
+ *
+ * Fully transparent colors become transparent black, and channels greater
+ * than alpha saturate to 255.
+ */
+template<rgba8_color Color>
+constexpr Color unpremultiply(Color c)
+{
+    unsigned const a = c.a;
+    auto const divide = [a](unsigned channel) {
+        return static_cast<std::uint8_t>(
+            std::min(255u, (channel * 255u + a / 2) / a));
+    };
+    if (a == 0) {
+        c.r = c.g = c.b = 0;
+        return c;
+    }
+    c.r = divide(c.r);
+    c.g = divide(c.g);
+    c.b = divide(c.b);
+    return c;
+}
+
+/** Draw a straight-alpha color over another.
+ *
+ * The color channels are mixed by the source alpha, and the alpha channel is
+ * a + da(1 - a), the same as SDL's blend mode.
+ */
+template<rgba8_color Color>
+constexpr Color blend(Color const & source, Color const & destination)
+{
+    unsigned const a = source.a;
+    Color c = destination;
+    c.r = detail::mix8(destination.r, source.r, a);
+    c.g = detail::mix8(destination.g, source.g, a);
+    c.b = detail::mix8(destination.b, source.b, a);
+    c.a = detail::div255(a * 255u + destination.a * (255u - a));
+    return c;
+}
+
+/** Interpolate every channel between two colors.
+ *
+ * The parameter t is clamped to [0, 1] and quantized to 1/255 steps.
+ */
+template<rgba8_color Color>
+constexpr Color lerp(Color const & from, Color const & to, float t)
+{
+    auto const w = static_cast<unsigned>(std::clamp(t, 0.f, 1.f) * 255.f + .5f);
+    Color c = from;
+    c.r = detail::mix8(from.r, to.r, w);
+    c.g = detail::mix8(from.g, to.g, w);
+    c.b = detail::mix8(from.b, to.b, w);
+    c.a = detail::mix8(from.a, to.a, w);
+    return c;
+}
+
+/** The linear light of an sRGB-encoded 8-bit channel, in [0, 1].
+ *
+ * Unlike 8-bit linear colors, every sRGB level keeps a distinct value, and
+ * srgb_encode turns it back into the same level.
+ */
+inline float srgb_decode(std::uint8_t channel)
+{
+    return detail::srgb_linear_table()[channel];
+}
+
+/** The sRGB-encoded 8-bit channel nearest to linear light, which is clamped
+ * to [0, 1].
+ */
+inline std::uint8_t srgb_encode(float linear)
+{
+    if (not (linear > 0.f)) { return 0; }
+    auto const & thresholds = detail::srgb_thresholds();
+    return static_cast<std::uint8_t>(
+        ranges::upper_bound(thresholds, linear) - thresholds.begin());
+}
+
+/** Convert the color channels of an sRGB-encoded color to linear light.
+ *
+ * Linear light is quantized to 8 bits, which merges the darkest sRGB levels:
+ * the 256 levels map to only 183 linear ones, and converting back with
+ * linear_to_srgb may be off by up to 6 levels. Use srgb_decode where the
+ * linear values need to be exact.
+ */
+template<rgba8_color Color>
+Color srgb_to_linear(Color c)
+{
+    auto const & table = detail::srgb_decode_table();
+    c.r = table[c.r];
+    c.g = table[c.g];
+    c.b = table[c.b];
+    return c;
+}
+
+/** Convert the color channels of a linear color to the sRGB encoding. */
+template<rgba8_color Color>
+Color linear_to_srgb(Color c)
+{
+    auto const & table = detail::srgb_encode_table();
+    c.r = table[c.r];
+    c.g = table[c.g];
+    c.b = table[c.b];
+    return c;
+}
+
+/** Exchange the red and blue channels of a color, which converts between RGBA
+ * and BGRA byte orders.
+ */
+template<rgba8_color Color>
+constexpr Color swap_red_blue(Color c)
+{
+    std::swap(c.r, c.b);
+    return c;
+}
+
+namespace detail {
+
+#if defined(__SSE2__)
+
+// the operations of the kernels on one register of pixels, so that each kernel
+// is written once for both SSE2 and AVX2
+struct sse2_pixels {
+    using reg = __m128i;
+    static constexpr std::size_t count = 4;
+
+    static reg load(std::uint8_t const * p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+    }
+    static void store(std::uint8_t * p, reg x)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), x);
+    }
+    static reg set1_epi16(std::int16_t x) { return _mm_set1_epi16(x); }
+    static reg set1_epi64(std::int64_t x) { return _mm_set1_epi64x(x); }
+    static reg unpacklo_epu8(reg x) { return _mm_unpacklo_epi8(x, _mm_setzero_si128()); }
+    static reg unpackhi_epu8(reg x) { return _mm_unpackhi_epi8(x, _mm_setzero_si128()); }
+    static reg packus_epi16(reg a, reg b) { return _mm_packus_epi16(a, b); }
+    static reg add_epi16(reg a, reg b) { return _mm_add_epi16(a, b); }
+    static reg sub_epi16(reg a, reg b) { return _mm_sub_epi16(a, b); }
+    static reg mullo_epi16(reg a, reg b) { return _mm_mullo_epi16(a, b); }
+    static reg or_si(reg a, reg b) { return _mm_or_si128(a, b); }
+    static reg srli_epi16_8(reg x) { return _mm_srli_epi16(x, 8); }
+    static reg broadcast_alpha(reg x)
+    {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xff), 0xff);
+    }
+    static reg swap_red_blue(reg x)
+    {
+#if defined(__SSSE3__)
+        return _mm_shuffle_epi8(x, _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7,
+                                                 10, 9, 8, 11, 14, 13, 12, 15));
+#else
+        __m128i const ga = _mm_and_si128(x, _mm_set1_epi32(static_cast<int>(0xff00ff00u)));
+        __m128i const rb = _mm_and_si128(x, _mm_set1_epi32(0x00ff00ff));
+        return _mm_or_si128(ga, _mm_shufflehi_epi16(_mm_shufflelo_epi16(rb, 0xb1), 0xb1));
+#endif
+    }
+};
+
+#if defined(__AVX2__)
+struct avx2_pixels {
+    using reg = __m256i;
+    static constexpr std::size_t count = 8;
+
+    static reg load(std::uint8_t const * p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p));
+    }
+    static void store(std::uint8_t * p, reg x)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);
+    }
+    static reg set1_epi16(std::int16_t x) { return _mm256_set1_epi16(x); }
+    static reg set1_epi64(std::int64_t x) { return _mm256_set1_epi64x(x); }
+    static reg unpacklo_epu8(reg x) { return _mm256_unpacklo_epi8(x, _mm256_setzero_si256()); }
+    static reg unpackhi_epu8(reg x) { return _mm256_unpackhi_epi8(x, _mm256_setzero_si256()); }
+    static reg packus_epi16(reg a, reg b) { return _mm256_packus_epi16(a, b); }
+    static reg add_epi16(reg a, reg b) { return _mm256_add_epi16(a, b); }
+    static reg sub_epi16(reg a, reg b) { return _mm256_sub_epi16(a, b); }
+    static reg mullo_epi16(reg a, reg b) { return _mm256_mullo_epi16(a, b); }
+    static reg or_si(reg a, reg b) { return _mm256_or_si256(a, b); }
+    static reg srli_epi16_8(reg x) { return _mm256_srli_epi16(x, 8); }
+    static reg broadcast_alpha(reg x)
+    {
+        return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xff), 0xff);
+    }
+    static reg swap_red_blue(reg x)
+    {
+        return _mm256_shuffle_epi8(x, _mm256_setr_epi8(
+            2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+            2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15));
+    }
+};
+#endif
+
+// round(x / 255) on unpacked 16-bit channels, like div255
+template<class Pixels>
+typename Pixels::reg div255_epu16(typename Pixels::reg x)
+{
+    x = Pixels::add_epi16(x, Pixels::set1_epi16(128));
+    return Pixels::srli_epi16_8(Pixels::add_epi16(x, Pixels::srli_epi16_8(x)));
+}
+
+// the weights of the alpha lanes of unpacked pixels
+template<class Pixels>
+typename Pixels::reg alpha_lanes(std::int16_t weight)
+{
+    return Pixels::set1_epi64(static_cast<std::int64_t>(weight) << 48);
+}
+
+// apply a kernel to every whole register of pixels, eight at a time with AVX2
+// and then four at a time with SSE2, returning the amount of pixels processed
+template<class Kernel>
+std::size_t for_pixels(std::size_t count, Kernel && kernel)
+{
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + avx2_pixels::count <= count; i += avx2_pixels::count) {
+        kernel(avx2_pixels{}, i * 4);
+    }
+#endif
+    for (; i + sse2_pixels::count <= count; i += sse2_pixels::count) {
+        kernel(sse2_pixels{}, i * 4);
+    }
+    return i;
+}
+
+inline std::size_t premultiply_pixels(std::uint8_t const * in,
+                                      std::uint8_t * out, std::size_t count)
+{
+    return for_pixels(count, [&]<class P>(P, std::size_t byte) {
+        auto const opaque = alpha_lanes<P>(255);
+        auto const premultiply_half = [&](typename P::reg x) {
+            auto const weight = P::or_si(P::broadcast_alpha(x), opaque);
+            return div255_epu16<P>(P::mullo_epi16(x, weight));
+        };
+        auto const x = P::load(in + byte);
+        P::store(out + byte, P::packus_epi16(premultiply_half(P::unpacklo_epu8(x)),
+                                             premultiply_half(P::unpackhi_epu8(x))));
+    });
+}
+
+inline std::size_t blend_pixels(std::uint8_t const * source,
+                                std::uint8_t const * destination,
+                                std::uint8_t * out, std::size_t count)
+{
+    return for_pixels(count, [&]<class P>(P, std::size_t byte) {
+        auto const full = P::set1_epi16(255);
+        auto const opaque = alpha_lanes<P>(255);
+        auto const blend_half = [&](typename P::reg s, typename P::reg d) {
+            auto const a = P::broadcast_alpha(s);
+            return div255_epu16<P>(P::add_epi16(
+                P::mullo_epi16(s, P::or_si(a, opaque)),
+                P::mullo_epi16(d, P::sub_epi16(full, a))));
+        };
+        auto const s = P::load(source + byte);
+        auto const d = P::load(destination + byte);
+        P::store(out + byte, P::packus_epi16(
+            blend_half(P::unpacklo_epu8(s), P::unpacklo_epu8(d)),
+            blend_half(P::unpackhi_epu8(s), P::unpackhi_epu8(d))));
+    });
+}
+
+inline std::size_t lerp_pixels(std::uint8_t const * from, std::uint8_t const * to,
+                               std::uint8_t * out, std::size_t count, unsigned w)
+{
+    return for_pixels(count, [&]<class P>(P, std::size_t byte) {
+        auto const wa = P::set1_epi16(static_cast<std::int16_t>(255 - w));
+        auto const wb = P::set1_epi16(static_cast<std::int16_t>(w));
+        auto const lerp_half = [&](typename P::reg a, typename P::reg b) {
+            return div255_epu16<P>(P::add_epi16(P::mullo_epi16(a, wa),
+                                                P::mullo_epi16(b, wb)));
+        };
+        auto const a = P::load(from + byte);
+        auto const b = P::load(to + byte);
+        P::store(out + byte, P::packus_epi16(
+            lerp_half(P::unpacklo_epu8(a), P::unpacklo_epu8(b)),
+            lerp_half(P::unpackhi_epu8(a), P::unpackhi_epu8(b))));
+    });
+}
+
+inline std::size_t swap_red_blue_pixels(std::uint8_t const * in,
+                                        std::uint8_t * out, std::size_t count)
+{
+    return for_pixels(count, [&]<class P>(P, std::size_t byte) {
+        P::store(out + byte, P::swap_red_blue(P::load(in + byte)));
+    });
+}
+
+// divide in single precision, whose correctly rounded quotients round the same
+// way as the exact ones for every 8-bit numerator and denominator
+inline std::size_t unpremultiply_pixels(std::uint8_t const * in,
+                                        std::uint8_t * out, std::size_t count)
+{
+    using P = sse2_pixels;
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const alpha_mask = _mm_set1_epi32(static_cast<int>(0xff000000u));
+    __m128 const scale = _mm_set1_ps(255.f);
+    __m128 const one = _mm_set1_ps(1.f);
+    __m128 const half = _mm_set1_ps(.5f);
+    auto const divide = [&](__m128i pixel) {
+        __m128 const c = _mm_cvtepi32_ps(pixel);
+        __m128 const a = _mm_max_ps(_mm_shuffle_ps(c, c, 0xff), one);
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_div_ps(_mm_mul_ps(c, scale), a), half));
+    };
+    std::size_t i = 0;
+    for (; i + P::count <= count; i += P::count) {
+        __m128i const x = P::load(in + i * 4);
+        __m128i const lo = P::unpacklo_epu8(x);
+        __m128i const hi = P::unpackhi_epu8(x);
+        // the quotients saturate to 255 as they're packed back into bytes
+        __m128i const q = _mm_packus_epi16(
+            _mm_packs_epi32(divide(_mm_unpacklo_epi16(lo, zero)),
+                            divide(_mm_unpackhi_epi16(lo, zero))),
+            _mm_packs_epi32(divide(_mm_unpacklo_epi16(hi, zero)),
+                            divide(_mm_unpackhi_epi16(hi, zero))));
+        __m128i const alpha = _mm_and_si128(x, alpha_mask);
+        __m128i const transparent = _mm_cmpeq_epi32(alpha, zero);
+        P::store(out + i * 4, _mm_or_si128(
+            _mm_andnot_si128(_mm_or_si128(transparent, alpha_mask), q), alpha));
+    }
+    return i;
+}
+
+#else
+
+// without SSE2 every color takes the scalar path
+inline std::size_t premultiply_pixels(std::uint8_t const *, std::uint8_t *,
+                                      std::size_t) { return 0; }
+inline std::size_t unpremultiply_pixels(std::uint8_t const *, std::uint8_t *,
+                                        std::size_t) { return 0; }
+inline std::size_t blend_pixels(std::uint8_t const *, std::uint8_t const *,
+                                std::uint8_t *, std::size_t) { return 0; }
+inline std::size_t lerp_pixels(std::uint8_t const *, std::uint8_t const *,
+                               std::uint8_t *, std::size_t, unsigned) { return 0; }
+inline std::size_t swap_red_blue_pixels(std::uint8_t const *, std::uint8_t *,
+                                        std::size_t) { return 0; }
+
+#endif
+
+// an output iterator that the SIMD kernels can write to directly
+template<class Out, class Color>
+concept contiguous_colors = std::contiguous_iterator<Out> and
+                            std::same_as<std::iter_value_t<Out>, Color>;
+
+// run a SIMD kernel over as many whole registers of a contiguous batch as
+// possible, then finish the rest of the batch one color at a time
+template<class Range, class Out, class Kernel, class Op>
+Out transform_colors(Range && colors, Out out, Kernel && kernel, Op && op)
+{
+    auto first = ranges::begin(colors);
+    auto const last = ranges::end(colors);
+    if constexpr (ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+                  contiguous_colors<Out, ranges::range_value_t<Range>>) {
+        std::size_t const done = kernel(
+            reinterpret_cast<std::uint8_t const *>(ranges::data(colors)),
+            reinterpret_cast<std::uint8_t *>(std::to_address(out)),
+            static_cast<std::size_t>(ranges::size(colors)));
+        first += static_cast<std::ptrdiff_t>(done);
+        out += static_cast<std::iter_difference_t<Out>>(done);
+    }
+    for (; first != last; ++first, ++out) { *out = op(*first); }
+    return out;
+}
+
+template<class RangeA, class RangeB, class Out, class Kernel, class Op>
+Out transform_colors(RangeA && a, RangeB && b, Out out, Kernel && kernel, Op && op)
+{
+    auto first_a = ranges::begin(a);
+    auto first_b = ranges::begin(b);
+    auto const last_a = ranges::end(a);
+    auto const last_b = ranges::end(b);
+    if constexpr (ranges::contiguous_range<RangeA> and ranges::sized_range<RangeA> and
+                  ranges::contiguous_range<RangeB> and ranges::sized_range<RangeB> and
+                  contiguous_colors<Out, ranges::range_value_t<RangeA>>) {
+        std::size_t const done = kernel(
+            reinterpret_cast<std::uint8_t const *>(ranges::data(a)),
+            reinterpret_cast<std::uint8_t const *>(ranges::data(b)),
+            reinterpret_cast<std::uint8_t *>(std::to_address(out)),
+            static_cast<std::size_t>(std::min<std::size_t>(ranges::size(a),
+                                                           ranges::size(b))));
+        first_a += static_cast<std::ptrdiff_t>(done);
+        first_b += static_cast<std::ptrdiff_t>(done);
+        out += static_cast<std::iter_difference_t<Out>>(done);
+    }
+    for (; first_a != last_a and first_b != last_b; ++first_a, ++first_b, ++out) {
+        *out = op(*first_a, *first_b);
+    }
+    return out;
+}
+}
+
+//
+// Batch operations
+//
+
+/** Premultiply a batch of straight-alpha colors.
+ *
+ * Return
+ *   An iterator past the last premultiplied color.
+ *
+ * Parameters
+ *   colors - the colors to premultiply
+ *   out - iterator to the start of the premultiplied colors, which may be the
+ *         start of colors
+ *
+ * Contiguous batches are processed four colors at a time with SSE2, or eight
+ * at a time when compiled with AVX2, with the same results as premultiply.
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires rgba8_color<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out premultiply(Range && colors, Out out)
+{
+    using Color = ranges::range_value_t<Range>;
+    return detail::transform_colors(colors, out, detail::premultiply_pixels,
+                                    premultiply<Color>);
+}
+
+/** Unpremultiply a batch of premultiplied colors.
+ *
+ * Return
+ *   An iterator past the last unpremultiplied color.
+ *
+ * Parameters
+ *   colors - the colors to unpremultiply
+ *   out - iterator to the start of the unpremultiplied colors, which may be the
+ *         start of colors
+ *
+ * Contiguous batches are divided four colors at a time in single precision
+ * with SSE2, with the same results as unpremultiply.
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires rgba8_color<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out unpremultiply(Range && colors, Out out)
+{
+    using Color = ranges::range_value_t<Range>;
+    return detail::transform_colors(colors, out, detail::unpremultiply_pixels,
+                                    unpremultiply<Color>);
+}
+
+/** Draw a batch of straight-alpha colors over another.
+ *
+ * Return
+ *   An iterator past the last blended color.
+ *
+ * Parameters
+ *   sources - the colors to draw
+ *   destinations - the colors to draw over, paired with sources
+ *   out - iterator to the start of the blended colors, which may be the start
+ *         of destinations
+ *
+ * The batches are blended up to the end of the shorter one. Contiguous
+ * batches are processed four colors at a time with SSE2, or eight at a time
+ * when compiled with AVX2, with the same results as blend.
+ *
+ * Example:
+ *     std::vector<SDL_Color> sprite = ..., framebuffer = ...;
+ *     sp::blend(sprite, framebuffer, framebuffer.begin());
+ */
+template<ranges::input_range Sources, ranges::input_range Destinations,
+         std::weakly_incrementable Out>
+    requires rgba8_color<ranges::range_value_t<Sources>> and
+             std::same_as<ranges::range_value_t<Sources>,
+                          ranges::range_value_t<Destinations>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Sources>>
+
+Out blend(Sources && sources, Destinations && destinations, Out out)
+{
+    using Color = ranges::range_value_t<Sources>;
+    return detail::transform_colors(sources, destinations, out,
+                                    detail::blend_pixels, blend<Color>);
+}
+
+/** Interpolate every channel between two batches of colors.
+ *
+ * Return
+ *   An iterator past the last interpolated color.
+ *
+ * Parameters
+ *   from - the colors at t = 0
+ *   to - the colors at t = 1, paired with from
+ *   t - the interpolation parameter, clamped to [0, 1]
+ *   out - iterator to the start of the interpolated colors
+ *
+ * The batches are interpolated up to the end of the shorter one, with the same
+ * results as lerp and the same SIMD paths as blend.
+ */
+template<ranges::input_range From, ranges::input_range To,
+         std::weakly_incrementable Out>
+    requires rgba8_color<ranges::range_value_t<From>> and
+             std::same_as<ranges::range_value_t<From>, ranges::range_value_t<To>> and
+             std::indirectly_writable<Out, ranges::range_value_t<From>>
+
+Out lerp(From && from, To && to, float t, Out out)
+{
+    using Color = ranges::range_value_t<From>;
+    auto const w = static_cast<unsigned>(std::clamp(t, 0.f, 1.f) * 255.f + .5f);
+    return detail::transform_colors(from, to, out,
+        [w](std::uint8_t const * a, std::uint8_t const * b, std::uint8_t * dst,
+            std::size_t count) {
+            return detail::lerp_pixels(a, b, dst, count, w);
+        },
+        [t](Color const & a, Color const & b) { return lerp(a, b, t); });
+}
+
+/** Convert a batch of sRGB-encoded colors to linear light.
+ *
+ * Return
+ *   An iterator past the last converted color.
+ *
+ * Parameters
+ *   colors - the colors to convert
+ *   out - iterator to the start of the converted colors
+ *
+ * Each channel is a single table lookup, with the same 8-bit loss as
+ * converting a single color. Alpha is left as is.
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires rgba8_color<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out srgb_to_linear(Range && colors, Out out)
+{
+    using Color = ranges::range_value_t<Range>;
+    return ranges::transform(colors, out, srgb_to_linear<Color>).out;
+}
+
+/** Convert a batch of linear colors to the sRGB encoding.
+ *
+ * Return
+ *   An iterator past the last converted color.
+ *
+ * Parameters
+ *   colors - the colors to convert
+ *   out - iterator to the start of the converted colors
+ *
+ * Each channel is a single table lookup. Alpha is left as is.
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires rgba8_color<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out linear_to_srgb(Range && colors, Out out)
+{
+    using Color = ranges::range_value_t<Range>;
+    return ranges::transform(colors, out, linear_to_srgb<Color>).out;
+}
+
+/** Exchange the red and blue channels of a batch of colors.
+ *
+ * Return
+ *   An iterator past the last swizzled color.
+ *
+ * Parameters
+ *   colors - the colors to swizzle
+ *   out - iterator to the start of the swizzled colors
+ *
+ * Contiguous batches are shuffled with SSSE3 or AVX2 byte shuffles, or with
+ * SSE2 masks and word shuffles otherwise.
+ *
+ * Example:
+ *     // upload an RGBA surface to a BGRA texture
+ *     sp::swap_red_blue(pixels, staging.begin());
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires rgba8_color<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out swap_red_blue(Range && colors, Out out)
+{
+    using Color = ranges::range_value_t<Range>;
+    return detail::transform_colors(colors, out, detail::swap_red_blue_pixels,
+                                    swap_red_blue<Color>);
+}
+}
@@ -0,0 +1,549 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+#include "spatula/layouts.hpp"
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <bit>
+#include <compare>
+#include <limits>
+#include <utility>
+
+// algorithms
+#include <algorithm>
+#include <memory>
+
+#if defined(__F16C__) or defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace sp {
+
+namespace detail {
+
+// convert with round-to-nearest-even, after Fabian Giesen's float_to_half
+constexpr std::uint16_t float_to_half_bits(float value)
+{
+    constexpr std::uint32_t infinity = 255u << 23;
+    constexpr std::uint32_t half_overflow = (127u + 16) << 23;
+    constexpr std::uint32_t subnormal_magic = ((127u - 15) + (23 - 10) + 1) << 23;
+
+    auto bits = std::bit_cast<std::uint32_t>(value);
+    std::uint32_t const sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    std::uint32_t half;
+    if (bits >= half_overflow) {
+        half = bits > infinity? 0x7e00 : 0x7c00;
+    }
+    else if (bits < (113u << 23)) {
+        // adding the magic value aligns the mantissa to the bottom of the
+        // float, and the float addition does the rounding
+        float const aligned = std::bit_cast<float>(bits) +
+                              std::bit_cast<float>(subnormal_magic);
+        half = std::bit_cast<std::uint32_t>(aligned) - subnormal_magic;
+    }
+    else {
+        std::uint32_t const odd = (bits >> 13) & 1u;
+        bits += ((15u - 127u) << 23) + 0xfff + odd;
+        half = bits >> 13;
+    }
+    return static_cast<std::uint16_t>(half | sign >> 16);
+}
+
+constexpr float half_bits_to_float(std::uint16_t half)
+{
+    constexpr std::uint32_t exponent_mask = 0x7c00u << 13;
+    constexpr float magic = std::bit_cast<float>(113u << 23);
+
+    std::uint32_t bits = (half & 0x7fffu) << 13;
+    std::uint32_t const exponent = bits & exponent_mask;
+    bits += (127u - 15u) << 23;
+    if (exponent == exponent_mask) {
+        bits += (128u - 16u) << 23;
+    }
+    else if (exponent == 0) {
+        bits += 1u << 23;
+        bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) - magic);
+    }
+    return std::bit_cast<float>(bits | (half & 0x8000u) << 16);
+}
+
+// round to the nearest integer, ties to even, like the SIMD conversions do;
+// adding 1.5 * 2^23 leaves no fraction bits, so only magnitudes below 2^22 work
+constexpr float round_even(float value)
+{
+    constexpr float magic = 12582912.f;
+    return (value + magic) - magic;
+}
+}
+
+/** A 16-bit IEEE 754 floating point number.
+ *
+ * Halves convert implicitly to float and do their arithmetic in float, so they
+ * can be used anywhere a float is read, but converting a float back to a half
+ * loses precision, so that has to be explicit.
+ *
+ * Example:
+ *     sp::half h{0.1f};
+ *     float f = h * 2.f;    // 0.199951171875f
+ */
+class half {
+public:
+    constexpr half() = default;
+    constexpr explicit half(float value)
+        : _bits(detail::float_to_half_bits(value))
+    {
+    }
+
+    /** The half with the given bit pattern. */
+    static constexpr half from_bits(std::uint16_t bits)
+    {
+        half h;
+        h._bits = bits;
+        return h;
+    }
+
+    constexpr std::uint16_t bits() const { return _bits; }
+    constexpr operator float() const { return detail::half_bits_to_float(_bits); }
+
+    friend constexpr half operator+(half a, half b) { return half{float(a) + float(b)}; }
+    friend constexpr half operator-(half a, half b) { return half{float(a) - float(b)}; }
+    friend constexpr half operator*(half a, half b) { return half{float(a) * float(b)}; }
+    friend constexpr half operator/(half a, half b) { return half{float(a) / float(b)}; }
+    constexpr half operator-() const { return from_bits(_bits ^ 0x8000u); }
+
+    constexpr half & operator+=(half other) { return *this = *this + other; }
+    constexpr half & operator-=(half other) { return *this = *this - other; }
+    constexpr half & operator*=(half other) { return *this = *this * other; }
+    constexpr half & operator/=(half other) { return *this = *this / other; }
+
+    friend constexpr bool operator==(half a, half b) { return float(a) == float(b); }
+    friend constexpr std::partial_ordering operator<=>(half a, half b)
+    {
+        return float(a) <=> float(b);
+    }
+private:
+    std::uint16_t _bits = 0;
+};
+
+/** A signed normalized number with the given amount of bits.
+ *
+ * A quantized number represents a value in [-1, 1] as an integer q in
+ * [-(2^(Bits-1) - 1), 2^(Bits-1) - 1], so that the value is q / (2^(Bits-1) - 1),
+ * like the snorm formats of graphics APIs. Arithmetic is done in float and
+ * saturates to [-1, 1]. To store positions, map them into the unit box with
+ * quantize and back with dequantize.
+ *
+ * Example:
+ *     sp::quantized<16> q{0.5f};
+ *     q.bits();    // 16384
+ */
+template<unsigned Bits>
+    requires (Bits >= 2 and Bits <= 16)
+class quantized {
+public:
+    using storage = std::conditional_t<(Bits <= 8), std::int8_t, std::int16_t>;
+    static constexpr int max_bits = (1 << (Bits - 1)) - 1;
+
+    constexpr quantized() = default;
+    constexpr explicit quantized(float value)
+    {
+        float const scaled = std::clamp(value, -1.f, 1.f) * float{max_bits};
+        _bits = static_cast<storage>(detail::round_even(scaled));
+    }
+
+    /** The quantized number with the given integer representation. */
+    static constexpr quantized from_bits(storage bits)
+    {
+        quantized q;
+        q._bits = static_cast<storage>(std::clamp<int>(bits, -max_bits, max_bits));
+        return q;
+    }
+
+    constexpr storage bits() const { return _bits; }
+    constexpr operator float() const { return float(_bits) / float{max_bits}; }
+
+    friend constexpr quantized operator+(quantized a, quantized b)
+    {
+        return from_bits(static_cast<storage>(
+            std::clamp<int>(a._bits + b._bits, -max_bits, max_bits)));
+    }
+    friend constexpr quantized operator-(quantized a, quantized b)
+    {
+        return from_bits(static_cast<storage>(
+            std::clamp<int>(a._bits - b._bits, -max_bits, max_bits)));
+    }
+    friend constexpr quantized operator*(quantized a, quantized b)
+    {
+        return quantized{float(a) * float(b)};
+    }
+    friend constexpr quantized operator/(quantized a, quantized b)
+    {
+        return quantized{float(a) / float(b)};
+    }
+    constexpr quantized operator-() const { return from_bits(static_cast<storage>(-_bits)); }
+
+    constexpr quantized & operator+=(quantized other) { return *this = *this + other; }
+    constexpr quantized & operator-=(quantized other) { return *this = *this - other; }
+    constexpr quantized & operator*=(quantized other) { return *this = *this * other; }
+    constexpr quantized & operator/=(quantized other) { return *this = *this / other; }
+
+    friend constexpr bool operator==(quantized, quantized) = default;
+    friend constexpr auto operator<=>(quantized, quantized) = default;
+private:
+    storage _bits = 0;
+};
+
+namespace detail {
+template<class Scalar, std::size_t N> struct compact_vector;
+
+template<class Scalar>
+struct compact_vector<Scalar, 2> { Scalar x, y; };
+template<class Scalar>
+struct compact_vector<Scalar, 3> { Scalar x, y, z; };
+template<class Scalar>
+struct compact_vector<Scalar, 4> { Scalar x, y, z, w; };
+
+template<class Vector>
+struct quantized_traits : std::false_type {};
+
+template<unsigned Bits, std::size_t N>
+struct quantized_traits<compact_vector<quantized<Bits>, N>> : std::true_type {
+    static constexpr unsigned bits = Bits;
+};
+
+template<class Vector>
+concept is_quantized_vector = quantized_traits<Vector>::value;
+}
+
+/** A vector of N half-precision components.
+ *
+ * Half vectors are plain aggregates of halves, so they model semivector and
+ * packed_layout, and take a third of the memory of double vectors. Convert
+ * whole ranges of them with encode_halves and decode_halves.
+ */
+template<std::size_t N>
+    requires (N >= 2 and N <= 4)
+using half_vector = detail::compact_vector<half, N>;
+
+/** A vector of N quantized components of the given amount of bits. */
+template<std::size_t N, unsigned Bits>
+    requires (N >= 2 and N <= 4)
+using quantized_vector = detail::compact_vector<quantized<Bits>, N>;
+
+namespace detail {
+
+template<class Range, class Scalar>
+concept contiguous_scalars =
+    ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+    packed_layout<ranges::range_value_t<Range>> and
+    std::same_as<scalar_field_t<ranges::range_value_t<Range>>, Scalar>;
+
+inline void encode_halves(float const * values, std::size_t count, half * out)
+{
+    std::size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= count; i += 8) {
+        __m256 const x = _mm256_loadu_ps(values + i);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                         _mm256_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for (; i < count; ++i) { out[i] = half{values[i]}; }
+}
+
+inline void decode_halves(half const * values, std::size_t count, float * out)
+{
+    std::size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= count; i += 8) {
+        __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(x));
+    }
+#endif
+    for (; i < count; ++i) { out[i] = float(values[i]); }
+}
+
+// the scale and offset of each component that map a box to the unit box,
+// scaled to the quantized range
+template<std::size_t N>
+struct quantization {
+    std::array<float, N> scale;
+    std::array<float, N> offset;
+};
+
+// q = round(p * scale + offset), saturated, for interleaved components
+template<std::size_t N, unsigned Bits>
+void quantize(float const * values, std::size_t count,
+              quantization<N> const & to_bits, quantized<Bits> * out)
+{
+    constexpr float max_bits = quantized<Bits>::max_bits;
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    if constexpr (Bits > 8) {
+        // 16 scalars at a time cycle through the components with period N
+        std::array<std::array<float, 16>, N> scales, offsets;
+        for (std::size_t k = 0; k < N; ++k) {
+            for (std::size_t l = 0; l < 16; ++l) {
+                scales[k][l] = to_bits.scale[(16 * k + l) % N];
+                offsets[k][l] = to_bits.offset[(16 * k + l) % N];
+            }
+        }
+        __m256 const upper = _mm256_set1_ps(max_bits);
+        __m256 const lower = _mm256_set1_ps(-max_bits);
+        auto const scaled = [&](std::size_t k, std::size_t part, float const * p) {
+            __m256 x = _mm256_loadu_ps(p);
+            x = _mm256_mul_ps(x, _mm256_loadu_ps(scales[k].data() + 8 * part));
+            x = _mm256_add_ps(x, _mm256_loadu_ps(offsets[k].data() + 8 * part));
+            x = _mm256_min_ps(_mm256_max_ps(x, lower), upper);
+            return _mm256_cvtps_epi32(x);
+        };
+        for (std::size_t k = 0; i + 16 <= count; i += 16, k = (k + 1) % N) {
+            __m256i const packed = _mm256_packs_epi32(scaled(k, 0, values + i),
+                                                      scaled(k, 1, values + i + 8));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                                _mm256_permute4x64_epi64(packed, 0b11'01'10'00));
+        }
+    }
+#endif
+    using storage = typename quantized<Bits>::storage;
+    for (std::size_t c = i % N; i < count; ++i, c = c + 1 == N? 0 : c + 1) {
+        float const x = values[i] * to_bits.scale[c] + to_bits.offset[c];
+        out[i] = quantized<Bits>::from_bits(static_cast<storage>(
+            round_even(std::clamp(x, -max_bits, max_bits))));
+    }
+}
+
+// p = q * scale + offset for interleaved components
+template<std::size_t N, unsigned Bits>
+void dequantize(quantized<Bits> const * values, std::size_t count,
+                quantization<N> const & from_bits, float * out)
+{
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    if constexpr (Bits > 8) {
+        std::array<std::array<float, 8>, N> scales, offsets;
+        for (std::size_t k = 0; k < N; ++k) {
+            for (std::size_t l = 0; l < 8; ++l) {
+                scales[k][l] = from_bits.scale[(8 * k + l) % N];
+                offsets[k][l] = from_bits.offset[(8 * k + l) % N];
+            }
+        }
+        for (std::size_t k = 0; i + 8 <= count; i += 8, k = (k + 1) % N) {
+            __m128i const q = _mm_loadu_si128(reinterpret_cast<__m128i const *>(values + i));
+            __m256 x = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(q));
+            x = _mm256_mul_ps(x, _mm256_loadu_ps(scales[k].data()));
+            x = _mm256_add_ps(x, _mm256_loadu_ps(offsets[k].data()));
+            _mm256_storeu_ps(out + i, x);
+        }
+    }
+#endif
+    for (std::size_t c = i % N; i < count; ++i, c = c + 1 == N? 0 : c + 1) {
+        out[i] = float(values[i].bits()) * from_bits.scale[c] + from_bits.offset[c];
+    }
+}
+
+template<std::size_t N, unsigned Bits, class Vector>
+quantization<N> quantization_of(std::pair<Vector, Vector> const & bounds, bool inverse)
+{
+    quantization<N> result;
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((void)[&] {
+            float const lower = static_cast<float>(get_component<I>(bounds.first));
+            float const upper = static_cast<float>(get_component<I>(bounds.second));
+            float const center = (lower + upper) / 2.f;
+            float const extent = (upper - lower) / 2.f;
+            float const steps = quantized<Bits>::max_bits;
+            if (inverse) {
+                result.scale[I] = extent / steps;
+                result.offset[I] = center;
+            }
+            else {
+                result.scale[I] = extent > 0.f? steps / extent : 0.f;
+                result.offset[I] = -center * result.scale[I];
+            }
+        }(), ...);
+    }(std::make_index_sequence<N>{});
+    return result;
+}
+}
+
+/** Convert a range of vectors to half vectors.
+ *
+ * Return
+ *   An iterator past the last half vector.
+ *
+ * Parameters
+ *   points - the vectors to convert
+ *   out - iterator to the start of the half vectors
+ *
+ * Packed float vectors between contiguous ranges are converted eight scalars
+ * at a time with F16C when it's enabled.
+ *
+ * Example:
+ *     std::vector<sp::half_vector<3>> compact(mesh.size());
+ *     sp::encode_halves(mesh, compact.begin());
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires semivector<ranges::range_value_t<Range>> and
+             std::indirectly_writable<
+                Out, half_vector<dimension_v<ranges::range_value_t<Range>>>>
+
+Out encode_halves(Range && points, Out out)
+{
+    constexpr std::size_t N = dimension_v<ranges::range_value_t<Range>>;
+    if constexpr (detail::contiguous_scalars<Range, float> and
+                  detail::contiguous_output<Out, half_vector<N>>) {
+        auto const count = static_cast<std::size_t>(ranges::size(points));
+        detail::encode_halves(reinterpret_cast<float const *>(ranges::data(points)),
+                              count * N, reinterpret_cast<half *>(std::to_address(out)));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        return convert_range<half_vector<N>>(points, out);
+    }
+}
+
+/** Convert a range of half vectors to another vector type.
+ *
+ * Return
+ *   An iterator past the last converted vector.
+ *
+ * Parameters
+ *   halves - the half vectors to convert
+ *   out - iterator to the start of the output vectors
+ */
+template<semivector Vector, ranges::input_range Range, std::weakly_incrementable Out>
+    requires std::same_as<ranges::range_value_t<Range>, half_vector<dimension_v<Vector>>> and
+             std::indirectly_writable<Out, Vector>
+
+Out decode_halves(Range && halves, Out out)
+{
+    constexpr std::size_t N = dimension_v<Vector>;
+    if constexpr (packed_layout<Vector> and
+                  std::same_as<scalar_field_t<Vector>, float> and
+                  ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+                  detail::contiguous_output<Out, Vector>) {
+        auto const count = static_cast<std::size_t>(ranges::size(halves));
+        detail::decode_halves(reinterpret_cast<half const *>(ranges::data(halves)),
+                              count * N, reinterpret_cast<float *>(std::to_address(out)));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        return convert_range<Vector>(halves, out);
+    }
+}
+
+/** Quantize a range of vectors within a bounding box.
+ *
+ * Return
+ *   An iterator past the last quantized vector.
+ *
+ * Parameters
+ *   points - the vectors to quantize
+ *   bounds - the (lower, upper) corners of the box to quantize within, as
+ *            returned by bounding_corners2d
+ *   out - iterator to the start of the quantized vectors
+ *
+ * The box is mapped to the [-1, 1] box of the quantized vectors, and points
+ * outside of it saturate to its sides. Packed float vectors between contiguous
+ * ranges are quantized 16 scalars at a time with AVX2 when it's enabled.
+ *
+ * Example:
+ *     auto const bounds = sp::bounding_corners2d(points);
+ *     std::vector<sp::quantized_vector<2, 16>> compact(points.size());
+ *     sp::quantize<16>(points, bounds, compact.begin());
+ */
+template<unsigned Bits, ranges::input_range Range, semivector Vector,
+         std::weakly_incrementable Out>
+    requires semivector<ranges::range_value_t<Range>> and
+             (dimension_v<Vector> == dimension_v<ranges::range_value_t<Range>>) and
+             std::indirectly_writable<Out, quantized_vector<dimension_v<Vector>, Bits>>
+
+Out quantize(Range && points, std::pair<Vector, Vector> const & bounds, Out out)
+{
+    constexpr std::size_t N = dimension_v<Vector>;
+    using Quantized = quantized_vector<N, Bits>;
+    auto const to_bits = detail::quantization_of<N, Bits>(bounds, false);
+
+    if constexpr (detail::contiguous_scalars<Range, float> and
+                  detail::contiguous_output<Out, Quantized>) {
+        auto const count = static_cast<std::size_t>(ranges::size(points));
+        detail::quantize(reinterpret_cast<float const *>(ranges::data(points)),
+                         count * N, to_bits,
+                         reinterpret_cast<quantized<Bits> *>(std::to_address(out)));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        for (auto const & point : points) {
+            std::array<float, N> values;
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((values[I] = static_cast<float>(get_component<I>(point))), ...);
+            }(std::make_index_sequence<N>{});
+            Quantized q;
+            detail::quantize(values.data(), N, to_bits,
+                             reinterpret_cast<quantized<Bits> *>(&q));
+            *out = q;
+            ++out;
+        }
+        return out;
+    }
+}
+
+/** Map a range of quantized vectors back into a bounding box.
+ *
+ * Return
+ *   An iterator past the last dequantized vector.
+ *
+ * Parameters
+ *   quantized - the vectors to dequantize
+ *   bounds - the (lower, upper) corners of the box they were quantized within
+ *   out - iterator to the start of the output vectors
+ */
+template<semivector Vector, ranges::input_range Range, std::weakly_incrementable Out>
+    requires detail::is_quantized_vector<ranges::range_value_t<Range>> and
+             (dimension_v<ranges::range_value_t<Range>> == dimension_v<Vector>) and
+             std::indirectly_writable<Out, Vector>
+
+Out dequantize(Range && points, std::pair<Vector, Vector> const & bounds, Out out)
+{
+    constexpr std::size_t N = dimension_v<Vector>;
+    constexpr unsigned Bits = detail::quantized_traits<ranges::range_value_t<Range>>::bits;
+    auto const from_bits = detail::quantization_of<N, Bits>(bounds, true);
+
+    if constexpr (packed_layout<Vector> and
+                  std::same_as<scalar_field_t<Vector>, float> and
+                  ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+                  detail::contiguous_output<Out, Vector>) {
+        auto const count = static_cast<std::size_t>(ranges::size(points));
+        detail::dequantize(reinterpret_cast<quantized<Bits> const *>(ranges::data(points)),
+                           count * N, from_bits,
+                           reinterpret_cast<float *>(std::to_address(out)));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        using scalar = scalar_field_t<Vector>;
+        for (auto const & q : points) {
+            std::array<float, N> values;
+            detail::dequantize(reinterpret_cast<quantized<Bits> const *>(&q), N,
+                               from_bits, values.data());
+            Vector v{};
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((get_component<I>(v) = static_cast<scalar>(values[I])), ...);
+            }(std::make_index_sequence<N>{});
+            *out = v;
+            ++out;
+        }
+        return out;
+    }
+}
+}
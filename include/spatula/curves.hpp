@@ -0,0 +1,504 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include <cmath>
+#include "spatula/layouts.hpp"
+
+// errors
+#include <stdexcept>
+
+namespace sp {
+
+/** A cubic Bezier curve from its first to its last control point, pulled
+ * toward the middle two.
+ */
+template<semivector Vector>
+struct cubic_bezier {
+    using vector_type = Vector;
+    std::array<Vector, 4> points;
+};
+
+/** The segment of a uniform Catmull-Rom spline between its middle two control
+ * points, which it passes through, with tangents set by the outer two.
+ */
+template<semivector Vector>
+struct catmull_rom {
+    using vector_type = Vector;
+    std::array<Vector, 4> points;
+};
+
+/** A segment of a uniform cubic B-spline, which approximates its control
+ * points with a curve that's smooth up to its second derivative across
+ * segments.
+ */
+template<semivector Vector>
+struct cubic_bspline {
+    using vector_type = Vector;
+    std::array<Vector, 4> points;
+};
+
+namespace detail {
+
+template<class Curve>
+struct cubic_basis;
+
+// the coefficient of each control point in each power of t, times a scale
+template<class Vector>
+struct cubic_basis<cubic_bezier<Vector>> {
+    static constexpr double scale = 1;
+    static constexpr double matrix[4][4]{{1, 0, 0, 0},
+                                         {-3, 3, 0, 0},
+                                         {3, -6, 3, 0},
+                                         {-1, 3, -3, 1}};
+    // control points to advance between consecutive segments of a spline
+    static constexpr std::size_t stride = 3;
+};
+
+template<class Vector>
+struct cubic_basis<catmull_rom<Vector>> {
+    static constexpr double scale = 0.5;
+    static constexpr double matrix[4][4]{{0, 2, 0, 0},
+                                         {-1, 0, 1, 0},
+                                         {2, -5, 4, -1},
+                                         {-1, 3, -3, 1}};
+    static constexpr std::size_t stride = 1;
+};
+
+template<class Vector>
+struct cubic_basis<cubic_bspline<Vector>> {
+    static constexpr double scale = 1.0 / 6;
+    static constexpr double matrix[4][4]{{1, 4, 1, 0},
+                                         {-3, 0, 3, 0},
+                                         {3, -6, 3, 0},
+                                         {-1, 3, -3, 1}};
+    static constexpr std::size_t stride = 1;
+};
+}
+
+/** One of the cubic curve types above. */
+template<class Curve>
+concept cubic_curve = requires {
+    typename Curve::vector_type;
+    detail::cubic_basis<Curve>::stride;
+};
+
+/** The scalar that a curve's points are computed in: double for float and
+ * integer control points, or the control points' own scalar if it's wider.
+ */
+template<cubic_curve Curve>
+using curve_scalar_t =
+    std::common_type_t<scalar_field_t<typename Curve::vector_type>, double>;
+
+namespace detail {
+
+// a cubic polynomial c[0] + c[1] t + c[2] t^2 + c[3] t^3 in each component, or
+// the four control points of a Bezier curve
+template<std::size_t N, class Scalar>
+using cubic_coefficients = std::array<std::array<Scalar, N>, 4>;
+
+template<cubic_curve Curve>
+auto power_basis(Curve const & curve)
+{
+    using Vector = typename Curve::vector_type;
+    using Scalar = curve_scalar_t<Curve>;
+    constexpr std::size_t N = dimension_v<Vector>;
+    using basis = cubic_basis<Curve>;
+
+    cubic_coefficients<N, Scalar> c{};
+    for (std::size_t k = 0; k < 4; ++k) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            auto const weight = static_cast<Scalar>(basis::matrix[k][j] * basis::scale);
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((c[k][I] += weight * static_cast<Scalar>(
+                      get_component<I>(curve.points[j]))), ...);
+            }(std::make_index_sequence<N>{});
+        }
+    }
+    return c;
+}
+
+template<std::size_t N, class Scalar>
+std::array<Scalar, N> horner(cubic_coefficients<N, Scalar> const & c, Scalar t)
+{
+    std::array<Scalar, N> p;
+    for (std::size_t i = 0; i < N; ++i) {
+        p[i] = ((c[3][i] * t + c[2][i]) * t + c[1][i]) * t + c[0][i];
+    }
+    return p;
+}
+
+template<class Vector, std::size_t N, class Scalar>
+Vector to_curve_vector(std::array<Scalar, N> const & p)
+{
+    return convert_vector<Vector>(p, std::make_index_sequence<N>{});
+}
+
+// the Bezier control points of a cubic polynomial, whose convex hull bounds it
+template<std::size_t N, class Scalar>
+cubic_coefficients<N, Scalar> bezier_points(cubic_coefficients<N, Scalar> const & c)
+{
+    cubic_coefficients<N, Scalar> b;
+    for (std::size_t i = 0; i < N; ++i) {
+        b[0][i] = c[0][i];
+        b[1][i] = c[0][i] + c[1][i] / 3;
+        b[2][i] = c[0][i] + (2 * c[1][i] + c[2][i]) / 3;
+        b[3][i] = c[0][i] + c[1][i] + c[2][i] + c[3][i];
+    }
+    return b;
+}
+
+// subdivide a Bezier curve at its midpoint until each piece is within
+// tolerance of its chord, calling emit with the end of each piece in order.
+// The pieces wait on a stack instead of the call stack, with the deepest
+// subdivision bounded so degenerate curves still finish
+template<std::size_t N, class Scalar, class Emit>
+void flatten_bezier(cubic_coefficients<N, Scalar> const & curve, Scalar tolerance,
+                    Emit && emit)
+{
+    using piece = cubic_coefficients<N, Scalar>;
+    constexpr int max_depth = 16;
+    std::array<std::pair<piece, int>, max_depth> stack;
+    std::size_t size = 0;
+    piece b = curve;
+    int depth = 0;
+
+    // the distance from the chord is at most a quarter of the larger of
+    // 3 b1 - 2 b0 - b3 and 3 b2 - b0 - 2 b3 in each component
+    Scalar const limit = 16 * tolerance * tolerance;
+    while (true) {
+        Scalar deviation = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            Scalar const u = 3 * b[1][i] - 2 * b[0][i] - b[3][i];
+            Scalar const v = 3 * b[2][i] - b[0][i] - 2 * b[3][i];
+            deviation += std::max(u * u, v * v);
+        }
+        if (deviation <= limit or depth == max_depth) {
+            emit(b[3]);
+            if (size == 0) { return; }
+            std::tie(b, depth) = stack[--size];
+            continue;
+        }
+
+        // de Casteljau's split at the midpoint: the right half waits on the
+        // stack while the left half is subdivided in place
+        piece right;
+        for (std::size_t i = 0; i < N; ++i) {
+            Scalar const ab = (b[0][i] + b[1][i]) / 2;
+            Scalar const bc = (b[1][i] + b[2][i]) / 2;
+            Scalar const cd = (b[2][i] + b[3][i]) / 2;
+            Scalar const abc = (ab + bc) / 2;
+            Scalar const bcd = (bc + cd) / 2;
+            Scalar const middle = (abc + bcd) / 2;
+            right[0][i] = middle;
+            right[1][i] = bcd;
+            right[2][i] = cd;
+            right[3][i] = b[3][i];
+            b[1][i] = ab;
+            b[2][i] = abc;
+            b[3][i] = middle;
+        }
+        stack[size++] = {right, ++depth};
+    }
+}
+
+// call emit with count points at evenly spaced parameters from 0 to 1. Each
+// point is evaluated on its own rather than stepped from the last, so the
+// loop has no dependency between points and vectorizes across parameters
+template<std::size_t N, class Scalar, class Emit>
+void evenly_spaced(cubic_coefficients<N, Scalar> const & c, std::size_t count,
+                   Emit && emit)
+{
+    if (count == 0) { return; }
+    if (count == 1) {
+        emit(c[0]);
+        return;
+    }
+    Scalar const h = Scalar{1} / static_cast<Scalar>(count - 1);
+    for (std::size_t k = 0; k + 1 < count; ++k) {
+        emit(horner(c, static_cast<Scalar>(k) * h));
+    }
+    // the last point exactly, without rounding in the last parameter
+    emit(horner(c, Scalar{1}));
+}
+
+template<class Scalar>
+void check_tolerance(Scalar tolerance)
+{
+    if (not (tolerance > 0)) {
+        throw std::domain_error{"curve tolerance must be positive"};
+    }
+}
+}
+
+/** The point on a curve at a parameter, from 0 at its start to 1 at its end. */
+template<cubic_curve Curve>
+auto point_at(Curve const & curve, curve_scalar_t<Curve> t)
+{
+    using Vector = typename Curve::vector_type;
+    return detail::to_curve_vector<Vector>(detail::horner(detail::power_basis(curve), t));
+}
+
+/** The derivative of a curve with respect to its parameter. */
+template<cubic_curve Curve>
+auto tangent_at(Curve const & curve, curve_scalar_t<Curve> t)
+{
+    using Vector = typename Curve::vector_type;
+    auto const c = detail::power_basis(curve);
+    std::array<curve_scalar_t<Curve>, dimension_v<Vector>> d;
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        d[i] = (3 * c[3][i] * t + 2 * c[2][i]) * t + c[1][i];
+    }
+    return detail::to_curve_vector<Vector>(d);
+}
+
+/** Evaluate a curve at many parameters.
+ *
+ * Return
+ *   An iterator past the last point.
+ *
+ * Parameters
+ *   curve - the curve to evaluate
+ *   parameters - the parameters to evaluate the curve at, usually in [0, 1]
+ *   out - iterator to the start of the points
+ *
+ * The curve is converted to polynomial coefficients once, so each point only
+ * costs three multiply-adds per component, and the loop over parameters is
+ * independent between points so the compiler may vectorize it.
+ */
+template<cubic_curve Curve, ranges::input_range Range, std::weakly_incrementable Out>
+    requires std::is_arithmetic_v<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, typename Curve::vector_type>
+
+Out points_at(Curve const & curve, Range && parameters, Out out)
+{
+    using Vector = typename Curve::vector_type;
+    using Scalar = curve_scalar_t<Curve>;
+    auto const c = detail::power_basis(curve);
+    for (auto const t : parameters) {
+        *out = detail::to_curve_vector<Vector>(detail::horner(c, static_cast<Scalar>(t)));
+        ++out;
+    }
+    return out;
+}
+
+/** Sample a curve at evenly spaced parameters from its start to its end.
+ *
+ * Return
+ *   An iterator past the last point.
+ *
+ * Parameters
+ *   curve - the curve to sample
+ *   count - the amount of points, including both ends
+ *   out - iterator to the start of the points
+ *
+ * The curve is converted to polynomial coefficients once and each point is
+ * evaluated independently with three multiply-adds per component, which
+ * vectorizes across parameters.
+ */
+template<cubic_curve Curve, std::weakly_incrementable Out>
+    requires std::indirectly_writable<Out, typename Curve::vector_type>
+
+Out sample(Curve const & curve, std::size_t count, Out out)
+{
+    using Vector = typename Curve::vector_type;
+    detail::evenly_spaced(detail::power_basis(curve), count, [&](auto const & p) {
+        *out = detail::to_curve_vector<Vector>(p);
+        ++out;
+    });
+    return out;
+}
+
+/** A table of the arc length along a curve, for moving along it at an even
+ * speed.
+ *
+ * The curve is sampled at evenly spaced parameters, and lengths in between
+ * are interpolated linearly, so the error shrinks with the square of the
+ * resolution.
+ *
+ * Example:
+ *     sp::arc_length_table const lengths(curve);
+ *     auto const t = lengths.parameter_at(speed * time);
+ *     auto const position = sp::point_at(curve, t);
+ */
+template<cubic_curve Curve>
+class arc_length_table {
+public:
+    using scalar = curve_scalar_t<Curve>;
+
+    /** Tabulate the arc length of a curve.
+     *
+     * Parameters
+     *   curve - the curve to measure
+     *   resolution - the amount of straight pieces to measure the curve with
+     */
+    explicit arc_length_table(Curve const & curve, std::size_t resolution = 64)
+    {
+        constexpr std::size_t N = dimension_v<typename Curve::vector_type>;
+        resolution = std::max<std::size_t>(resolution, 1);
+        _lengths.reserve(resolution + 1);
+        std::array<scalar, N> previous{};
+        detail::evenly_spaced(detail::power_basis(curve), resolution + 1,
+                              [&](std::array<scalar, N> const & p) {
+            if (_lengths.empty()) {
+                _lengths.push_back(0);
+            }
+            else {
+                scalar squared = 0;
+                for (std::size_t i = 0; i < N; ++i) {
+                    squared += (p[i] - previous[i]) * (p[i] - previous[i]);
+                }
+                _lengths.push_back(_lengths.back() + std::sqrt(squared));
+            }
+            previous = p;
+        });
+    }
+
+    /** The total length of the curve. */
+    scalar length() const { return _lengths.back(); }
+
+    /** The parameter at a distance along the curve, clamped to [0, 1]. */
+    scalar parameter_at(scalar distance) const
+    {
+        if (not (distance > 0)) { return 0; }
+        if (distance >= length()) { return 1; }
+        auto const after = std::upper_bound(_lengths.begin(), _lengths.end(), distance);
+        auto const k = static_cast<std::size_t>(after - _lengths.begin()) - 1;
+        scalar const piece = _lengths[k + 1] - _lengths[k];
+        scalar const fraction = piece > 0? (distance - _lengths[k]) / piece : 0;
+        auto const pieces = static_cast<scalar>(_lengths.size() - 1);
+        return (static_cast<scalar>(k) + fraction) / pieces;
+    }
+private:
+    std::vector<scalar> _lengths;
+};
+
+/** Sample a curve at points evenly spaced along its length.
+ *
+ * Return
+ *   An iterator past the last point.
+ *
+ * Parameters
+ *   curve - the curve to sample
+ *   lengths - the arc length table of the curve
+ *   count - the amount of points, including both ends
+ *   out - iterator to the start of the points
+ */
+template<cubic_curve Curve, std::weakly_incrementable Out>
+    requires std::indirectly_writable<Out, typename Curve::vector_type>
+
+Out sample_by_length(Curve const & curve, arc_length_table<Curve> const & lengths,
+                     std::size_t count, Out out)
+{
+    using Vector = typename Curve::vector_type;
+    using Scalar = curve_scalar_t<Curve>;
+    auto const c = detail::power_basis(curve);
+    Scalar const step = count > 1? lengths.length() / static_cast<Scalar>(count - 1) : 0;
+    for (std::size_t k = 0; k < count; ++k) {
+        Scalar const t = lengths.parameter_at(step * static_cast<Scalar>(k));
+        *out = detail::to_curve_vector<Vector>(detail::horner(c, t));
+        ++out;
+    }
+    return out;
+}
+
+/** Approximate a curve with a polyline, adaptively to a tolerance.
+ *
+ * Return
+ *   An iterator past the last point of the polyline.
+ *
+ * Parameters
+ *   curve - the curve to approximate
+ *   tolerance - the greatest distance the polyline may stray from the curve
+ *   out - iterator to the start of the points of the polyline, starting with
+ *         the start of the curve
+ *
+ * Throws
+ *   std::domain_error if the tolerance isn't positive
+ *
+ * The curve is split in half wherever it's further than the tolerance from a
+ * straight line, so straight stretches take few points and tight bends take
+ * many. No memory is allocated, so the polyline can be written straight into
+ * a caller's buffer sized with flattened_size.
+ *
+ * Example:
+ *     std::vector<vec2> buffer(sp::flattened_size(curve, 0.25f));
+ *     sp::flatten(curve, 0.25f, buffer.begin());
+ */
+template<cubic_curve Curve, std::weakly_incrementable Out>
+    requires std::indirectly_writable<Out, typename Curve::vector_type>
+
+Out flatten(Curve const & curve, curve_scalar_t<Curve> tolerance, Out out)
+{
+    using Vector = typename Curve::vector_type;
+    using Scalar = curve_scalar_t<Curve>;
+    constexpr std::size_t N = dimension_v<Vector>;
+    detail::check_tolerance(tolerance);
+
+    auto const c = detail::power_basis(curve);
+    *out = detail::to_curve_vector<Vector>(c[0]);
+    ++out;
+    detail::flatten_bezier(detail::bezier_points(c), tolerance,
+                           [&](std::array<Scalar, N> const & p) {
+        *out = detail::to_curve_vector<Vector>(p);
+        ++out;
+    });
+    return out;
+}
+
+/** The amount of points that flatten writes for a curve and tolerance. */
+template<cubic_curve Curve>
+std::size_t flattened_size(Curve const & curve, curve_scalar_t<Curve> tolerance)
+{
+    detail::check_tolerance(tolerance);
+    std::size_t count = 1;
+    detail::flatten_bezier(detail::bezier_points(detail::power_basis(curve)),
+                           tolerance, [&](auto const &) { ++count; });
+    return count;
+}
+
+/** A lazy view of the segments of a spline through a range of control points.
+ *
+ * Bezier splines share the last control point of each segment with the next,
+ * so n control points make (n - 1) / 3 segments. Catmull-Rom splines and
+ * B-splines slide along the points one at a time, making n - 3 segments.
+ *
+ * Example:
+ *     for (auto const & segment : sp::spline_segments<sp::catmull_rom<vec2>>(path)) {
+ *         out = sp::flatten(segment, 0.1f, out);
+ *     }
+ */
+template<cubic_curve Curve, ranges::random_access_range Range>
+    requires ranges::sized_range<Range> and ranges::borrowed_range<Range> and
+             std::convertible_to<ranges::range_reference_t<Range>,
+                                 typename Curve::vector_type>
+
+auto spline_segments(Range && points)
+{
+    constexpr std::size_t stride = detail::cubic_basis<Curve>::stride;
+    auto const size = static_cast<std::size_t>(ranges::size(points));
+    std::size_t const count = size < 4? 0 : (size - 4) / stride + 1;
+    auto const first = ranges::begin(points);
+    return ranges::views::iota(std::size_t{0}, count) |
+           ranges::views::transform([first](std::size_t k) {
+        auto const at = [&](std::size_t j) {
+            return first[static_cast<ranges::range_difference_t<Range>>(k * stride + j)];
+        };
+        return Curve{{at(0), at(1), at(2), at(3)}};
+    });
+}
+}
@@ -2,50 +2,208 @@
 
 // type constraints
 #include <type_traits>
+#include <concepts>
 #include "spatula/vectors.hpp"
 
 // data types and data structures
 #include <cstdint>
 #include <cstddef>
 #include <array>
+#include <tuple>
+#include <utility>
 
 /** The cardinal directions. */
 namespace sp::cardinal { enum direction_name { north, east, south, west }; }
+/** The cardinal and intercardinal directions. */
+namespace sp::ordinal {
+enum direction_name {
+    north, northeast, east, southeast, south, southwest, west, northwest
+};
+}
 namespace sp::flat_hex{
 enum direction_name { north, northeast, southeast, south, southwest, northwest };
 }
 namespace sp::pointed_hex{
 enum direction_name{ northeast, east, southeast, southwest, west, northwest };
 }
+/** The directions to the faces of a cube. */
+namespace sp::cubic6 {
+enum direction_name : std::uint8_t { east, west, north, south, up, down };
+}
+/** The directions to the faces and edges of a cube.
+ *
+ * The first six directions are the same as sp::cubic6.
+ */
+namespace sp::cubic18 {
+enum direction_name : std::uint8_t { east, west, north, south, up, down };
+}
+/** The directions to the faces, edges and corners of a cube.
+ *
+ * The first eighteen directions are the same as sp::cubic18.
+ */
+namespace sp::cubic26 {
+enum direction_name : std::uint8_t { east, west, north, south, up, down };
+}
 
 namespace sp {
 
-/** The amount of values defined by an enum type. */
+/** The grid offsets of each direction of an enum, in enum order.
+ *
+ * Specializations define a static constexpr member `value`, an array of
+ * integer offsets that each have the same dimension.
+ *
+ * Example:
+ *     enum class king_move : std::uint8_t {};
+ *     template<> struct sp::direction_offsets<king_move>
+ *         : sp::neighborhood<2, 2> {};
+ *
+ *   king_move is then a ranged_enum with eight values, and can be converted
+ *   to any field_2d_constructible type with sp::direction_as.
+ */
+template<class Enum>
+    requires std::is_enum_v<Enum>
+struct direction_offsets;
+
+/** An enum with a specialization of sp::direction_offsets. */
+template<class Enum>
+concept has_direction_offsets = std::is_enum_v<Enum> and requires {
+    direction_offsets<Enum>::value;
+};
+
+template<class Enum>
+    requires has_direction_offsets<Enum>
+constexpr auto const & direction_offsets_v = direction_offsets<Enum>::value;
+
+/** The dimension of the offsets of a direction enum. */
+template<class Enum>
+    requires has_direction_offsets<Enum>
+constexpr std::size_t direction_dimension_v = std::tuple_size_v<
+    std::remove_cvref_t<decltype(direction_offsets_v<Enum>[0])>
+>;
+
+/** The amount of values defined by an enum type.
+ *
+ * Enums with direction offsets define one value per offset.
+ */
 template<class Enum>
     requires std::is_enum_v<Enum>
 struct enum_size {
-    static constexpr std::size_t value = 0;
+    static constexpr std::size_t value = [] {
+        if constexpr (has_direction_offsets<Enum>) {
+            return direction_offsets_v<Enum>.size();
+        }
+        else {
+            return std::size_t{0};
+        }
+    }();
 };
 
 template<class Enum>
     requires std::is_enum_v<Enum>
 static constexpr std::size_t enum_size_v = enum_size<Enum>::value;
 
+/** The amount of offsets in {-1, 0, 1}^Dimensions with between one and
+ * MaxNonzero nonzero components.
+ */
+template<std::size_t Dimensions, std::size_t MaxNonzero>
+constexpr std::size_t neighborhood_size()
+{
+    std::size_t total = 0;
+    std::size_t choices = 1;
+    for (std::size_t k = 1; k <= MaxNonzero and k <= Dimensions; ++k) {
+        choices = choices * (Dimensions - k + 1) / k;
+        total += choices * (std::size_t{1} << k);
+    }
+    return total;
+}
+
+/** Generate the offsets to the neighbors of a grid cell.
+ *
+ * Return
+ *   Every offset in {-1, 0, 1}^Dimensions with between one and MaxNonzero
+ *   nonzero components. Offsets are ordered by their amount of nonzero
+ *   components, then lexicographically with 1 before -1 before 0.
+ *
+ * Example:
+ *   neighborhood_offsets<2, 1>() gives the 4-neighborhood of a square grid,
+ *   and neighborhood_offsets<3, 3>() gives the 26-neighborhood of a cube
+ *   grid, whose first 6 offsets are the 6-neighborhood.
+ */
+template<std::size_t Dimensions, std::size_t MaxNonzero>
+constexpr auto neighborhood_offsets()
+{
+    constexpr std::size_t N = neighborhood_size<Dimensions, MaxNonzero>();
+    std::array<std::array<int, Dimensions>, N> offsets{};
+
+    std::size_t codes = 1;
+    for (std::size_t i = 0; i < Dimensions; ++i) { codes *= 3; }
+
+    std::size_t n = 0;
+    for (std::size_t nonzero = 1; nonzero <= MaxNonzero; ++nonzero) {
+        for (std::size_t code = 0; code < codes; ++code) {
+            std::array<int, Dimensions> offset{};
+            std::size_t count = 0;
+            std::size_t digits = code;
+            for (std::size_t i = Dimensions; i-- > 0; digits /= 3) {
+                constexpr std::array<int, 3> values{1, -1, 0};
+                offset[i] = values[digits % 3];
+                count += offset[i] != 0;
+            }
+            if (count == nonzero) { offsets[n++] = offset; }
+        }
+    }
+    return offsets;
+}
+
+/** A compact description of a neighborhood for direction_offsets. */
+template<std::size_t Dimensions, std::size_t MaxNonzero>
+struct neighborhood {
+    static constexpr auto value = neighborhood_offsets<Dimensions, MaxNonzero>();
+};
+
+template<>
+struct direction_offsets<cardinal::direction_name> {
+    static constexpr std::array<std::array<int, 2>, 4> value{{
+        /* north */ {0, 1}, /* east */ {1, 0},
+        /* south */ {0, -1}, /* west */ {-1, 0}
+    }};
+};
+
 template<>
-struct enum_size<cardinal::direction_name> {
-    static constexpr std::size_t value = 4;
+struct direction_offsets<ordinal::direction_name> {
+    static constexpr std::array<std::array<int, 2>, 8> value{{
+        /* north */ {0, 1}, /* northeast */ {1, 1},
+        /* east */ {1, 0}, /* southeast */ {1, -1},
+        /* south */ {0, -1}, /* southwest */ {-1, -1},
+        /* west */ {-1, 0}, /* northwest */ {-1, 1}
+    }};
 };
 
 template<>
-struct enum_size<pointed_hex::direction_name> {
-    static constexpr std::size_t value = 6;
+struct direction_offsets<flat_hex::direction_name> {
+    static constexpr std::array<std::array<int, 2>, 6> value{{
+        /* north */ {0, -1}, /* northeast */ {1, -1}, /* southeast */ {1, 0},
+        /* south */ {0, 1}, /* southwest */ {-1, 1}, /* northwest */ {-1, 0}
+    }};
 };
 
 template<>
-struct enum_size<flat_hex::direction_name> {
-    static constexpr std::size_t value = 6;
+struct direction_offsets<pointed_hex::direction_name> {
+    static constexpr std::array<std::array<int, 2>, 6> value{{
+        /* northeast */ {1, -1}, /* east */ {1, 0}, /* southeast */ {0, 1},
+        /* southwest */ {-1, 1}, /* west */ {-1, 0}, /* northwest */ {0, -1}
+    }};
 };
 
+template<>
+struct direction_offsets<cubic6::direction_name> : neighborhood<3, 1> {};
+
+template<>
+struct direction_offsets<cubic18::direction_name> : neighborhood<3, 2> {};
+
+template<>
+struct direction_offsets<cubic26::direction_name> : neighborhood<3, 3> {};
+
 /** An enum with sequential values defined from [0, enum_size_v<Enum>). */
 template<class Enum>
 concept ranged_enum = std::is_enum_v<Enum> and requires { enum_size_v<Enum>; };
@@ -56,53 +214,32 @@ struct enum_to_vector {
     Vector operator()(Enum direction) const;
 };
 template<class Vector, ranged_enum Enum>
-Vector direction_as(Enum direction)
+constexpr Vector direction_as(Enum direction)
 {
     return enum_to_vector<Enum, Vector>{}(direction);
 }
 
-template<field_2d_constructible Vector>
-    requires std::constructible_from<scalar_field_t<Vector>, int>
-
-struct enum_to_vector<cardinal::direction_name, Vector>{
-    Vector operator()(cardinal::direction_name dir) const
-    {
-        std::uint32_t constexpr N = enum_size_v<cardinal::direction_name>;
-        static constexpr std::array<Vector, N> directions{
-            /* north */ Vector{0, 1}, /* east */ Vector{1, 0},
-            /* south */ Vector{0, -1}, /* west */ Vector{-1, 0}
-        };
-        return directions[dir];
-    }
-};
-
-template<field_2d_constructible Vector>
-requires std::constructible_from<scalar_field_t<Vector>, int>
+// any enum with direction offsets converts to a vector of the same dimension
+template<ranged_enum Enum, class Vector>
+    requires has_direction_offsets<Enum> and
+             field_nd_constructible<Vector, direction_dimension_v<Enum>> and
+             std::constructible_from<scalar_field_t<Vector>, int>
 
-struct enum_to_vector<flat_hex::direction_name, Vector>{
-    Vector operator()(flat_hex::direction_name dir) const
+struct enum_to_vector<Enum, Vector> {
+    constexpr Vector operator()(Enum direction) const
     {
-        std::uint32_t constexpr N = enum_size_v<flat_hex::direction_name>;
-        static constexpr std::array<Vector, N> directions{
-                /* north */ Vector{0, -1}, /* northeast */ Vector{-1, 1}, /* southeast */ Vector{1 , 0},
-                /* south */ Vector{0, 1}, /* southwest */ Vector{-1, 1}, /* northwest */ Vector{-1, 0}
-        };
-        return directions[dir];
+        constexpr std::size_t N = direction_dimension_v<Enum>;
+        auto const & offset =
+            direction_offsets_v<Enum>[static_cast<std::size_t>(direction)];
+        return make_vector(offset, std::make_index_sequence<N>{});
     }
-};
-
-template<field_2d_constructible Vector>
-requires std::constructible_from<scalar_field_t<Vector>, int>
-
-struct enum_to_vector<pointed_hex::direction_name, Vector>{
-    Vector operator()(pointed_hex::direction_name dir) const
+private:
+    template<std::size_t N, std::size_t... I>
+    static constexpr Vector make_vector(std::array<int, N> const & offset,
+                                        std::index_sequence<I...>)
     {
-        std::uint32_t constexpr N = enum_size_v<pointed_hex::direction_name>;
-        static constexpr std::array<Vector, N> directions{
-                /* northeast */ Vector{1, -1}, /* east */ Vector{1, 0}, /* southeast */ Vector{0 , 1},
-                /* southwest */ Vector{-1, 1}, /* west */ Vector{-1, 0}, /* northwest */ Vector{0, -1}
-        };
-        return directions[dir];
+        using scalar = scalar_field_t<Vector>;
+        return Vector{static_cast<scalar>(offset[I])...};
     }
 };
 }
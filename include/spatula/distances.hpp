@@ -0,0 +1,335 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <limits>
+#include "spatula/directions.hpp"
+#include "spatula/grids.hpp"
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include <cmath>
+#include "spatula/parallel.hpp"
+
+/** Distance metrics for grid algorithms. */
+namespace sp::metric {
+/** Straight-line distance between cell centers. */
+struct euclidean {};
+/** The square of the straight-line distance, which is exact for integers. */
+struct squared_euclidean {};
+/** The amount of cardinal steps between cells. */
+struct manhattan {};
+/** The amount of cardinal or diagonal steps between cells. */
+struct chebyshev {};
+/** The amount of steps between cells of an axial hex grid. */
+struct hex {};
+}
+
+namespace sp {
+
+/** A metric that sp::distance_transform can compute. */
+template<class Metric>
+concept grid_metric = std::same_as<Metric, metric::euclidean> or
+                      std::same_as<Metric, metric::squared_euclidean> or
+                      std::same_as<Metric, metric::manhattan> or
+                      std::same_as<Metric, metric::chebyshev> or
+                      std::same_as<Metric, metric::hex>;
+
+namespace detail {
+
+// distance along each column to the nearest obstacle, or unreachable
+template<class T, class Obstacle>
+void column_distances(grid<T> const & cells, Obstacle & is_obstacle,
+                      std::vector<std::uint32_t> & g,
+                      std::uint32_t unreachable, std::size_t workers)
+{
+    std::size_t const width = cells.width();
+    std::size_t const height = cells.height();
+
+    // sweep whole rows at a time, so that each worker reads contiguous memory
+    parallel_for(width, [&](std::size_t, std::size_t first, std::size_t last) {
+        for (std::size_t x = first; x < last; ++x) {
+            g[x] = is_obstacle(cells(x, 0))? 0 : unreachable;
+        }
+        for (std::size_t y = 1; y < height; ++y) {
+            std::uint32_t const * above = g.data() + (y - 1) * width;
+            std::uint32_t * row = g.data() + y * width;
+            for (std::size_t x = first; x < last; ++x) {
+                row[x] = is_obstacle(cells(x, y))? 0 :
+                         std::min(unreachable, above[x] + 1);
+            }
+        }
+        for (std::size_t y = height - 1; y-- > 0;) {
+            std::uint32_t const * below = g.data() + (y + 1) * width;
+            std::uint32_t * row = g.data() + y * width;
+            for (std::size_t x = first; x < last; ++x) {
+                row[x] = std::min(row[x], below[x] + 1);
+            }
+        }
+    }, workers);
+}
+
+// min over i of |x - i| + g(i)
+inline void manhattan_row(std::uint32_t const * g, std::uint32_t * d,
+                          std::size_t width)
+{
+    d[0] = g[0];
+    for (std::size_t x = 1; x < width; ++x) {
+        d[x] = std::min(g[x], d[x - 1] + 1);
+    }
+    for (std::size_t x = width - 1; x-- > 0;) {
+        d[x] = std::min(d[x], d[x + 1] + 1);
+    }
+}
+
+// min over i of max(|x - i|, g(i)), from Meijster, Roerdink and Hesselink's
+// "A General Algorithm for Computing Distance Transforms in Linear Time"
+inline void chebyshev_row(std::uint32_t const * g, std::uint32_t * d,
+                          std::size_t width,
+                          std::vector<std::ptrdiff_t> & s,
+                          std::vector<std::ptrdiff_t> & t)
+{
+    auto const m = static_cast<std::ptrdiff_t>(width);
+    auto const f = [g](std::ptrdiff_t x, std::ptrdiff_t i) {
+        return std::max<std::ptrdiff_t>(x < i? i - x : x - i, g[i]);
+    };
+    auto const sep = [g](std::ptrdiff_t i, std::ptrdiff_t u) {
+        std::ptrdiff_t const gi = g[i], gu = g[u];
+        return gi <= gu? std::max(i + gu, (i + u) / 2) :
+                         std::min(u - gi, (i + u) / 2);
+    };
+
+    s.resize(width);
+    t.resize(width);
+    std::ptrdiff_t q = 0;
+    s[0] = t[0] = 0;
+    for (std::ptrdiff_t u = 1; u < m; ++u) {
+        while (q >= 0 and f(t[q], s[q]) > f(t[q], u)) { --q; }
+        if (q < 0) {
+            q = 0;
+            s[0] = u;
+        }
+        else {
+            std::ptrdiff_t const w = 1 + sep(s[q], u);
+            if (w < m) {
+                ++q;
+                s[q] = u;
+                t[q] = w;
+            }
+        }
+    }
+    for (std::ptrdiff_t u = m - 1; u >= 0; --u) {
+        d[u] = static_cast<std::uint32_t>(f(u, s[q]));
+        if (u == t[q]) { --q; }
+    }
+}
+
+// min over i of (x - i)^2 + g(i)^2, from Felzenszwalb and Huttenlocher's
+// "Distance Transforms of Sampled Functions"
+inline void squared_euclidean_row(std::uint32_t const * g, double * d,
+                                  std::size_t width, std::uint32_t unreachable,
+                                  std::vector<std::ptrdiff_t> & v,
+                                  std::vector<double> & z)
+{
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    auto const n = static_cast<std::ptrdiff_t>(width);
+    auto const f = [g](std::ptrdiff_t i) {
+        return static_cast<double>(g[i]) * g[i];
+    };
+
+    // columns without any obstacle don't contribute a parabola
+    std::ptrdiff_t first = 0;
+    while (first < n and g[first] >= unreachable) { ++first; }
+    if (first == n) {
+        std::fill(d, d + n, infinity);
+        return;
+    }
+
+    v.resize(width);
+    z.resize(width + 1);
+    std::ptrdiff_t k = 0;
+    v[0] = first;
+    z[0] = -infinity;
+    z[1] = infinity;
+    for (std::ptrdiff_t q = first + 1; q < n; ++q) {
+        if (g[q] >= unreachable) { continue; }
+        double s;
+        for (;;) {
+            auto const p = v[k];
+            s = ((f(q) + q*q) - (f(p) + p*p)) / (2.0*q - 2.0*p);
+            if (s > z[k]) { break; }
+            --k;
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = infinity;
+    }
+
+    k = 0;
+    for (std::ptrdiff_t q = 0; q < n; ++q) {
+        while (z[k + 1] < q) { ++k; }
+        auto const p = v[k];
+        d[q] = static_cast<double>(q - p) * (q - p) + f(p);
+    }
+}
+
+// exact hex distances by propagating along the axial neighbors in two raster
+// passes; each pass only uses the neighbors that precede a cell in its order
+template<class T, class Obstacle>
+void hex_distances(grid<T> const & cells, Obstacle & is_obstacle,
+                   std::vector<std::uint32_t> & d, std::uint32_t unreachable)
+{
+    using hex_directions = flat_hex::direction_name;
+    auto const width = static_cast<std::ptrdiff_t>(cells.width());
+    auto const height = static_cast<std::ptrdiff_t>(cells.height());
+    auto const relax = [&](std::ptrdiff_t x, std::ptrdiff_t y, int sign) {
+        std::uint32_t best = d[y * width + x];
+        for (auto const & [dx, dy] : direction_offsets_v<hex_directions>) {
+            if (sign * dy > 0 or (dy == 0 and sign * dx > 0)) { continue; }
+            std::ptrdiff_t const nx = x + dx, ny = y + dy;
+            if (nx < 0 or ny < 0 or nx >= width or ny >= height) { continue; }
+            best = std::min(best, d[ny * width + nx] + 1);
+        }
+        d[y * width + x] = best;
+    };
+
+    for (std::ptrdiff_t y = 0; y < height; ++y) {
+        for (std::ptrdiff_t x = 0; x < width; ++x) {
+            d[y * width + x] = is_obstacle(cells(x, y))? 0 : unreachable;
+            relax(x, y, 1);
+        }
+    }
+    for (std::ptrdiff_t y = height; y-- > 0;) {
+        for (std::ptrdiff_t x = width; x-- > 0;) {
+            relax(x, y, -1);
+        }
+    }
+}
+
+template<class Distance>
+constexpr Distance unreachable_distance()
+{
+    if constexpr (std::numeric_limits<Distance>::has_infinity) {
+        return std::numeric_limits<Distance>::infinity();
+    }
+    else {
+        return std::numeric_limits<Distance>::max();
+    }
+}
+}
+
+/** Compute the distance from each cell of a grid to the nearest obstacle.
+ *
+ * Return
+ *   A grid the same size as cells holding the distance of each cell to its
+ *   nearest obstacle. Obstacles have distance 0, and cells of a grid without
+ *   any obstacles have infinite (or the maximum representable) distance.
+ *
+ * Parameters
+ *   cells - the grid to measure
+ *   is_obstacle - thread-safe predicate determining if a cell is an obstacle
+ *   workers - the maximum amount of threads to compute with
+ *
+ * Template Parameters
+ *   Metric - one of the sp::metric types; hex distances use axial coordinates
+ *   Distance - the arithmetic type of the output distances. Euclidean
+ *              distances require a floating point type; use
+ *              metric::squared_euclidean for exact integer distances
+ *
+ * Euclidean, manhattan and chebyshev distances are computed separably: first
+ * down the columns, then across the rows, with both passes parallelized.
+ * Euclidean rows use the lower envelope of parabolas from Felzenszwalb and
+ * Huttenlocher, and chebyshev rows use the envelope from Meijster et al. Hex
+ * distances aren't separable over axial coordinates, so they're propagated in
+ * two sequential raster passes instead.
+ */
+template<grid_metric Metric, class Distance = float, class T,
+         std::predicate<T const &> Obstacle>
+    requires std::is_arithmetic_v<Distance> and
+             (std::floating_point<Distance> or
+              not std::same_as<Metric, metric::euclidean>)
+
+grid<Distance> distance_transform(grid<T> const & cells, Obstacle && is_obstacle,
+                                  std::size_t workers = worker_count())
+{
+    std::size_t const width = cells.width();
+    std::size_t const height = cells.height();
+    grid<Distance> result(width, height);
+    if (cells.size() == 0) { return result; }
+
+    constexpr Distance infinity = detail::unreachable_distance<Distance>();
+    auto const unreachable = static_cast<std::uint32_t>(width + height);
+    std::vector<std::uint32_t> g(cells.size());
+
+    if constexpr (std::same_as<Metric, metric::hex>) {
+        detail::hex_distances(cells, is_obstacle, g, unreachable);
+        std::ranges::transform(g, result.begin(), [=](std::uint32_t d) {
+            return d >= unreachable? infinity : static_cast<Distance>(d);
+        });
+        return result;
+    }
+    else {
+        detail::column_distances(cells, is_obstacle, g, unreachable, workers);
+        parallel_for(height, [&](std::size_t, std::size_t first, std::size_t last) {
+            std::vector<std::uint32_t> row(width);
+            std::vector<double> squared(width);
+            std::vector<std::ptrdiff_t> s, t;
+            std::vector<double> z;
+            for (std::size_t y = first; y < last; ++y) {
+                std::uint32_t const * column = g.data() + y * width;
+                Distance * out = result.data() + y * width;
+
+                if constexpr (std::same_as<Metric, metric::manhattan> or
+                              std::same_as<Metric, metric::chebyshev>) {
+                    if constexpr (std::same_as<Metric, metric::manhattan>) {
+                        detail::manhattan_row(column, row.data(), width);
+                    }
+                    else {
+                        detail::chebyshev_row(column, row.data(), width, s, t);
+                    }
+                    std::transform(row.begin(), row.end(), out,
+                        [=](std::uint32_t d) {
+                            return d >= unreachable? infinity :
+                                                     static_cast<Distance>(d);
+                        });
+                }
+                else {
+                    detail::squared_euclidean_row(column, squared.data(), width,
+                                                  unreachable, s, z);
+                    std::transform(squared.begin(), squared.end(), out,
+                        [=](double d) {
+                            if (std::isinf(d)) { return infinity; }
+                            if constexpr (std::same_as<Metric, metric::euclidean>) {
+                                return static_cast<Distance>(std::sqrt(d));
+                            }
+                            else {
+                                return static_cast<Distance>(d);
+                            }
+                        });
+                }
+            }
+        }, workers);
+        return result;
+    }
+}
+
+/** Compute the distance from each cell to the nearest cell not equal to T{}. */
+template<grid_metric Metric, class Distance = float, std::equality_comparable T>
+    requires std::is_arithmetic_v<Distance> and
+             (std::floating_point<Distance> or
+              not std::same_as<Metric, metric::euclidean>)
+
+grid<Distance> distance_transform(grid<T> const & cells)
+{
+    return distance_transform<Metric, Distance>(cells, [](T const & cell) {
+        return cell != T{};
+    });
+}
+}
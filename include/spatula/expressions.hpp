@@ -0,0 +1,358 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+namespace sp {
+
+namespace detail {
+
+// the base of every node in an expression, so that the operators below only
+// apply when one side is already an expression
+struct expression_base {};
+
+template<class T>
+concept expression_node = std::derived_from<std::remove_cvref_t<T>, expression_base>;
+
+template<class Range>
+concept vector_range = ranges::random_access_range<Range> and
+                       ranges::sized_range<Range> and
+                       semivector<ranges::range_value_t<Range>>;
+
+// a vector, held by reference when it's an lvalue and by value otherwise
+template<class Vector>
+class vector_leaf : public expression_base {
+public:
+    using value_type = std::remove_cvref_t<Vector>;
+    static constexpr bool is_range = false;
+
+    explicit constexpr vector_leaf(Vector && v) : _vector(std::forward<Vector>(v)) {}
+
+    template<std::size_t I, class... Index>
+    constexpr auto component(Index...) const
+    {
+        return get_component<I>(_vector);
+    }
+private:
+    std::conditional_t<std::is_lvalue_reference_v<Vector>,
+                       value_type const &, value_type> _vector;
+};
+
+// a range of vectors, each of which is used in turn
+template<class View>
+class range_leaf : public expression_base {
+public:
+    using value_type = ranges::range_value_t<View>;
+    static constexpr bool is_range = true;
+
+    explicit range_leaf(View view) : _view(std::move(view)) {}
+
+    std::size_t size() const { return static_cast<std::size_t>(ranges::size(_view)); }
+
+    template<std::size_t I>
+    auto component(std::size_t k) const
+    {
+        return get_component<I>(ranges::begin(_view)[static_cast<difference>(k)]);
+    }
+private:
+    using difference = ranges::range_difference_t<View>;
+    View _view;
+};
+
+// a number that applies to every component
+template<class Scalar>
+class scalar_leaf : public expression_base {
+public:
+    using value_type = void;
+    static constexpr bool is_range = false;
+
+    explicit constexpr scalar_leaf(Scalar value) : _value(value) {}
+
+    template<std::size_t I, class... Index>
+    constexpr Scalar component(Index...) const { return _value; }
+private:
+    Scalar _value;
+};
+
+template<class... Operands>
+struct first_value_type { using type = void; };
+
+template<class Operand, class... Operands>
+struct first_value_type<Operand, Operands...> {
+    using type = std::conditional_t<
+        std::is_void_v<typename Operand::value_type>,
+        typename first_value_type<Operands...>::type,
+        typename Operand::value_type>;
+};
+
+// an operation applied to the same component of each operand
+template<class Operation, class... Operands>
+class operation_node : public expression_base {
+public:
+    using value_type = typename first_value_type<Operands...>::type;
+    static constexpr bool is_range = (Operands::is_range or ...);
+
+    explicit constexpr operation_node(Operands... operands)
+        : _operands(std::move(operands)...)
+    {
+    }
+
+    // the length of the first range in the expression
+    std::size_t size() const requires is_range
+    {
+        std::size_t result = 0;
+        bool found = false;
+        std::apply([&](auto const &... operand) {
+            auto const visit = [&](auto const & o) {
+                if constexpr (std::remove_cvref_t<decltype(o)>::is_range) {
+                    if (not found) { result = o.size(); found = true; }
+                }
+            };
+            (visit(operand), ...);
+        }, _operands);
+        return result;
+    }
+
+    template<std::size_t I, class... Index>
+    constexpr auto component(Index... k) const
+    {
+        return std::apply([&](auto const &... operand) {
+            return Operation{}(operand.template component<I>(k...)...);
+        }, _operands);
+    }
+private:
+    std::tuple<Operands...> _operands;
+};
+
+template<class T>
+concept scalar_operand = std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+template<class T>
+concept vector_operand = expression_node<T> or semivector<std::remove_cvref_t<T>> or
+                         vector_range<T>;
+
+template<class T>
+constexpr auto as_operand(T && x)
+{
+    if constexpr (expression_node<T>) {
+        return std::remove_cvref_t<T>(std::forward<T>(x));
+    }
+    else if constexpr (scalar_operand<T>) {
+        return scalar_leaf<std::remove_cvref_t<T>>{x};
+    }
+    else if constexpr (semivector<std::remove_cvref_t<T>>) {
+        return vector_leaf<T>{std::forward<T>(x)};
+    }
+    else {
+        return range_leaf<ranges::views::all_t<T>>{ranges::views::all(std::forward<T>(x))};
+    }
+}
+
+template<class T>
+using operand_t = decltype(as_operand(std::declval<T>()));
+
+// the vector operands of an expression must agree on their dimension
+template<class A, class B>
+concept compatible_operands =
+    std::is_void_v<typename operand_t<A>::value_type> or
+    std::is_void_v<typename operand_t<B>::value_type> or
+    (dimension_v<typename operand_t<A>::value_type> ==
+     dimension_v<typename operand_t<B>::value_type>);
+
+template<class Operation, class... T>
+constexpr auto make_node(T &&... x)
+{
+    return operation_node<Operation, operand_t<T>...>{as_operand(std::forward<T>(x))...};
+}
+
+//
+// Operators, found by argument-dependent lookup on expression nodes
+//
+
+template<class A, class B>
+    requires (expression_node<A> or expression_node<B>) and
+             vector_operand<A> and vector_operand<B> and
+             compatible_operands<A, B>
+
+constexpr auto operator+(A && a, B && b)
+{
+    return make_node<std::plus<>>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<class A, class B>
+    requires (expression_node<A> or expression_node<B>) and
+             vector_operand<A> and vector_operand<B> and
+             compatible_operands<A, B>
+
+constexpr auto operator-(A && a, B && b)
+{
+    return make_node<std::minus<>>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<expression_node A>
+constexpr auto operator-(A && a)
+{
+    return make_node<std::negate<>>(std::forward<A>(a));
+}
+
+// products and quotients are component-wise between vectors, and scale every
+// component by a number
+template<class A, class B>
+    requires (expression_node<A> or expression_node<B>) and
+             (vector_operand<A> or scalar_operand<A>) and
+             (vector_operand<B> or scalar_operand<B>) and
+             compatible_operands<A, B>
+
+constexpr auto operator*(A && a, B && b)
+{
+    return make_node<std::multiplies<>>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<class A, class B>
+    requires (expression_node<A> or expression_node<B>) and
+             vector_operand<A> and (vector_operand<B> or scalar_operand<B>) and
+             compatible_operands<A, B>
+
+constexpr auto operator/(A && a, B && b)
+{
+    return make_node<std::divides<>>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<class To, class Expression, std::size_t... I, class... Index>
+constexpr void assign_components(To & target, Expression const & e,
+                                 std::index_sequence<I...>, Index... k)
+{
+    using scalar = scalar_field_t<To>;
+    ((get_component<I>(target) =
+        static_cast<scalar>(e.template component<I>(k...))), ...);
+}
+}
+
+/** An expression of vectors evaluated lazily, one component at a time.
+ *
+ * Wrapping a semivector or a random-access range of semivectors with expr
+ * lets it take part in component-wise arithmetic with +, -, * and /, where
+ * products and quotients with a number scale every component. Nothing is
+ * computed until the expression is assigned or evaluated, when each
+ * component of the result is computed in a single pass with no temporary
+ * vectors, so the vector types don't need any operators of their own.
+ *
+ * Every operator needs an expression on at least one side, since plain
+ * vectors have no operators to start one, but the other side may be a
+ * plain semivector, range or number without being wrapped. Vectors
+ * combined with ranges apply to every element of the ranges, and the ranges
+ * must be at least as long as the first one.
+ *
+ * Lvalues are held by reference and rvalues by value, so an expression must
+ * not outlive the lvalues it was built from.
+ *
+ * Example:
+ *     sp::assign(velocity, sp::expr(velocity) + sp::expr(acceleration) * dt);
+ *     sp::assign(positions, sp::expr(positions) + sp::expr(velocities) * dt);
+ */
+template<class T>
+    requires semivector<std::remove_cvref_t<T>> or detail::vector_range<T>
+
+constexpr auto expr(T && x)
+{
+    return detail::as_operand(std::forward<T>(x));
+}
+
+/** An expression of vectors, as built by expr. */
+template<class Expression>
+concept vector_expression =
+    detail::expression_node<Expression> and
+    not std::is_void_v<typename std::remove_cvref_t<Expression>::value_type>;
+
+/** Evaluate an expression of vectors into a vector.
+ *
+ * Return
+ *   The value of the expression, as the given vector type or, by default, the
+ *   type of its first vector.
+ */
+template<class To = void, vector_expression Expression>
+    requires (not Expression::is_range)
+
+constexpr auto evaluate(Expression const & e)
+{
+    using Vector = std::conditional_t<std::is_void_v<To>,
+                                      typename Expression::value_type, To>;
+    constexpr std::size_t N = dimension_v<typename Expression::value_type>;
+    static_assert(dimension_v<Vector> == N);
+
+    Vector result{};
+    detail::assign_components(result, e, std::make_index_sequence<N>{});
+    return result;
+}
+
+/** Evaluate an expression of ranges one element at a time.
+ *
+ * Return
+ *   An iterator past the last value of the expression.
+ *
+ * Parameters
+ *   e - the expression to evaluate
+ *   out - iterator to the start of its values, as the type of the first range
+ *         or vector in the expression
+ */
+template<vector_expression Expression, std::weakly_incrementable Out>
+    requires Expression::is_range and
+             std::indirectly_writable<Out, typename Expression::value_type>
+
+Out evaluate(Expression const & e, Out out)
+{
+    using Vector = typename Expression::value_type;
+    constexpr auto indices = std::make_index_sequence<dimension_v<Vector>>{};
+    std::size_t const count = e.size();
+    for (std::size_t k = 0; k < count; ++k) {
+        Vector v{};
+        detail::assign_components(v, e, indices, k);
+        *out = v;
+        ++out;
+    }
+    return out;
+}
+
+/** Assign the value of an expression to a vector, component by component.
+ *
+ * The vector may appear in the expression, since each component of the
+ * result only depends on the same component of the operands.
+ */
+template<semivector Vector, vector_expression Expression>
+    requires (not Expression::is_range) and
+             (dimension_v<Vector> == dimension_v<typename Expression::value_type>)
+
+constexpr void assign(Vector & target, Expression const & e)
+{
+    detail::assign_components(target, e, std::make_index_sequence<dimension_v<Vector>>{});
+}
+
+/** Assign the values of an expression of ranges to the elements of a range,
+ * which may also appear in the expression.
+ */
+template<detail::vector_range Range, vector_expression Expression>
+    requires Expression::is_range and
+             (dimension_v<ranges::range_value_t<Range>> ==
+              dimension_v<typename Expression::value_type>)
+
+void assign(Range && target, Expression const & e)
+{
+    using Vector = ranges::range_value_t<Range>;
+    constexpr auto indices = std::make_index_sequence<dimension_v<Vector>>{};
+    auto it = ranges::begin(target);
+    std::size_t const count = e.size();
+    for (std::size_t k = 0; k < count; ++k, ++it) {
+        detail::assign_components(*it, e, indices, k);
+    }
+}
+}
@@ -0,0 +1,465 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+#include "spatula/layouts.hpp"
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <bit>
+#include <compare>
+#include <limits>
+#include <utility>
+
+// algorithms
+#include <algorithm>
+#include <memory>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace sp {
+
+namespace detail {
+
+template<int Bits> struct fixed_storage;
+template<int Bits> requires (Bits <= 32)
+struct fixed_storage<Bits> {
+    using type = std::int32_t;
+    using wide = std::int64_t;
+    using unsigned_wide = std::uint64_t;
+};
+#if defined(__SIZEOF_INT128__)
+template<int Bits> requires (Bits > 32 and Bits <= 64)
+struct fixed_storage<Bits> {
+    using type = std::int64_t;
+    __extension__ using wide = __int128;
+    __extension__ using unsigned_wide = unsigned __int128;
+};
+#endif
+
+// floor(sqrt(n)) of an unsigned integer of any width, bit by bit
+template<class Unsigned>
+constexpr Unsigned isqrt_bitwise(Unsigned n)
+{
+    Unsigned root = 0;
+    Unsigned bit = Unsigned{1} << (std::numeric_limits<Unsigned>::digits - 2);
+    while (bit > n) { bit >>= 2; }
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// floor(16 sqrt(t)), to seed newton's method with 8 good bits
+constexpr std::array<std::uint16_t, 256> sqrt_seeds = [] {
+    std::array<std::uint16_t, 256> seeds{};
+    for (std::uint32_t t = 0; t < 256; ++t) {
+        seeds[t] = static_cast<std::uint16_t>(isqrt_bitwise(t << 8));
+    }
+    return seeds;
+}();
+
+template<class Unsigned>
+int bit_width(Unsigned n)
+{
+    if constexpr (sizeof(Unsigned) <= sizeof(std::uint64_t)) {
+        return static_cast<int>(std::bit_width(static_cast<std::uint64_t>(n)));
+    }
+    else {
+        auto const high = static_cast<std::uint64_t>(n >> 64);
+        return high != 0? 64 + static_cast<int>(std::bit_width(high)) :
+                          static_cast<int>(std::bit_width(static_cast<std::uint64_t>(n)));
+    }
+}
+
+// floor(sqrt(n)), seeded from the table by the top 8 bits of n
+template<class Unsigned>
+Unsigned isqrt(Unsigned n)
+{
+    if (n < 256) { return sqrt_seeds[static_cast<std::size_t>(n)] >> 4; }
+
+    // shift by an even amount so that the top bits index [64, 256)
+    int const shift = (bit_width(n) - 7) & ~1;
+    auto const top = static_cast<std::size_t>(n >> shift);
+    Unsigned root = (Unsigned{sqrt_seeds[top]} << (shift / 2)) >> 4;
+
+    // each step doubles the good bits, so three reach 64 bits
+    constexpr int steps = sizeof(Unsigned) > 8? 3 : 2;
+    for (int i = 0; i < steps; ++i) { root = (root + n / root) / 2; }
+    while (root * root > n) { --root; }
+    while ((root + 1) * (root + 1) <= n) { ++root; }
+    return root;
+}
+
+// sin over a quarter turn in Q30, from a taylor series of basic operations
+// that every compiler evaluates the same way
+constexpr std::size_t sine_steps = 1024;
+constexpr std::array<std::int32_t, sine_steps + 1> quarter_sines = [] {
+    std::array<std::int32_t, sine_steps + 1> table{};
+    constexpr double quarter_turn = 1.57079632679489661923;
+    for (std::size_t i = 0; i <= sine_steps; ++i) {
+        double const x = quarter_turn * static_cast<double>(i) / sine_steps;
+        double term = x, sum = x;
+        for (int n = 1; n < 12; ++n) {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        table[i] = static_cast<std::int32_t>(sum * (1 << 30) + 0.5);
+    }
+    return table;
+}();
+
+// sin of a phase where a whole turn is 2^32, in Q30
+constexpr std::int32_t sine_of_phase(std::uint32_t phase)
+{
+    constexpr int index_shift = 30 - std::bit_width(sine_steps) + 1;
+    constexpr std::uint32_t quarter = 1u << 30;
+
+    std::uint32_t const quadrant = phase >> 30;
+    std::uint32_t position = phase & (quarter - 1);
+    if (quadrant & 1u) { position = quarter - position; }
+
+    std::uint32_t const index = position >> index_shift;
+    std::int64_t const fraction = position & ((1u << index_shift) - 1);
+    std::int32_t value = quarter_sines[index];
+    if (index < sine_steps) {
+        value += static_cast<std::int32_t>(
+            ((quarter_sines[index + 1] - value) * fraction) >> index_shift);
+    }
+    return quadrant & 2u? -value : value;
+}
+}
+
+/** A signed fixed-point number with IntBits integer bits, including the
+ * sign, and FracBits fraction bits.
+ *
+ * Fixed-point arithmetic is exact integer arithmetic, so the same operations
+ * give bit-identical results on every machine, unlike floating point. Addition
+ * and subtraction wrap around like unsigned integers. Multiplication widens,
+ * then rounds to the nearest value, with ties rounding up. Division rounds
+ * toward zero and saturates when dividing by zero.
+ *
+ * Integers convert implicitly and exactly. Floating point numbers convert
+ * explicitly, which is meant for setting up constants and reading results, not
+ * for the simulation itself.
+ *
+ * Example:
+ *     using real = sp::fixed<16, 16>;
+ *     real const dt{1.0 / 60.0};
+ *     real x = 3;
+ *     x += real{2.5} * dt;
+ */
+template<int IntBits, int FracBits>
+    requires (IntBits >= 1 and FracBits >= 0 and
+              requires { typename detail::fixed_storage<IntBits + FracBits>::type; })
+class fixed {
+public:
+    using storage = typename detail::fixed_storage<IntBits + FracBits>::type;
+    using wide = typename detail::fixed_storage<IntBits + FracBits>::wide;
+    using unsigned_wide = typename detail::fixed_storage<IntBits + FracBits>::unsigned_wide;
+    static constexpr int integer_bits = IntBits;
+    static constexpr int fraction_bits = FracBits;
+
+    constexpr fixed() = default;
+
+    template<std::integral Integer>
+    constexpr fixed(Integer value)
+        : _raw(static_cast<storage>(static_cast<storage>(value) << FracBits))
+    {
+    }
+
+    template<std::floating_point Float>
+    constexpr explicit fixed(Float value)
+    {
+        Float const scaled = value * static_cast<Float>(std::uint64_t{1} << FracBits);
+        _raw = static_cast<storage>(scaled >= 0? scaled + Float(0.5) : scaled - Float(0.5));
+    }
+
+    /** The fixed-point number with the given representation. */
+    static constexpr fixed from_raw(storage raw)
+    {
+        fixed f;
+        f._raw = raw;
+        return f;
+    }
+
+    constexpr storage raw() const { return _raw; }
+
+    template<std::floating_point Float>
+    constexpr explicit operator Float() const
+    {
+        return static_cast<Float>(_raw) / static_cast<Float>(std::uint64_t{1} << FracBits);
+    }
+
+    /** The greatest integer less than or equal to the number. */
+    template<std::integral Integer>
+    constexpr explicit operator Integer() const
+    {
+        return static_cast<Integer>(_raw >> FracBits);
+    }
+
+    friend constexpr fixed operator+(fixed a, fixed b)
+    {
+        return from_raw(static_cast<storage>(unsigned_raw(a) + unsigned_raw(b)));
+    }
+    friend constexpr fixed operator-(fixed a, fixed b)
+    {
+        return from_raw(static_cast<storage>(unsigned_raw(a) - unsigned_raw(b)));
+    }
+    friend constexpr fixed operator*(fixed a, fixed b)
+    {
+        // shifting the unsigned product keeps the same low bits as an
+        // arithmetic shift would, without overflowing the rounding
+        auto const product = static_cast<unsigned_wide>(wide{a._raw} * wide{b._raw});
+        if constexpr (FracBits == 0) {
+            return from_raw(static_cast<storage>(product));
+        }
+        else {
+            constexpr unsigned_wide rounding = unsigned_wide{1} << (FracBits - 1);
+            return from_raw(static_cast<storage>((product + rounding) >> FracBits));
+        }
+    }
+    friend constexpr fixed operator/(fixed a, fixed b)
+    {
+        if (b._raw == 0) {
+            return from_raw(a._raw < 0? std::numeric_limits<storage>::min() :
+                                        std::numeric_limits<storage>::max());
+        }
+        return from_raw(static_cast<storage>((wide{a._raw} << FracBits) / b._raw));
+    }
+    constexpr fixed operator-() const { return fixed{} - *this; }
+
+    constexpr fixed & operator+=(fixed other) { return *this = *this + other; }
+    constexpr fixed & operator-=(fixed other) { return *this = *this - other; }
+    constexpr fixed & operator*=(fixed other) { return *this = *this * other; }
+    constexpr fixed & operator/=(fixed other) { return *this = *this / other; }
+
+    friend constexpr bool operator==(fixed, fixed) = default;
+    friend constexpr auto operator<=>(fixed, fixed) = default;
+private:
+    storage _raw = 0;
+
+    static constexpr std::make_unsigned_t<storage> unsigned_raw(fixed f)
+    {
+        return static_cast<std::make_unsigned_t<storage>>(f._raw);
+    }
+};
+
+namespace detail {
+template<class T>
+struct is_fixed : std::false_type {};
+
+template<int IntBits, int FracBits>
+struct is_fixed<fixed<IntBits, FracBits>> : std::true_type {};
+}
+
+/** A fixed-point number type. */
+template<class T>
+concept fixed_point = detail::is_fixed<T>::value;
+
+template<int IntBits, int FracBits>
+constexpr fixed<IntBits, FracBits> abs(fixed<IntBits, FracBits> x)
+{
+    return x.raw() < 0? -x : x;
+}
+
+/** The square root of a fixed-point number, rounded down, or zero if it's
+ * negative.
+ */
+template<int IntBits, int FracBits>
+fixed<IntBits, FracBits> sqrt(fixed<IntBits, FracBits> x)
+{
+    using real = fixed<IntBits, FracBits>;
+    using unsigned_wide = typename real::unsigned_wide;
+    if (x.raw() <= 0) { return real{}; }
+
+    // sqrt(raw / 2^F) * 2^F = sqrt(raw * 2^F)
+    auto const n = static_cast<unsigned_wide>(x.raw()) << FracBits;
+    return real::from_raw(static_cast<typename real::storage>(detail::isqrt(n)));
+}
+
+namespace detail {
+// the phase of an angle in radians, where a whole turn is 2^32
+template<int IntBits, int FracBits>
+constexpr std::uint32_t phase_of(fixed<IntBits, FracBits> radians)
+{
+    using real = fixed<IntBits, FracBits>;
+    using unsigned_wide = typename real::unsigned_wide;
+    constexpr std::int64_t turns_per_radian = 683565276;    // 2^32 / 2pi
+    auto const phase = static_cast<unsigned_wide>(
+        typename real::wide{radians.raw()} * turns_per_radian);
+    return static_cast<std::uint32_t>(phase >> FracBits);
+}
+
+template<int IntBits, int FracBits>
+constexpr fixed<IntBits, FracBits> from_q30(std::int32_t value)
+{
+    using real = fixed<IntBits, FracBits>;
+    using storage = typename real::storage;
+    if constexpr (FracBits >= 30) {
+        return real::from_raw(static_cast<storage>(storage{value} << (FracBits - 30)));
+    }
+    else {
+        constexpr std::int32_t rounding = 1 << (29 - FracBits);
+        return real::from_raw(static_cast<storage>((value + rounding) >> (30 - FracBits)));
+    }
+}
+}
+
+/** The sine of an angle in radians, interpolated from a table to within
+ * about 3e-7 plus the precision of the type.
+ */
+template<int IntBits, int FracBits>
+constexpr fixed<IntBits, FracBits> sin(fixed<IntBits, FracBits> radians)
+{
+    return detail::from_q30<IntBits, FracBits>(
+        detail::sine_of_phase(detail::phase_of(radians)));
+}
+
+/** The cosine of an angle in radians, interpolated like sin. */
+template<int IntBits, int FracBits>
+constexpr fixed<IntBits, FracBits> cos(fixed<IntBits, FracBits> radians)
+{
+    return detail::from_q30<IntBits, FracBits>(
+        detail::sine_of_phase(detail::phase_of(radians) + (1u << 30)));
+}
+
+namespace detail {
+
+// a * b for arrays of fixed-point numbers, where either one may be broadcast
+template<int IntBits, int FracBits>
+void multiply_fixed(fixed<IntBits, FracBits> const * a, std::size_t a_stride,
+                    fixed<IntBits, FracBits> const * b, std::size_t b_stride,
+                    std::size_t count, fixed<IntBits, FracBits> * out)
+{
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    if constexpr (IntBits + FracBits <= 32 and FracBits > 0) {
+        // the even and odd lanes are multiplied into 64 bits separately, and
+        // a logical shift leaves the same low 32 bits as the scalar code
+        __m256i const rounding = _mm256_set1_epi64x(std::int64_t{1} << (FracBits - 1));
+        __m256i const broadcast_a = _mm256_set1_epi32(a_stride == 0? a->raw() : 0);
+        __m256i const broadcast_b = _mm256_set1_epi32(b_stride == 0? b->raw() : 0);
+        for (; i + 8 <= count; i += 8) {
+            __m256i const x = a_stride == 0? broadcast_a :
+                _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + i));
+            __m256i const y = b_stride == 0? broadcast_b :
+                _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + i));
+            __m256i even = _mm256_add_epi64(_mm256_mul_epi32(x, y), rounding);
+            __m256i odd = _mm256_add_epi64(
+                _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32)),
+                rounding);
+            even = _mm256_srli_epi64(even, FracBits);
+            odd = _mm256_slli_epi64(_mm256_srli_epi64(odd, FracBits), 32);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                                _mm256_blend_epi32(even, odd, 0b10101010));
+        }
+    }
+#endif
+    for (; i < count; ++i) { out[i] = a[i * a_stride] * b[i * b_stride]; }
+}
+
+template<class Range>
+concept contiguous_fixed =
+    ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+    fixed_point<ranges::range_value_t<Range>>;
+}
+
+/** Multiply two ranges of fixed-point numbers element by element.
+ *
+ * Return
+ *   An iterator past the last product.
+ *
+ * Parameters
+ *   a, b - the numbers to multiply, where b is at least as long as a
+ *   out - iterator to the start of the products
+ *
+ * Contiguous ranges of 32-bit numbers are multiplied eight at a time with
+ * AVX2 when it's enabled, with the same results as the scalar operator.
+ */
+template<ranges::input_range A, ranges::input_range B, std::weakly_incrementable Out>
+    requires fixed_point<ranges::range_value_t<A>> and
+             std::same_as<ranges::range_value_t<A>, ranges::range_value_t<B>> and
+             std::indirectly_writable<Out, ranges::range_value_t<A>>
+
+Out multiply(A && a, B && b, Out out)
+{
+    using real = ranges::range_value_t<A>;
+    if constexpr (detail::contiguous_fixed<A> and detail::contiguous_fixed<B> and
+                  detail::contiguous_output<Out, real>) {
+        auto const count = static_cast<std::size_t>(ranges::size(a));
+        detail::multiply_fixed(ranges::data(a), 1, ranges::data(b), 1, count,
+                               std::to_address(out));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        auto y = ranges::begin(b);
+        for (real const x : a) {
+            *out = x * *y;
+            ++out;
+            ++y;
+        }
+        return out;
+    }
+}
+
+/** Scale a range of vectors with fixed-point components.
+ *
+ * Return
+ *   An iterator past the last scaled vector.
+ *
+ * Parameters
+ *   vectors - the vectors to scale
+ *   factor - the amount to scale each component by
+ *   out - iterator to the start of the scaled vectors
+ *
+ * Contiguous ranges of packed vectors are scaled as one array of scalars,
+ * with the same kernel as multiply.
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires semivector<ranges::range_value_t<Range>> and
+             fixed_point<scalar_field_t<ranges::range_value_t<Range>>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out scale(Range && vectors, scalar_field_t<ranges::range_value_t<Range>> factor,
+          Out out)
+{
+    using Vector = ranges::range_value_t<Range>;
+    using real = scalar_field_t<Vector>;
+    constexpr std::size_t N = dimension_v<Vector>;
+    if constexpr (packed_layout<Vector> and
+                  ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+                  detail::contiguous_output<Out, Vector>) {
+        auto const count = static_cast<std::size_t>(ranges::size(vectors));
+        detail::multiply_fixed(reinterpret_cast<real const *>(ranges::data(vectors)), 1,
+                               &factor, 0, count * N,
+                               reinterpret_cast<real *>(std::to_address(out)));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        for (Vector v : vectors) {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((get_component<I>(v) *= factor), ...);
+            }(std::make_index_sequence<N>{});
+            *out = v;
+            ++out;
+        }
+        return out;
+    }
+}
+}
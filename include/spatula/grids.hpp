@@ -0,0 +1,237 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <bit>
+
+// algorithms
+#include <algorithm>
+#include <numeric>
+
+namespace sp {
+
+/** A two-dimensional vector with signed integral components that can address
+ * cells of a grid.
+ *
+ * Hexagonal grids use axial coordinates (q, r), where q is stored in the first
+ * component and r in the second, matching the sp::flat_hex and sp::pointed_hex
+ * direction conventions.
+ */
+template<class Vector>
+concept grid_point = semivector2<Vector> and
+                     std::signed_integral<scalar_field_t<Vector>>;
+
+//
+// Grid metrics
+//
+
+/** The amount of cardinal steps between two grid points. */
+template<grid_point Vector>
+constexpr scalar_field_t<Vector>
+manhattan_distance(Vector const & a, Vector const & b)
+{
+    auto const dx = get_x(a) - get_x(b);
+    auto const dy = get_y(a) - get_y(b);
+    return (dx < 0? -dx : dx) + (dy < 0? -dy : dy);
+}
+
+/** The amount of cardinal or diagonal steps between two grid points. */
+template<grid_point Vector>
+constexpr scalar_field_t<Vector>
+chebyshev_distance(Vector const & a, Vector const & b)
+{
+    auto const dx = get_x(a) - get_x(b);
+    auto const dy = get_y(a) - get_y(b);
+    return std::max(dx < 0? -dx : dx, dy < 0? -dy : dy);
+}
+
+/** The amount of hex steps between two axial grid points. */
+template<grid_point Vector>
+constexpr scalar_field_t<Vector>
+hex_distance(Vector const & a, Vector const & b)
+{
+    auto const dq = get_x(a) - get_x(b);
+    auto const dr = get_y(a) - get_y(b);
+    auto const ds = dq + dr;
+    return std::max({dq < 0? -dq : dq, dr < 0? -dr : dr, ds < 0? -ds : ds});
+}
+
+//
+// Grid storage
+//
+
+/** A row-major, rectangular array of cells.
+ *
+ * Cells are addressed by (x, y) with x in [0, width) and y in [0, height).
+ * Unlike std::vector, a grid of bool holds one bool per cell, so cells can
+ * always be referenced directly.
+ */
+template<std::semiregular T>
+class grid {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+    grid() = default;
+    grid(size_type width, size_type height, T const & value = T{})
+        : _width(width), _height(height),
+          _cells(std::make_unique<T[]>(width * height))
+    {
+        fill(value);
+    }
+
+    grid(grid const & other)
+        : _width(other._width), _height(other._height),
+          _cells(std::make_unique<T[]>(other.size()))
+    {
+        std::ranges::copy(other, begin());
+    }
+    grid(grid && other) noexcept
+        : _width(std::exchange(other._width, 0)),
+          _height(std::exchange(other._height, 0)),
+          _cells(std::move(other._cells))
+    {
+    }
+    grid & operator=(grid other) noexcept
+    {
+        std::swap(_width, other._width);
+        std::swap(_height, other._height);
+        std::swap(_cells, other._cells);
+        return *this;
+    }
+
+    size_type width() const { return _width; }
+    size_type height() const { return _height; }
+    size_type size() const { return _width * _height; }
+
+    /** Determine if a coordinate lies within the grid. */
+    template<std::integral Int>
+    bool contains(Int x, Int y) const
+    {
+        return x >= 0 and y >= 0 and
+               static_cast<size_type>(x) < _width and
+               static_cast<size_type>(y) < _height;
+    }
+    template<grid_point Vector>
+    bool contains(Vector const & p) const
+    {
+        return contains(get_x(p), get_y(p));
+    }
+
+    /** Access the cell at (x, y), which must lie within the grid. */
+    T & operator()(size_type x, size_type y) { return _cells[y * _width + x]; }
+    T const & operator()(size_type x, size_type y) const
+    {
+        return _cells[y * _width + x];
+    }
+
+    T * data() { return _cells.get(); }
+    T const * data() const { return _cells.get(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+
+    void fill(T const & value) { std::ranges::fill(*this, value); }
+
+    void resize(size_type width, size_type height, T const & value = T{})
+    {
+        *this = grid(width, height, value);
+    }
+private:
+    size_type _width = 0;
+    size_type _height = 0;
+    std::unique_ptr<T[]> _cells;
+};
+
+/** A rectangular grid of bits, packed into 64-bit words.
+ *
+ * Cells are addressed by (x, y) with x in [0, width) and y in [0, height).
+ */
+class bit_grid {
+public:
+    using size_type = std::size_t;
+    using word_type = std::uint64_t;
+    static constexpr size_type word_bits = 64;
+
+    bit_grid() = default;
+    bit_grid(size_type width, size_type height)
+        : _width(width), _height(height),
+          _words((width * height + word_bits - 1) / word_bits, 0)
+    {
+    }
+
+    size_type width() const { return _width; }
+    size_type height() const { return _height; }
+    size_type size() const { return _width * _height; }
+
+    /** Determine if a coordinate lies within the grid. */
+    template<std::integral Int>
+    bool contains(Int x, Int y) const
+    {
+        return x >= 0 and y >= 0 and
+               static_cast<size_type>(x) < _width and
+               static_cast<size_type>(y) < _height;
+    }
+    template<grid_point Vector>
+    bool contains(Vector const & p) const
+    {
+        return contains(get_x(p), get_y(p));
+    }
+
+    /** Access the bit at (x, y), which must lie within the grid. */
+    bool test(size_type x, size_type y) const
+    {
+        size_type const i = y * _width + x;
+        return (_words[i / word_bits] >> (i % word_bits)) & 1u;
+    }
+    void set(size_type x, size_type y)
+    {
+        size_type const i = y * _width + x;
+        _words[i / word_bits] |= word_type{1} << (i % word_bits);
+    }
+    void reset(size_type x, size_type y)
+    {
+        size_type const i = y * _width + x;
+        _words[i / word_bits] &= ~(word_type{1} << (i % word_bits));
+    }
+
+    /** Reset every bit in the grid. */
+    void clear() { std::ranges::fill(_words, 0); }
+
+    /** The amount of set bits in the grid. */
+    size_type count() const
+    {
+        return std::accumulate(_words.begin(), _words.end(), size_type{0},
+            [](size_type total, word_type w) {
+                return total + static_cast<size_type>(std::popcount(w));
+            });
+    }
+
+    word_type * data() { return _words.data(); }
+    word_type const * data() const { return _words.data(); }
+
+    void resize(size_type width, size_type height)
+    {
+        _width = width;
+        _height = height;
+        _words.assign((width * height + word_bits - 1) / word_bits, 0);
+    }
+private:
+    size_type _width = 0;
+    size_type _height = 0;
+    std::vector<word_type> _words;
+};
+}
@@ -0,0 +1,365 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <cstddef>
+#include <array>
+#include <bit>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include <cstring>
+
+namespace sp {
+
+/** The memory layout of the components of a vector type.
+ *
+ * Specializations define a static constexpr member `offsets`, an array of the
+ * byte offset of each component from the start of the vector, in component
+ * order. Plain aggregates whose components fill the whole type get their
+ * layout automatically; the adapters in spatula_extensions specialize it for
+ * library types.
+ *
+ * Example:
+ *     template<> struct sp::component_layout<my_vec3> {
+ *         static constexpr std::array<std::size_t, 3> offsets{
+ *             offsetof(my_vec3, x), offsetof(my_vec3, y), offsetof(my_vec3, z)
+ *         };
+ *     };
+ */
+template<class Vector>
+struct component_layout;
+
+namespace detail {
+
+// find each component by setting it alone through its getter and looking for
+// the slot that changed in the object representation; setting it to one works
+// for normalized scalars too, which can't represent larger values
+template<class Vector, std::size_t... I>
+constexpr std::array<std::size_t, sizeof...(I)>
+probe_offsets(std::index_sequence<I...>)
+{
+    using scalar = scalar_field_t<Vector>;
+    constexpr std::size_t N = sizeof...(I);
+
+    std::array<std::size_t, N> offsets{};
+    auto const probe = [&offsets]<std::size_t i>(std::integral_constant<std::size_t, i>) {
+        Vector v{};
+        get_component<i>(v) = static_cast<scalar>(1);
+        auto const slots = std::bit_cast<std::array<scalar, N>>(v);
+        for (std::size_t slot = 0; slot < N; ++slot) {
+            if (not (slots[slot] == scalar{})) {
+                offsets[i] = slot * sizeof(scalar);
+            }
+        }
+    };
+    (probe(std::integral_constant<std::size_t, I>{}), ...);
+    return offsets;
+}
+}
+
+template<semivector Vector>
+    requires std::is_aggregate_v<Vector> and
+             std::is_trivially_copyable_v<Vector> and
+             std::is_standard_layout_v<Vector> and
+             (sizeof(Vector) == dimension_v<Vector> * sizeof(scalar_field_t<Vector>))
+
+struct component_layout<Vector> {
+    static constexpr auto offsets = detail::probe_offsets<Vector>(
+        std::make_index_sequence<dimension_v<Vector>>{});
+};
+
+/** A semivector with a known component layout, where every component lies on
+ * a multiple of the scalar size.
+ */
+template<class Vector>
+concept has_component_layout = semivector<Vector> and requires {
+    component_layout<Vector>::offsets;
+} and (sizeof(Vector) % sizeof(scalar_field_t<Vector>) == 0);
+
+template<class Vector>
+    requires has_component_layout<Vector>
+constexpr auto const & component_offsets_v = component_layout<Vector>::offsets;
+
+/** The distance between the same component of consecutive vectors, measured
+ * in scalars.
+ */
+template<class Vector>
+    requires has_component_layout<Vector>
+constexpr std::size_t component_stride_v =
+    sizeof(Vector) / sizeof(scalar_field_t<Vector>);
+
+namespace detail {
+template<class Vector>
+constexpr bool components_in_order()
+{
+    auto const & offsets = component_offsets_v<Vector>;
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        if (offsets[i] != i * sizeof(scalar_field_t<Vector>)) { return false; }
+    }
+    return true;
+}
+}
+
+/** A vector whose components are stored in order (x, y, ...) like an array of
+ * scalars, possibly followed by padding.
+ */
+template<class Vector>
+concept ordered_layout = has_component_layout<Vector> and
+                         detail::components_in_order<Vector>();
+
+/** A vector that's stored exactly like an array of its scalars. */
+template<class Vector>
+concept packed_layout = ordered_layout<Vector> and
+                        (component_stride_v<Vector> == dimension_v<Vector>);
+
+/** Two vector types whose objects have the same representation.
+ *
+ * Layout-compatible vectors have the same dimension, scalar type and size,
+ * and store each component at the same offset, so an array of one can be
+ * copied byte-for-byte into an array of the other.
+ */
+template<class A, class B>
+concept layout_compatible =
+    has_component_layout<A> and has_component_layout<B> and
+    std::same_as<scalar_field_t<A>, scalar_field_t<B>> and
+    std::is_standard_layout_v<A> and std::is_standard_layout_v<B> and
+    (sizeof(A) == sizeof(B)) and (dimension_v<A> == dimension_v<B>) and
+    (component_offsets_v<A> == component_offsets_v<B>);
+
+namespace detail {
+// an output iterator that can be written through a pointer, as a concept so
+// that the value type is only checked for contiguous iterators
+template<class Out, class Value>
+concept contiguous_output =
+    std::contiguous_iterator<Out> and
+    std::same_as<std::iter_value_t<Out>, Value>;
+
+// assign through the getters, since the constructor order of a type doesn't
+// necessarily match the order of its components
+template<class To, class From, std::size_t... I>
+constexpr To convert_vector(From const & v, std::index_sequence<I...>)
+{
+    using scalar = scalar_field_t<To>;
+    To result{};
+    ((get_component<I>(result) = static_cast<scalar>(get_component<I>(v))), ...);
+    return result;
+}
+}
+
+/** Convert a range of vectors to another vector type.
+ *
+ * Return
+ *   An iterator past the last converted vector.
+ *
+ * Parameters
+ *   from - the vectors to convert
+ *   out - iterator to the start of the output vectors
+ *
+ * Layout-compatible vectors between contiguous ranges are copied in bulk with
+ * memcpy. Otherwise each vector is converted component by component, which
+ * compiles to a vectorized shuffle or widening conversion for packed types.
+ */
+template<semivector To, ranges::input_range Range, std::weakly_incrementable Out>
+    requires semivector<ranges::range_value_t<Range>> and
+             (dimension_v<To> == dimension_v<ranges::range_value_t<Range>>) and
+             std::convertible_to<scalar_field_t<ranges::range_value_t<Range>>,
+                                 scalar_field_t<To>> and
+             std::indirectly_writable<Out, To>
+
+Out convert_range(Range && from, Out out)
+{
+    using From = ranges::range_value_t<Range>;
+
+    if constexpr (layout_compatible<From, To> and
+                  ranges::contiguous_range<Range> and
+                  ranges::sized_range<Range> and
+                  detail::contiguous_output<Out, To>) {
+        auto const count = ranges::size(from);
+        if (count == 0) { return out; }
+
+        if constexpr (std::is_trivially_copyable_v<From> and
+                      std::is_trivially_copyable_v<To>) {
+            std::memcpy(std::to_address(out), ranges::data(from),
+                        count * sizeof(To));
+        }
+        else {
+            // types like Eigen's declare their own copy constructors, so copy
+            // the underlying scalars instead of the objects
+            using scalar = scalar_field_t<To>;
+            auto const * first =
+                reinterpret_cast<scalar const *>(ranges::data(from));
+            std::copy_n(first, count * component_stride_v<To>,
+                        reinterpret_cast<scalar *>(std::to_address(out)));
+        }
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        constexpr auto indices = std::make_index_sequence<dimension_v<To>>{};
+        for (auto const & v : from) {
+            *out = detail::convert_vector<To>(v, indices);
+            ++out;
+        }
+        return out;
+    }
+}
+
+/** Convert a range of vectors to a new vector of another vector type. */
+template<semivector To, ranges::input_range Range>
+    requires semivector<ranges::range_value_t<Range>> and
+             (dimension_v<To> == dimension_v<ranges::range_value_t<Range>>) and
+             std::convertible_to<scalar_field_t<ranges::range_value_t<Range>>,
+                                 scalar_field_t<To>>
+
+std::vector<To> convert_range(Range && from)
+{
+    std::vector<To> result;
+    if constexpr (ranges::sized_range<Range>) {
+        result.resize(ranges::size(from));
+        convert_range<To>(from, result.begin());
+    }
+    else {
+        convert_range<To>(from, std::back_inserter(result));
+    }
+    return result;
+}
+
+/** A non-owning view of every Stride-th element of a contiguous array.
+ *
+ * The stride is part of the type, so loops over a strided_span compile to
+ * fixed-stride loads without any gather.
+ */
+template<class T, std::size_t Stride>
+    requires (Stride > 0)
+class strided_span : public ranges::view_interface<strided_span<T, Stride>> {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+
+    class iterator {
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::random_access_iterator_tag;
+
+        constexpr iterator() = default;
+        constexpr iterator(T * data, std::ptrdiff_t index)
+            : _data(data), _index(index)
+        {
+        }
+
+        constexpr T & operator*() const { return _data[_index * Stride]; }
+        constexpr T & operator[](difference_type n) const
+        {
+            return _data[(_index + n) * static_cast<difference_type>(Stride)];
+        }
+
+        constexpr iterator & operator++() { ++_index; return *this; }
+        constexpr iterator operator++(int) { auto it = *this; ++_index; return it; }
+        constexpr iterator & operator--() { --_index; return *this; }
+        constexpr iterator operator--(int) { auto it = *this; --_index; return it; }
+        constexpr iterator & operator+=(difference_type n) { _index += n; return *this; }
+        constexpr iterator & operator-=(difference_type n) { _index -= n; return *this; }
+
+        friend constexpr iterator operator+(iterator it, difference_type n)
+        {
+            return it += n;
+        }
+        friend constexpr iterator operator+(difference_type n, iterator it)
+        {
+            return it += n;
+        }
+        friend constexpr iterator operator-(iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+        friend constexpr difference_type operator-(iterator const & a,
+                                                   iterator const & b)
+        {
+            return a._index - b._index;
+        }
+
+        constexpr bool operator==(iterator const & other) const
+        {
+            return _index == other._index;
+        }
+        constexpr auto operator<=>(iterator const & other) const
+        {
+            return _index <=> other._index;
+        }
+    private:
+        // elements are addressed by index, so that the end iterator never
+        // points past the underlying array
+        T * _data = nullptr;
+        std::ptrdiff_t _index = 0;
+    };
+
+    constexpr strided_span() = default;
+    constexpr strided_span(T * data, std::size_t size)
+        : _data(data), _size(size)
+    {
+    }
+
+    static constexpr std::size_t stride() { return Stride; }
+
+    constexpr T * data() const { return _data; }
+    constexpr std::size_t size() const { return _size; }
+    constexpr T & operator[](std::size_t i) const { return _data[i * Stride]; }
+
+    constexpr iterator begin() const { return iterator(_data, 0); }
+    constexpr iterator end() const
+    {
+        return iterator(_data, static_cast<std::ptrdiff_t>(_size));
+    }
+private:
+    T * _data = nullptr;
+    std::size_t _size = 0;
+};
+
+/** View one component of a contiguous range of vectors without copying.
+ *
+ * Return
+ *   A strided span over the ith component of every vector in points, with the
+ *   stride of the vector's layout. The span is const if the range's elements
+ *   are const.
+ *
+ * Parameters
+ *   points - a contiguous range of vectors with a known component layout
+ *
+ * Example:
+ *     std::vector<glm::vec3> points = ...;
+ *     for (float & z : sp::component_view<2>(points)) { z = 0.f; }
+ */
+template<std::size_t i, ranges::contiguous_range Range>
+    requires ranges::sized_range<Range> and
+             has_component_layout<ranges::range_value_t<Range>> and
+             (i < dimension_v<ranges::range_value_t<Range>>)
+
+auto component_view(Range && points)
+{
+    using Vector = ranges::range_value_t<Range>;
+    using element = std::remove_reference_t<ranges::range_reference_t<Range>>;
+    using scalar = std::conditional_t<std::is_const_v<element>,
+                                      scalar_field_t<Vector> const,
+                                      scalar_field_t<Vector>>;
+    using byte = std::conditional_t<std::is_const_v<element>,
+                                    std::byte const, std::byte>;
+
+    auto * first = reinterpret_cast<byte *>(ranges::data(points)) +
+                   component_offsets_v<Vector>[i];
+    return strided_span<scalar, component_stride_v<Vector>>(
+        reinterpret_cast<scalar *>(first), ranges::size(points));
+}
+}
+
+template<class T, std::size_t Stride>
+constexpr bool std::ranges::enable_borrowed_range<sp::strided_span<T, Stride>> = true;
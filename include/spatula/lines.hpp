@@ -0,0 +1,192 @@
+#pragma once
+
+// type constraints
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+#include "spatula/grids.hpp"
+
+// data types and data structures
+#include <cstddef>
+
+// algorithms
+#include <cmath>
+
+namespace sp {
+
+/** A lazy range of the square-grid cells on a line between two points.
+ *
+ * The cells are generated with Bresenham's algorithm, starting at the first
+ * point and ending at the second (inclusive).
+ */
+template<grid_point Vector>
+class line_view : public ranges::view_interface<line_view<Vector>> {
+    using scalar = scalar_field_t<Vector>;
+public:
+    class iterator {
+    public:
+        using value_type = Vector;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        constexpr iterator() = default;
+        constexpr iterator(Vector const & from, Vector const & to)
+            : _x(get_x(from)), _y(get_y(from)),
+              _dx(get_x(to) - _x), _dy(get_y(from) - get_y(to)),
+              _sx(_dx < 0? -1 : 1), _sy(_dy > 0? -1 : 1)
+        {
+            _dx = _dx < 0? -_dx : _dx;
+            _dy = _dy > 0? -_dy : _dy;
+            _error = _dx + _dy;
+            _remaining = static_cast<std::size_t>(std::max(_dx, -_dy)) + 1;
+        }
+
+        constexpr Vector operator*() const { return Vector{_x, _y}; }
+
+        constexpr iterator & operator++()
+        {
+            scalar const e2 = 2 * _error;
+            if (e2 >= _dy) { _error += _dy; _x += _sx; }
+            if (e2 <= _dx) { _error += _dx; _y += _sy; }
+            --_remaining;
+            return *this;
+        }
+        constexpr iterator operator++(int)
+        {
+            iterator const previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        constexpr bool operator==(iterator const & other) const
+        {
+            return _remaining == other._remaining;
+        }
+        constexpr bool operator==(std::default_sentinel_t) const
+        {
+            return _remaining == 0;
+        }
+    private:
+        scalar _x{}, _y{};
+        scalar _dx{}, _dy{};
+        scalar _sx{}, _sy{};
+        scalar _error{};
+        std::size_t _remaining = 0;
+    };
+
+    constexpr line_view() = default;
+    constexpr line_view(Vector const & from, Vector const & to)
+        : _from(from), _to(to)
+    {
+    }
+
+    constexpr iterator begin() const { return iterator(_from, _to); }
+    constexpr std::default_sentinel_t end() const { return {}; }
+    constexpr std::size_t size() const
+    {
+        return static_cast<std::size_t>(chebyshev_distance(_from, _to)) + 1;
+    }
+private:
+    Vector _from{};
+    Vector _to{};
+};
+
+/** A lazy range of the hex-grid cells on a line between two axial points.
+ *
+ * Each cell is found by linearly interpolating the cube coordinates of the
+ * endpoints and rounding to the nearest hex, starting at the first point and
+ * ending at the second (inclusive).
+ */
+template<grid_point Vector>
+class hex_line_view : public ranges::view_interface<hex_line_view<Vector>> {
+    using scalar = scalar_field_t<Vector>;
+public:
+    class iterator {
+    public:
+        using value_type = Vector;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        iterator() = default;
+        iterator(Vector const & from, Vector const & to)
+            : _q0(get_x(from)), _r0(get_y(from)),
+              _dq(get_x(to) - get_x(from)), _dr(get_y(to) - get_y(from)),
+              _steps(hex_distance(from, to))
+        {
+        }
+
+        Vector operator*() const
+        {
+            if (_step == 0) { return Vector{_q0, _r0}; }
+
+            // nudge the endpoints off of hex edges so that rounding is
+            // consistent along the whole line
+            double const t = static_cast<double>(_step) / _steps;
+            double const q = _q0 + 1e-6 + _dq * t;
+            double const r = _r0 + 2e-6 + _dr * t;
+            double const s = -q - r;
+
+            double rq = std::round(q), rr = std::round(r), rs = std::round(s);
+            double const eq = std::abs(rq - q);
+            double const er = std::abs(rr - r);
+            double const es = std::abs(rs - s);
+            if (eq > er and eq > es) { rq = -rr - rs; }
+            else if (er > es) { rr = -rq - rs; }
+            return Vector{static_cast<scalar>(rq), static_cast<scalar>(rr)};
+        }
+
+        iterator & operator++() { ++_step; return *this; }
+        iterator operator++(int)
+        {
+            iterator const previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(iterator const & other) const
+        {
+            return _step == other._step;
+        }
+        bool operator==(std::default_sentinel_t) const
+        {
+            return _step > _steps;
+        }
+    private:
+        scalar _q0{}, _r0{};
+        scalar _dq{}, _dr{};
+        scalar _steps{};
+        scalar _step{};
+    };
+
+    hex_line_view() = default;
+    hex_line_view(Vector const & from, Vector const & to)
+        : _from(from), _to(to)
+    {
+    }
+
+    iterator begin() const { return iterator(_from, _to); }
+    std::default_sentinel_t end() const { return {}; }
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(hex_distance(_from, _to)) + 1;
+    }
+private:
+    Vector _from{};
+    Vector _to{};
+};
+
+/** The square-grid cells on the line from one point to another. */
+template<grid_point Vector>
+constexpr line_view<Vector> line(Vector const & from, Vector const & to)
+{
+    return line_view<Vector>(from, to);
+}
+
+/** The hex-grid cells on the line from one axial point to another. */
+template<grid_point Vector>
+hex_line_view<Vector> hex_line(Vector const & from, Vector const & to)
+{
+    return hex_line_view<Vector>(from, to);
+}
+}
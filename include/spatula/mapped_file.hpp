@@ -0,0 +1,135 @@
+#pragma once
+
+// data types and data structures
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+// algorithms
+#include <cerrno>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPATULA_HAS_MMAP 1
+#endif
+
+namespace sp {
+
+namespace detail {
+// the unit of the buffers of files read without mmap, which keeps them as
+// aligned as a mapping would be
+struct alignas(64) cache_line {
+    std::byte bytes[64];
+};
+}
+
+/** A read-only view of the contents of a file.
+ *
+ * The file is mapped into memory, so its pages are only read as they're
+ * accessed. On platforms without mmap, the file is read into a buffer aligned
+ * to 64 bytes instead.
+ *
+ * Example:
+ *     sp::mapped_file const file{"points.xyz"};
+ *     auto const points = sp::read_points<glm::vec3>(file.text());
+ */
+class mapped_file {
+public:
+    mapped_file() = default;
+
+    /** Map a file into memory.
+     *
+     * Throws std::system_error if the file can't be opened or mapped.
+     */
+    explicit mapped_file(std::filesystem::path const & path)
+    {
+#if defined(SPATULA_HAS_MMAP)
+        int const fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error{errno, std::generic_category(), path.string()};
+        }
+        struct stat status{};
+        if (::fstat(fd, &status) != 0) {
+            int const error = errno;
+            ::close(fd);
+            throw std::system_error{error, std::generic_category(), path.string()};
+        }
+        std::size_t const size = static_cast<std::size_t>(status.st_size);
+        if (size > 0) {
+            void * const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                int const error = errno;
+                ::close(fd);
+                throw std::system_error{error, std::generic_category(), path.string()};
+            }
+            _data = static_cast<std::byte const *>(mapping);
+            _size = size;
+        }
+        ::close(fd);
+#else
+        std::ifstream file{path, std::ios::binary | std::ios::ate};
+        if (not file) {
+            throw std::system_error{std::make_error_code(std::errc::io_error),
+                                    path.string()};
+        }
+        _size = static_cast<std::size_t>(file.tellg());
+        _buffer = std::make_unique_for_overwrite<detail::cache_line[]>(
+            (_size + sizeof(detail::cache_line) - 1) / sizeof(detail::cache_line));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(_buffer.get()),
+                  static_cast<std::streamsize>(_size));
+        _data = reinterpret_cast<std::byte const *>(_buffer.get());
+#endif
+    }
+
+    mapped_file(mapped_file && other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)),
+          _buffer(std::move(other._buffer))
+    {
+    }
+    mapped_file & operator=(mapped_file && other) noexcept
+    {
+        if (this != &other) {
+            unmap();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _buffer = std::move(other._buffer);
+        }
+        return *this;
+    }
+    ~mapped_file() { unmap(); }
+
+    std::byte const * data() const { return _data; }
+    std::size_t size() const { return _size; }
+    std::span<std::byte const> bytes() const { return {_data, _size}; }
+    std::string_view text() const
+    {
+        return {reinterpret_cast<char const *>(_data), _size};
+    }
+private:
+    std::byte const * _data = nullptr;
+    std::size_t _size = 0;
+    std::unique_ptr<detail::cache_line[]> _buffer;
+
+    void unmap() noexcept
+    {
+#if defined(SPATULA_HAS_MMAP)
+        if (_data and not _buffer) {
+            ::munmap(const_cast<std::byte *>(_data), _size);
+        }
+#endif
+        _buffer.reset();
+        _data = nullptr;
+        _size = 0;
+    }
+};
+}
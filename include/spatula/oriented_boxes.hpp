@@ -0,0 +1,361 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+#include "spatula/predicates.hpp"
+
+// data types and data structures
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include <cmath>
+#include "spatula/statistics.hpp"
+
+// errors
+#include <stdexcept>
+
+/** Methods of fitting oriented bounding boxes. */
+namespace sp::box_fit {
+/** Align the box with the principal axes of the points, which is fast for any
+ * amount of points in two or three dimensions but may be loose for skewed
+ * point distributions.
+ */
+struct principal {};
+/** The box of least area, found by rotating calipers around the convex hull of
+ * points in the plane.
+ */
+struct minimum_area {};
+}
+
+namespace sp {
+
+/** A method that sp::oriented_bounding_box can fit boxes with. */
+template<class Fit>
+concept box_fit_method = std::same_as<Fit, box_fit::principal> or
+                         std::same_as<Fit, box_fit::minimum_area>;
+
+/** A box that may be rotated to any orientation.
+ *
+ * The axes are unit vectors forming a right-handed frame, and the box spans
+ * half_extents[i] to either side of the center along axes[i].
+ */
+template<semivector Vector>
+struct oriented_box {
+    Vector center;
+    std::array<Vector, dimension_v<Vector>> axes;
+    Vector half_extents;
+};
+
+namespace detail {
+
+template<class Vector, std::size_t N, class Scalar>
+Vector to_vector(std::array<Scalar, N> const & x)
+{
+    using scalar = scalar_field_t<Vector>;
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return Vector{static_cast<scalar>(x[I])...};
+    }(std::make_index_sequence<N>{});
+}
+
+template<class Vector>
+bool lexicographically_less(Vector const & a, Vector const & b)
+{
+    return get_x(a) < get_x(b) or (get_x(a) == get_x(b) and get_y(a) < get_y(b));
+}
+
+// discard the points strictly inside the quadrilateral of the leftmost,
+// lowest, rightmost and highest points, which can't be on the hull, from Akl
+// and Toussaint
+template<class Vector>
+void discard_interior_points(std::vector<Vector> & points)
+{
+    auto const [left, right] = std::minmax_element(points.begin(), points.end(),
+                                                   least_x<Vector>);
+    auto const [bottom, top] = std::minmax_element(points.begin(), points.end(),
+                                                   least_y<Vector>);
+    std::array<Vector, 4> const corners{*left, *bottom, *right, *top};
+    std::erase_if(points, [&](Vector const & p) {
+        return orient2d(corners[0], corners[1], p) > 0 and
+               orient2d(corners[1], corners[2], p) > 0 and
+               orient2d(corners[2], corners[3], p) > 0 and
+               orient2d(corners[3], corners[0], p) > 0;
+    });
+}
+
+// the hull of points sorted lexicographically without duplicates, from
+// Andrew's monotone chain
+template<class Vector>
+std::vector<Vector> monotone_chain(std::vector<Vector> const & points)
+{
+    if (points.size() < 3) { return points; }
+    std::vector<Vector> hull;
+    hull.reserve(points.size() + 1);
+    auto const add = [&](Vector const & p, std::size_t floor) {
+        while (hull.size() > floor and
+               orient2d(hull[hull.size() - 2], hull.back(), p) <= 0) {
+            hull.pop_back();
+        }
+        hull.push_back(p);
+    };
+    for (auto const & p : points) { add(p, 1); }
+    std::size_t const lower = hull.size();
+    for (auto p = points.rbegin() + 1; p != points.rend(); ++p) { add(*p, lower); }
+    hull.pop_back();
+    return hull;
+}
+
+// the box of least area around a convex polygon in counterclockwise order.
+// One side of the box is flush with an edge of the polygon, so each edge is
+// tried with the extreme vertices along and across it, which only move
+// forward as the edges turn
+template<class Vector>
+oriented_box<Vector> minimum_area_box(std::vector<Vector> const & hull)
+{
+    using point = std::array<double, 2>;
+    std::size_t const h = hull.size();
+    auto const vertex = [&](std::size_t k) {
+        auto const & p = hull[k % h];
+        return point{static_cast<double>(get_x(p)), static_cast<double>(get_y(p))};
+    };
+    if (h < 3) {
+        // a point or a segment, which has no area
+        point const a = vertex(0), b = vertex(h - 1);
+        point e{b[0] - a[0], b[1] - a[1]};
+        double const length = std::hypot(e[0], e[1]);
+        e = length > 0? point{e[0] / length, e[1] / length} : point{1, 0};
+        return {to_vector<Vector>(point{(a[0] + b[0]) / 2, (a[1] + b[1]) / 2}),
+                {to_vector<Vector>(e), to_vector<Vector>(point{-e[1], e[0]})},
+                to_vector<Vector>(point{length / 2, 0})};
+    }
+
+    double best_area = std::numeric_limits<double>::infinity();
+    point best_center{}, best_axis{}, best_extents{};
+    std::size_t right = 1, top = 1, left = 1;
+    for (std::size_t i = 0; i < h; ++i) {
+        point const a = vertex(i), b = vertex(i + 1);
+        double const length = std::hypot(b[0] - a[0], b[1] - a[1]);
+        point const e{(b[0] - a[0]) / length, (b[1] - a[1]) / length};
+
+        // coordinates relative to the edge's start, along the edge and across
+        // it toward the inside of the polygon
+        auto const along = [&](std::size_t k) {
+            point const p = vertex(k);
+            return (p[0] - a[0]) * e[0] + (p[1] - a[1]) * e[1];
+        };
+        auto const across = [&](std::size_t k) {
+            point const p = vertex(k);
+            return (p[1] - a[1]) * e[0] - (p[0] - a[0]) * e[1];
+        };
+        right = std::max(right, i + 1);
+        while (right + 1 < i + h and along(right + 1) >= along(right)) { ++right; }
+        top = std::max(top, right);
+        while (top + 1 < i + h and across(top + 1) >= across(top)) { ++top; }
+        left = std::max(left, top);
+        while (left < i + h and along(left + 1) <= along(left)) { ++left; }
+
+        double const low = along(left), high = along(right), height = across(top);
+        double const area = (high - low) * height;
+        if (area < best_area) {
+            best_area = area;
+            double const middle = (low + high) / 2;
+            best_center = {a[0] + e[0] * middle - e[1] * height / 2,
+                           a[1] + e[1] * middle + e[0] * height / 2};
+            best_axis = e;
+            best_extents = {(high - low) / 2, height / 2};
+        }
+    }
+
+    // the longer side first, turning the frame a quarter to keep it right-handed
+    if (best_extents[1] > best_extents[0]) {
+        best_axis = {-best_axis[1], best_axis[0]};
+        std::swap(best_extents[0], best_extents[1]);
+    }
+    point const normal{-best_axis[1], best_axis[0]};
+    return {to_vector<Vector>(best_center),
+            {to_vector<Vector>(best_axis), to_vector<Vector>(normal)},
+            to_vector<Vector>(best_extents)};
+}
+}
+
+/** Compute the convex hull of a set of points in the plane.
+ *
+ * Return
+ *   An iterator past the last vertex of the hull.
+ *
+ * Parameters
+ *   points - the points to find the hull of
+ *   out - iterator to the start of the hull's vertices, which are written in
+ *         counterclockwise order from the lowest of the leftmost points
+ *
+ * Duplicate points and points in the middle of an edge are left out. Every
+ * orientation is decided by sp::orient2d, so the hull is exact for the given
+ * coordinates. Points that can't be on the hull are discarded before sorting,
+ * which makes dense point clouds much faster than O(n log n).
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires floating_semivector<ranges::range_value_t<Range>> and
+             (dimension_v<ranges::range_value_t<Range>> == 2) and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out convex_hull(Range && points, Out out)
+{
+    using Vector = ranges::range_value_t<Range>;
+    std::vector<Vector> candidates;
+    if constexpr (ranges::sized_range<Range>) {
+        candidates.reserve(static_cast<std::size_t>(ranges::size(points)));
+    }
+    ranges::copy(points, std::back_inserter(candidates));
+    if (candidates.size() > 8) {
+        detail::discard_interior_points(candidates);
+    }
+    ranges::sort(candidates, detail::lexicographically_less<Vector>);
+    auto const same = [](Vector const & a, Vector const & b) {
+        return get_x(a) == get_x(b) and get_y(a) == get_y(b);
+    };
+    candidates.erase(std::unique(candidates.begin(), candidates.end(), same),
+                     candidates.end());
+    return ranges::copy(detail::monotone_chain(candidates), out).out;
+}
+
+/** Compute the box aligned with a given frame that bounds a set of points.
+ *
+ * Return
+ *   The least box along the frame's axes that contains the points. In 2D the
+ *   second axis is the first turned a quarter counterclockwise, and in 3D the
+ *   third axis is the cross product of the first two, so the box's axes are a
+ *   right-handed frame.
+ *
+ * Parameters
+ *   points - the points to bound, which are read once
+ *   frame - principal components of the points, or of any set of points that
+ *           gives the orientation of the box
+ *
+ * Throws
+ *   std::domain_error if there are no points
+ *
+ * Principal components found with sp::moment_accumulator make oriented boxes
+ * of unbounded streams in a single pass over the points for the axes, and
+ * another for the box.
+ */
+template<ranges::input_range Range, std::size_t N, class Scalar>
+    requires semivector<ranges::range_value_t<Range>> and
+             (dimension_v<ranges::range_value_t<Range>> == N) and
+             (N == 2 or N == 3)
+
+auto oriented_bounding_box(Range && points, principal_components<N, Scalar> const & frame)
+{
+    using Vector = ranges::range_value_t<Range>;
+    auto axes = frame.axes;
+    if constexpr (N == 2) {
+        axes[1] = {-axes[0][1], axes[0][0]};
+    }
+    else {
+        auto const & u = axes[0];
+        auto const & v = axes[1];
+        axes[2] = {u[1] * v[2] - u[2] * v[1],
+                   u[2] * v[0] - u[0] * v[2],
+                   u[0] * v[1] - u[1] * v[0]};
+    }
+
+    std::array<Scalar, N> low, high;
+    low.fill(std::numeric_limits<Scalar>::infinity());
+    high.fill(-std::numeric_limits<Scalar>::infinity());
+    for (auto const & p : points) {
+        std::array<Scalar, N> d;
+        detail::for_components<N>([&](auto i) {
+            d[i] = static_cast<Scalar>(get_component<i>(p)) - frame.mean[i];
+        });
+        for (std::size_t i = 0; i < N; ++i) {
+            Scalar x = 0;
+            for (std::size_t j = 0; j < N; ++j) { x += axes[i][j] * d[j]; }
+            low[i] = std::min(low[i], x);
+            high[i] = std::max(high[i], x);
+        }
+    }
+    if (low[0] > high[0]) {
+        throw std::domain_error{"bounding box of an empty set of points"};
+    }
+
+    std::array<Scalar, N> center = frame.mean, half_extents;
+    for (std::size_t i = 0; i < N; ++i) {
+        Scalar const middle = (low[i] + high[i]) / 2;
+        half_extents[i] = (high[i] - low[i]) / 2;
+        for (std::size_t j = 0; j < N; ++j) { center[j] += axes[i][j] * middle; }
+    }
+    oriented_box<Vector> box{detail::to_vector<Vector>(center), {},
+                             detail::to_vector<Vector>(half_extents)};
+    for (std::size_t i = 0; i < N; ++i) {
+        box.axes[i] = detail::to_vector<Vector>(axes[i]);
+    }
+    return box;
+}
+
+/** Compute an oriented box that bounds a set of points.
+ *
+ * Return
+ *   A box containing every point. Principal boxes are aligned with the
+ *   principal axes of the points in order of decreasing variance, and minimum
+ *   area boxes list their longer axis first.
+ *
+ * Parameters
+ *   points - the points to bound
+ *   workers - the maximum amount of threads to compute principal axes with
+ *
+ * Template Parameters
+ *   Fit - one of the sp::box_fit methods. Minimum area boxes are only
+ *         defined for points in the plane
+ *
+ * Throws
+ *   std::domain_error if there are no points
+ *
+ * Example:
+ *     auto const tight = sp::oriented_bounding_box<sp::box_fit::minimum_area>(outline);
+ *     auto const quick = sp::oriented_bounding_box<sp::box_fit::principal>(cloud);
+ */
+template<box_fit_method Fit, ranges::forward_range Range>
+    requires floating_semivector<ranges::range_value_t<Range>> and
+             (dimension_v<ranges::range_value_t<Range>> == 2 or
+              (dimension_v<ranges::range_value_t<Range>> == 3 and
+               std::same_as<Fit, box_fit::principal>))
+
+auto oriented_bounding_box(Range && points, std::size_t workers = worker_count())
+{
+    using Vector = ranges::range_value_t<Range>;
+    if constexpr (std::same_as<Fit, box_fit::principal>) {
+        auto const frame = principal_axes(points, workers);
+        return oriented_bounding_box(points, frame);
+    }
+    else {
+        std::vector<Vector> hull;
+        convex_hull(points, std::back_inserter(hull));
+        if (hull.empty()) {
+            throw std::domain_error{"bounding box of an empty set of points"};
+        }
+        return detail::minimum_area_box(hull);
+    }
+}
+
+/** Compute an oriented box that bounds a set of points, with the least area
+ * for points in the plane and aligned with the principal axes in space.
+ */
+template<ranges::forward_range Range>
+    requires floating_semivector<ranges::range_value_t<Range>> and
+             (dimension_v<ranges::range_value_t<Range>> == 2 or
+              dimension_v<ranges::range_value_t<Range>> == 3)
+
+auto oriented_bounding_box(Range && points, std::size_t workers = worker_count())
+{
+    using Fit = std::conditional_t<dimension_v<ranges::range_value_t<Range>> == 2,
+                                   box_fit::minimum_area, box_fit::principal>;
+    return oriented_bounding_box<Fit>(std::forward<Range>(points), workers);
+}
+}
@@ -0,0 +1,442 @@
+#pragma once
+
+// type constraints
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/rects.hpp"
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include <numeric>
+
+namespace sp {
+
+/** A rectangle with integral components, whose placements can be packed. */
+template<class Rect>
+concept integral_rectangle = rectangle<Rect> and
+                             std::integral<rect_scalar_t<Rect>>;
+
+/** Packs rectangles into a fixed-size bin along a skyline.
+ *
+ * The skyline is the upper contour of the placed rectangles, stored as a list
+ * of horizontal segments. Each rectangle is placed at the lowest position on
+ * the skyline where it fits, breaking ties by the leftmost position
+ * ("bottom-left"). The skyline wastes the area under overhanging rectangles,
+ * but each insertion only takes time linear in the amount of segments, so
+ * it's well suited to large amounts of similarly sized rectangles like glyphs.
+ */
+template<integral_rectangle Rect>
+class skyline_packer {
+    using scalar = rect_scalar_t<Rect>;
+public:
+    skyline_packer() = default;
+    skyline_packer(scalar width, scalar height)
+        : _width(width), _height(height), _skyline{{0, 0, width}}
+    {
+    }
+
+    scalar width() const { return _width; }
+    scalar height() const { return _height; }
+
+    /** The total area of the placed rectangles. */
+    std::size_t used_area() const { return _used_area; }
+
+    /** Remove every placed rectangle. */
+    void clear()
+    {
+        _skyline.assign({{0, 0, _width}});
+        _used_area = 0;
+    }
+
+    /** Place a rectangle of a given size.
+     *
+     * Return
+     *   The placement of the rectangle, or std::nullopt if it doesn't fit.
+     */
+    std::optional<Rect> insert(scalar w, scalar h)
+    {
+        if (w <= 0 or h <= 0) { return std::nullopt; }
+
+        std::size_t best = _skyline.size();
+        scalar best_top = std::numeric_limits<scalar>::max();
+        scalar best_y = 0;
+        for (std::size_t i = 0; i < _skyline.size(); ++i) {
+            auto const y = fit(i, w, h);
+            if (not y) { continue; }
+            scalar const top = static_cast<scalar>(*y + h);
+            if (top < best_top) {
+                best = i;
+                best_top = top;
+                best_y = *y;
+            }
+        }
+        if (best == _skyline.size()) { return std::nullopt; }
+
+        scalar const x = _skyline[best].x;
+        add_segment(best, {x, best_top, w});
+        _used_area += static_cast<std::size_t>(w) * static_cast<std::size_t>(h);
+        return Rect{x, best_y, w, h};
+    }
+private:
+    struct segment { scalar x, y, width; };
+
+    scalar _width = 0;
+    scalar _height = 0;
+    std::vector<segment> _skyline;
+    std::size_t _used_area = 0;
+
+    // the lowest y that a rectangle starting at segment i can be placed at
+    std::optional<scalar> fit(std::size_t i, scalar w, scalar h) const
+    {
+        scalar const x = _skyline[i].x;
+        if (x + w > _width) { return std::nullopt; }
+        scalar y = 0;
+        scalar remaining = w;
+        for (; remaining > 0; ++i) {
+            y = std::max(y, _skyline[i].y);
+            if (y + h > _height) { return std::nullopt; }
+            remaining -= _skyline[i].width;
+        }
+        return y;
+    }
+
+    void add_segment(std::size_t i, segment const & added)
+    {
+        _skyline.insert(_skyline.begin() + static_cast<std::ptrdiff_t>(i), added);
+
+        // shrink or remove the segments covered by the new one
+        scalar const right = added.x + added.width;
+        std::size_t j = i + 1;
+        while (j < _skyline.size() and _skyline[j].x < right) {
+            scalar const end = _skyline[j].x + _skyline[j].width;
+            if (end <= right) {
+                _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(j));
+                continue;
+            }
+            _skyline[j].width = static_cast<scalar>(end - right);
+            _skyline[j].x = right;
+            break;
+        }
+
+        // merge neighboring segments of the same height
+        for (std::size_t k = 0; k + 1 < _skyline.size();) {
+            if (_skyline[k].y == _skyline[k + 1].y) {
+                _skyline[k].width += _skyline[k + 1].width;
+                _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(k + 1));
+            }
+            else {
+                ++k;
+            }
+        }
+    }
+};
+
+namespace detail {
+
+// the free rectangles of a max_rects_packer, stored densely as edge arrays for
+// linear scans and bucketed by a uniform grid over the bin for spatial queries
+template<class Scalar>
+class free_rect_index {
+public:
+    free_rect_index() = default;
+    free_rect_index(Scalar width, Scalar height)
+    {
+        // coarse cells keep large free rectangles in few buckets
+        Scalar const longest = std::max(width, height);
+        _cell = std::max<Scalar>(1, static_cast<Scalar>(longest / 16));
+        _columns = static_cast<std::size_t>((width + _cell - 1) / _cell);
+        _rows = static_cast<std::size_t>((height + _cell - 1) / _cell);
+        _buckets.resize(_columns * _rows);
+    }
+
+    rect_edges<Scalar> const & edges() const { return _edges; }
+    std::size_t size() const { return _edges.size(); }
+
+    void add(Scalar x0, Scalar y0, Scalar x1, Scalar y1)
+    {
+        auto const handle = static_cast<std::uint32_t>(_positions.size());
+        _positions.push_back(static_cast<std::uint32_t>(_edges.size()));
+        _stamps.push_back(0);
+        _handles.push_back(handle);
+        _edges.x0.push_back(x0);
+        _edges.y0.push_back(y0);
+        _edges.x1.push_back(x1);
+        _edges.y1.push_back(y1);
+        for_cells(x0, y0, x1, y1, [&](auto & bucket) { bucket.push_back(handle); });
+    }
+
+    // remove the rectangle at a dense position, moving the last one into it;
+    // buckets drop the removed handle lazily the next time they're searched
+    void remove_at(std::size_t i)
+    {
+        _positions[_handles.back()] = static_cast<std::uint32_t>(i);
+        _positions[_handles[i]] = removed;
+        _handles[i] = _handles.back();
+        _handles.pop_back();
+        _edges.erase(i);
+    }
+
+    // the dense positions of the rectangles that overlap [x0, x1) × [y0, y1)
+    void overlapping(Scalar x0, Scalar y0, Scalar x1, Scalar y1,
+                     std::vector<std::size_t> & found)
+    {
+        found.clear();
+        ++_stamp;
+        for_cells(x0, y0, x1, y1, [&](auto & bucket) {
+            prune(bucket);
+            for (std::uint32_t const handle : bucket) {
+                if (_stamps[handle] == _stamp) { continue; }
+                _stamps[handle] = _stamp;
+                std::size_t const i = _positions[handle];
+                if (_edges.x0[i] < x1 and x0 < _edges.x1[i] and
+                    _edges.y0[i] < y1 and y0 < _edges.y1[i]) {
+                    found.push_back(i);
+                }
+            }
+        });
+    }
+
+    // whether any rectangle contains [x0, x1) × [y0, y1); such a rectangle
+    // must cover the corner (x0, y0), so only one bucket is searched
+    bool contains(Scalar x0, Scalar y0, Scalar x1, Scalar y1)
+    {
+        auto & bucket = _buckets[static_cast<std::size_t>(y0 / _cell) * _columns +
+                                 static_cast<std::size_t>(x0 / _cell)];
+        prune(bucket);
+        return std::ranges::any_of(bucket, [&](std::uint32_t handle) {
+            std::size_t const i = _positions[handle];
+            return _edges.x0[i] <= x0 and _edges.y0[i] <= y0 and
+                   _edges.x1[i] >= x1 and _edges.y1[i] >= y1;
+        });
+    }
+private:
+    static constexpr auto removed = std::numeric_limits<std::uint32_t>::max();
+
+    rect_edges<Scalar> _edges;
+    std::vector<std::uint32_t> _handles;
+    std::vector<std::uint32_t> _positions;
+    std::vector<std::uint32_t> _stamps;
+    std::uint32_t _stamp = 0;
+
+    Scalar _cell = 1;
+    std::size_t _columns = 0, _rows = 0;
+    std::vector<std::vector<std::uint32_t>> _buckets;
+
+    void prune(std::vector<std::uint32_t> & bucket) const
+    {
+        std::erase_if(bucket, [this](std::uint32_t handle) {
+            return _positions[handle] == removed;
+        });
+    }
+
+    template<class Visit>
+    void for_cells(Scalar x0, Scalar y0, Scalar x1, Scalar y1, Visit && visit)
+    {
+        for (Scalar y = static_cast<Scalar>(y0 / _cell); y <= (y1 - 1) / _cell; ++y) {
+        for (Scalar x = static_cast<Scalar>(x0 / _cell); x <= (x1 - 1) / _cell; ++x) {
+            visit(_buckets[static_cast<std::size_t>(y) * _columns +
+                           static_cast<std::size_t>(x)]);
+        }}
+    }
+};
+}
+
+/** Packs rectangles into a fixed-size bin by tracking its maximal free
+ * rectangles.
+ *
+ * The free space is kept as the list of every maximal empty rectangle, which
+ * may overlap each other. Each rectangle is placed in the free rectangle that
+ * leaves the shortest leftover side ("best short side fit"), and the free
+ * rectangles it overlaps are split around it. Only the newly split rectangles
+ * are pruned for containment, since the remaining ones were already maximal.
+ *
+ * The free rectangles are bucketed by a uniform grid over the bin, so that
+ * splitting and pruning only visit the free rectangles near a placement.
+ * MaxRects packs tighter than a skyline at a higher cost per insertion.
+ */
+template<integral_rectangle Rect>
+class max_rects_packer {
+    using scalar = rect_scalar_t<Rect>;
+public:
+    max_rects_packer() = default;
+    max_rects_packer(scalar width, scalar height)
+        : _width(width), _height(height)
+    {
+        clear();
+    }
+
+    scalar width() const { return _width; }
+    scalar height() const { return _height; }
+
+    /** The total area of the placed rectangles. */
+    std::size_t used_area() const { return _used_area; }
+
+    /** The maximal free rectangles of the bin. */
+    std::vector<Rect> free_rects() const
+    {
+        auto const & edges = _free.edges();
+        std::vector<Rect> rects;
+        rects.reserve(edges.size());
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            rects.push_back(Rect{edges.x0[i], edges.y0[i],
+                                 static_cast<scalar>(edges.x1[i] - edges.x0[i]),
+                                 static_cast<scalar>(edges.y1[i] - edges.y0[i])});
+        }
+        return rects;
+    }
+
+    /** Remove every placed rectangle. */
+    void clear()
+    {
+        _free = detail::free_rect_index<scalar>(_width, _height);
+        if (_width > 0 and _height > 0) { _free.add(0, 0, _width, _height); }
+        _used_area = 0;
+    }
+
+    /** Place a rectangle of a given size.
+     *
+     * Return
+     *   The placement of the rectangle, or std::nullopt if it doesn't fit.
+     */
+    std::optional<Rect> insert(scalar w, scalar h)
+    {
+        if (w <= 0 or h <= 0) { return std::nullopt; }
+
+        // score each free rectangle by its shorter then longer leftover side
+        constexpr auto no_fit = std::numeric_limits<std::uint64_t>::max();
+        auto const & edges = _free.edges();
+        std::size_t best = 0;
+        std::uint64_t best_score = no_fit;
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            auto const dw = static_cast<std::int64_t>(edges.x1[i] - edges.x0[i]) - w;
+            auto const dh = static_cast<std::int64_t>(edges.y1[i] - edges.y0[i]) - h;
+            if (dw < 0 or dh < 0) { continue; }
+            std::uint64_t const score =
+                static_cast<std::uint64_t>(std::min(dw, dh)) << 32 |
+                static_cast<std::uint64_t>(std::max(dw, dh));
+            if (score < best_score) {
+                best = i;
+                best_score = score;
+            }
+        }
+        if (best_score == no_fit) { return std::nullopt; }
+
+        Rect const placed{edges.x0[best], edges.y0[best], w, h};
+        split(placed);
+        _used_area += static_cast<std::size_t>(w) * static_cast<std::size_t>(h);
+        return placed;
+    }
+private:
+    scalar _width = 0;
+    scalar _height = 0;
+    detail::free_rect_index<scalar> _free;
+    std::vector<std::size_t> _overlapping;
+    std::vector<std::array<scalar, 4>> _split;
+    std::size_t _used_area = 0;
+
+    // replace the free rectangles that overlap placed with their maximal
+    // leftovers on each side of it
+    void split(Rect const & placed)
+    {
+        scalar const px0 = placed.x, py0 = placed.y;
+        scalar const px1 = placed.x + placed.w, py1 = placed.y + placed.h;
+        _free.overlapping(px0, py0, px1, py1, _overlapping);
+
+        // remove from the back, so that the remaining positions stay valid
+        std::ranges::sort(_overlapping, std::greater{});
+        _split.clear();
+        auto const & edges = _free.edges();
+        for (std::size_t const i : _overlapping) {
+            scalar const x0 = edges.x0[i], y0 = edges.y0[i];
+            scalar const x1 = edges.x1[i], y1 = edges.y1[i];
+            if (px0 > x0) { _split.push_back({x0, y0, px0, y1}); }
+            if (px1 < x1) { _split.push_back({px1, y0, x1, y1}); }
+            if (py0 > y0) { _split.push_back({x0, y0, x1, py0}); }
+            if (py1 < y1) { _split.push_back({x0, py1, x1, y1}); }
+            _free.remove_at(i);
+        }
+
+        // a split rectangle is a part of a removed free rectangle, so it can't
+        // contain any of the remaining ones, which were already maximal
+        for (std::size_t i = 0; i < _split.size(); ++i) {
+            auto const & [x0, y0, x1, y1] = _split[i];
+            bool const redundant = _free.contains(x0, y0, x1, y1) or
+                std::any_of(_split.begin() + static_cast<std::ptrdiff_t>(i + 1),
+                            _split.end(), [&](auto const & other) {
+                    return other[0] <= x0 and other[1] <= y0 and
+                           other[2] >= x1 and other[3] >= y1;
+                });
+            if (not redundant) { _free.add(x0, y0, x1, y1); }
+        }
+    }
+};
+
+/** Pack a batch of rectangles into a bin.
+ *
+ * Return
+ *   The amount of rectangles that were placed.
+ *
+ * Parameters
+ *   packer - the bin to pack into, which may already contain rectangles
+ *   sizes - rectangles whose width and height give the sizes to place
+ *   out - iterator to the start of the placements, in the same order as sizes;
+ *         rectangles that don't fit are given zero width and height
+ *
+ * The rectangles are inserted in order of decreasing longest side, which packs
+ * considerably tighter than their given order. Rectangles added later on, such
+ * as glyphs rendered at runtime, can be inserted into the same packer
+ * one at a time without repacking.
+ *
+ * Example:
+ *     sp::max_rects_packer<SDL_Rect> atlas(1024, 1024);
+ *     std::vector<SDL_Rect> placements(glyphs.size());
+ *     sp::pack_rects(atlas, glyphs, placements.begin());
+ *     auto const extra = atlas.insert(12, 16);
+ */
+template<class Packer, ranges::random_access_range Range,
+         std::random_access_iterator Out>
+    requires ranges::sized_range<Range> and
+             integral_rectangle<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>> and
+             requires(Packer & packer, ranges::range_value_t<Range> r) {
+                 { *packer.insert(r.w, r.h) } ->
+                     std::convertible_to<ranges::range_value_t<Range>>;
+             }
+
+std::size_t pack_rects(Packer & packer, Range && sizes, Out out)
+{
+    using Rect = ranges::range_value_t<Range>;
+    auto const count = static_cast<std::size_t>(ranges::size(sizes));
+    auto const first = ranges::begin(sizes);
+
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::ranges::stable_sort(order, [&](std::size_t a, std::size_t b) {
+        Rect const & ra = first[static_cast<std::ptrdiff_t>(a)];
+        Rect const & rb = first[static_cast<std::ptrdiff_t>(b)];
+        auto const long_a = std::max(ra.w, ra.h), long_b = std::max(rb.w, rb.h);
+        if (long_a != long_b) { return long_a > long_b; }
+        return std::min(ra.w, ra.h) > std::min(rb.w, rb.h);
+    });
+
+    std::size_t placed = 0;
+    for (std::size_t i : order) {
+        Rect const & size = first[static_cast<std::ptrdiff_t>(i)];
+        auto const result = packer.insert(size.w, size.h);
+        out[static_cast<std::iter_difference_t<Out>>(i)] = result? Rect(*result) : Rect{};
+        placed += result.has_value();
+    }
+    return placed;
+}
+}
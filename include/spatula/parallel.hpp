@@ -0,0 +1,52 @@
+#pragma once
+
+// type constraints
+#include <concepts>
+
+// data types and data structures
+#include <cstddef>
+#include <vector>
+#include <thread>
+
+// algorithms
+#include <algorithm>
+
+namespace sp {
+
+/** The amount of worker threads spatula uses for parallel algorithms. */
+inline std::size_t worker_count()
+{
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/** Split [0, count) into contiguous chunks and process them in parallel.
+ *
+ * Parameters
+ *   count - the amount of work items to process
+ *   task - callable as task(worker, begin, end), where worker is the index of
+ *          the chunk in [0, workers) and [begin, end) are the items it owns
+ *   workers - the maximum amount of chunks to split the work into
+ *
+ * Chunks are assigned in order, so a task may use its worker index to address
+ * per-worker scratch data. The last chunk runs on the calling thread.
+ */
+template<std::invocable<std::size_t, std::size_t, std::size_t> Task>
+void parallel_for(std::size_t count, Task && task,
+                  std::size_t workers = worker_count())
+{
+    workers = std::clamp<std::size_t>(workers, 1, std::max<std::size_t>(count, 1));
+    if (workers == 1) {
+        task(std::size_t{0}, std::size_t{0}, count);
+        return;
+    }
+
+    std::vector<std::jthread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t i = 0; i + 1 < workers; ++i) {
+        threads.emplace_back([&task, i, count, workers] {
+            task(i, i * count / workers, (i + 1) * count / workers);
+        });
+    }
+    task(workers - 1, (workers - 1) * count / workers, count);
+}
+}
@@ -0,0 +1,553 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <bit>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+namespace sp {
+
+/** How to encode a stream of points. */
+struct point_encoding {
+    /** The spacing of the grid that coordinates are rounded to. */
+    double step = 1.0 / 1024.0;
+
+    /** Whether to reorder the points along a Morton curve, which makes
+     * consecutive points closer and their deltas smaller. Decoded points are
+     * in the encoded order either way.
+     */
+    bool morton_order = true;
+
+    /** The amount of points in each independently sized block. */
+    std::uint32_t block_size = 1 << 14;
+};
+
+/** The header at the start of an encoded point stream.
+ *
+ * Like point files, the header is stored in the byte order of the machine that
+ * wrote it, which it records so that other machines can reject it. Component
+ * i of a point is decoded as origin[i] + q * step[i], where q is an unsigned
+ * 32-bit grid coordinate.
+ */
+struct point_stream_header {
+    static constexpr std::array<char, 8> signature{'s', 'p', 's', 't',
+                                                   'r', 'e', 'a', 'm'};
+    static constexpr std::uint16_t current_version = 1;
+
+    std::array<char, 8> magic = signature;
+    std::uint16_t version = current_version;
+    std::uint8_t little_endian = std::endian::native == std::endian::little;
+    std::uint8_t dimension = 0;
+    std::uint32_t block_size = 0;
+    std::uint64_t count = 0;
+    std::array<double, 4> origin{};
+    std::array<double, 4> step{};
+};
+static_assert(sizeof(point_stream_header) == 88 and
+              std::is_trivially_copyable_v<point_stream_header>);
+
+namespace detail {
+
+// spread the low 64/N bits of a coordinate N - 1 bits apart
+template<std::size_t N>
+constexpr std::uint64_t spread_bits(std::uint32_t value)
+{
+    std::uint64_t x = value;
+    if constexpr (N == 2) {
+        x = (x | x << 16) & 0x0000ffff0000ffffull;
+        x = (x | x << 8) & 0x00ff00ff00ff00ffull;
+        x = (x | x << 4) & 0x0f0f0f0f0f0f0f0full;
+        x = (x | x << 2) & 0x3333333333333333ull;
+        x = (x | x << 1) & 0x5555555555555555ull;
+    }
+    else if constexpr (N == 3) {
+        x &= 0x1fffff;
+        x = (x | x << 32) & 0x001f00000000ffffull;
+        x = (x | x << 16) & 0x001f0000ff0000ffull;
+        x = (x | x << 8) & 0x100f00f00f00f00full;
+        x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+        x = (x | x << 2) & 0x1249249249249249ull;
+    }
+    else {
+        std::uint64_t spread = 0;
+        for (std::size_t b = 0; b < 64 / N; ++b) {
+            spread |= ((x >> b) & 1u) << (b * N);
+        }
+        x = spread;
+    }
+    return x;
+}
+
+// interleave the bits of N coordinates of up to 64/N bits each
+template<std::size_t N>
+constexpr std::uint64_t morton_key(std::array<std::uint32_t, N> const & q)
+{
+    std::uint64_t key = 0;
+    for (std::size_t i = 0; i < N; ++i) { key |= spread_bits<N>(q[i]) << i; }
+    return key;
+}
+
+constexpr std::uint32_t zigzag(std::uint32_t delta)
+{
+    return (delta << 1) ^ (0u - (delta >> 31));
+}
+
+constexpr std::uint32_t unzigzag(std::uint32_t z)
+{
+    return (z >> 1) ^ (0u - (z & 1u));
+}
+
+// the amount of data bytes of each Stream VByte control byte
+constexpr std::array<std::uint8_t, 256> vbyte_lengths = [] {
+    std::array<std::uint8_t, 256> lengths{};
+    for (unsigned c = 0; c < 256; ++c) {
+        for (unsigned k = 0; k < 4; ++k) {
+            unsigned const length = ((c >> (2 * k)) & 3u) + 1;
+            lengths[c] = static_cast<std::uint8_t>(lengths[c] + length);
+        }
+    }
+    return lengths;
+}();
+
+// append four values to a Stream VByte stream, returning their control byte
+inline std::uint8_t encode_vbyte4(std::uint32_t const * values,
+                                  std::vector<std::byte> & data)
+{
+    std::uint8_t control = 0;
+    for (unsigned k = 0; k < 4; ++k) {
+        std::uint32_t const v = values[k];
+        unsigned const length = v < (1u << 8)? 1 : v < (1u << 16)? 2 :
+                                v < (1u << 24)? 3 : 4;
+        control = static_cast<std::uint8_t>(control | (length - 1) << (2 * k));
+        for (unsigned b = 0; b < length; ++b) {
+            data.push_back(static_cast<std::byte>(v >> (8 * b)));
+        }
+    }
+    return control;
+}
+
+#if defined(__SSSE3__)
+// the byte shuffle that spreads the data of each control byte into four words
+inline std::array<std::array<std::int8_t, 16>, 256> const & vbyte_shuffles()
+{
+    static constexpr auto shuffles = [] {
+        std::array<std::array<std::int8_t, 16>, 256> table{};
+        for (unsigned c = 0; c < 256; ++c) {
+            std::int8_t source = 0;
+            for (unsigned k = 0; k < 4; ++k) {
+                unsigned const length = ((c >> (2 * k)) & 3u) + 1;
+                for (unsigned b = 0; b < 4; ++b) {
+                    table[c][4 * k + b] = b < length? source++ : -1;
+                }
+            }
+        }
+        return table;
+    }();
+    return shuffles;
+}
+#endif
+
+// decode four values from a Stream VByte stream, advancing its data pointer;
+// the SIMD path reads 16 bytes, so it's only taken away from the end
+inline void decode_vbyte4(std::uint8_t control, std::byte const *& data,
+                          std::byte const * last, std::uint32_t * values)
+{
+#if defined(__SSSE3__)
+    if (last - data >= 16) {
+        __m128i const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data));
+        __m128i const shuffle = _mm_loadu_si128(
+            reinterpret_cast<__m128i const *>(vbyte_shuffles()[control].data()));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(values),
+                         _mm_shuffle_epi8(bytes, shuffle));
+        data += vbyte_lengths[control];
+        return;
+    }
+#endif
+    (void)last;
+    for (unsigned k = 0; k < 4; ++k) {
+        unsigned const length = ((control >> (2 * k)) & 3u) + 1;
+        std::uint32_t v = 0;
+        for (unsigned b = 0; b < length; ++b) {
+            v |= std::to_integer<std::uint32_t>(data[b]) << (8 * b);
+        }
+        values[k] = v;
+        data += length;
+    }
+}
+
+template<class T>
+void append_bytes(std::vector<std::byte> & out, T const & value)
+{
+    auto const * bytes = reinterpret_cast<std::byte const *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+}
+
+/** Encode a range of points into a compressed stream.
+ *
+ * Return
+ *   The encoded stream, which decode_points or a point_decoder can read.
+ *
+ * Parameters
+ *   points - the points to encode
+ *   encoding - the quantization grid and ordering of the stream
+ *
+ * Coordinates are rounded to a grid with the given step over the bounding box
+ * of the points, optionally reordered along a Morton curve, and then stored as
+ * zigzagged deltas between consecutive points with Stream VByte, which uses
+ * one to four bytes per delta.
+ *
+ * Throws std::invalid_argument if a coordinate isn't finite, or if the step
+ * isn't positive or is too fine to index the bounding box with 32-bit grid
+ * coordinates.
+ *
+ * Example:
+ *     auto const bytes = sp::encode_points(scan, {.step = 0.001});
+ *     socket.send(bytes);
+ */
+template<ranges::input_range Range>
+    requires semivector<ranges::range_value_t<Range>> and
+             std::is_arithmetic_v<scalar_field_t<ranges::range_value_t<Range>>>
+
+std::vector<std::byte> encode_points(Range && points,
+                                     point_encoding const & encoding = {})
+{
+    using Vector = ranges::range_value_t<Range>;
+    constexpr std::size_t N = dimension_v<Vector>;
+    if (not (encoding.step > 0.0) or encoding.block_size == 0 or
+            encoding.block_size % 4 != 0) {
+        throw std::invalid_argument{"invalid point encoding"};
+    }
+
+    // read the points once, finding their bounds along the way
+    std::vector<std::array<double, N>> values;
+    if constexpr (ranges::sized_range<Range>) {
+        values.reserve(static_cast<std::size_t>(ranges::size(points)));
+    }
+    std::array<double, N> lower, upper;
+    lower.fill(std::numeric_limits<double>::infinity());
+    upper.fill(-std::numeric_limits<double>::infinity());
+    for (auto const & point : points) {
+        auto & v = values.emplace_back();
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((v[I] = static_cast<double>(get_component<I>(point))), ...);
+        }(std::make_index_sequence<N>{});
+        for (std::size_t i = 0; i < N; ++i) {
+            if (not std::isfinite(v[i])) {
+                throw std::invalid_argument{"point coordinates must be finite"};
+            }
+            lower[i] = std::min(lower[i], v[i]);
+            upper[i] = std::max(upper[i], v[i]);
+        }
+    }
+
+    point_stream_header header;
+    header.dimension = static_cast<std::uint8_t>(N);
+    header.block_size = encoding.block_size;
+    header.count = values.size();
+    for (std::size_t i = 0; i < N; ++i) {
+        header.origin[i] = values.empty()? 0.0 : lower[i];
+        header.step[i] = encoding.step;
+        if (not values.empty() and not ((upper[i] - lower[i]) / encoding.step <
+                                        std::numeric_limits<std::uint32_t>::max())) {
+            throw std::invalid_argument{"point encoding step is too fine"};
+        }
+    }
+
+    std::vector<std::array<std::uint32_t, N>> grid(values.size());
+    std::uint32_t highest = 0;
+    for (std::size_t p = 0; p < values.size(); ++p) {
+        for (std::size_t i = 0; i < N; ++i) {
+            grid[p][i] = static_cast<std::uint32_t>(
+                std::llround((values[p][i] - header.origin[i]) / encoding.step));
+            highest = std::max(highest, grid[p][i]);
+        }
+    }
+    values = {};
+
+    if (encoding.morton_order) {
+        // interleave the most significant bits that fit in the key, which is
+        // enough to order the points for compression
+        int const bits = static_cast<int>(std::bit_width(highest));
+        int const key_bits = static_cast<int>(64 / N);
+        int const shift = std::max(0, bits - key_bits);
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> keys(grid.size());
+        for (std::size_t p = 0; p < grid.size(); ++p) {
+            auto q = grid[p];
+            for (auto & c : q) { c >>= shift; }
+            keys[p] = {detail::morton_key<N>(q), static_cast<std::uint32_t>(p)};
+        }
+        std::ranges::sort(keys);
+        std::vector<std::array<std::uint32_t, N>> sorted(grid.size());
+        for (std::size_t p = 0; p < keys.size(); ++p) {
+            sorted[p] = grid[keys[p].second];
+        }
+        grid = std::move(sorted);
+    }
+
+    std::vector<std::byte> out;
+    out.reserve(sizeof(header) + grid.size() * N * 2);
+    detail::append_bytes(out, header);
+
+    // each block stores, per component, its control bytes and then its data,
+    // so that the decoder reads one group of four points from each component
+    std::array<std::uint32_t, N> previous{};
+    std::vector<std::uint32_t> deltas;
+    std::vector<std::byte> data;
+    for (std::size_t first = 0; first < grid.size(); first += encoding.block_size) {
+        std::size_t const count = std::min<std::size_t>(encoding.block_size,
+                                                        grid.size() - first);
+        detail::append_bytes(out, static_cast<std::uint32_t>(count));
+        std::array<std::uint32_t, N> const block_start = previous;
+        for (std::size_t i = 0; i < N; ++i) {
+            // the deltas are padded with zeros to whole groups
+            deltas.assign((count + 3) / 4 * 4, 0);
+            std::uint32_t last = block_start[i];
+            for (std::size_t p = 0; p < count; ++p) {
+                std::uint32_t const q = grid[first + p][i];
+                deltas[p] = detail::zigzag(q - last);
+                last = q;
+            }
+            previous[i] = last;
+
+            data.clear();
+            std::vector<std::uint8_t> controls(deltas.size() / 4);
+            for (std::size_t g = 0; g < controls.size(); ++g) {
+                controls[g] = detail::encode_vbyte4(deltas.data() + 4 * g, data);
+            }
+            detail::append_bytes(out, static_cast<std::uint32_t>(data.size()));
+            auto const * control_bytes =
+                reinterpret_cast<std::byte const *>(controls.data());
+            out.insert(out.end(), control_bytes, control_bytes + controls.size());
+            out.insert(out.end(), data.begin(), data.end());
+        }
+    }
+    return out;
+}
+
+/** Decodes an encoded point stream incrementally.
+ *
+ * The decoder reads from the encoded bytes without copying them, and decodes
+ * as many points as are asked for at a time, so a stream can be decoded into
+ * a fixed-size buffer as it's consumed.
+ *
+ * Example:
+ *     sp::point_decoder<glm::vec3> decoder{bytes};
+ *     std::array<glm::vec3, 1024> batch;
+ *     while (std::size_t n = decoder.decode(batch)) { upload(batch.data(), n); }
+ */
+template<semivector Vector>
+    requires std::is_arithmetic_v<scalar_field_t<Vector>>
+class point_decoder {
+public:
+    static constexpr std::size_t N = dimension_v<Vector>;
+
+    /** Start decoding an encoded stream.
+     *
+     * Throws std::runtime_error if the stream doesn't start with a valid header
+     * for points of the same dimension as Vector, or is too short to hold the
+     * amount of points in its header.
+     */
+    explicit point_decoder(std::span<std::byte const> encoded)
+        : _next(encoded.data()), _last(encoded.data() + encoded.size())
+    {
+        if (encoded.size() < sizeof(point_stream_header)) {
+            throw std::runtime_error{"point stream is too small"};
+        }
+        std::memcpy(&_header, _next, sizeof(_header));
+        _next += sizeof(_header);
+        if (_header.magic != point_stream_header::signature or
+                _header.version > point_stream_header::current_version or
+                (_header.little_endian != 0) !=
+                    (std::endian::native == std::endian::little)) {
+            throw std::runtime_error{"not a point stream for this machine"};
+        }
+        if (_header.dimension != N) {
+            throw std::runtime_error{"point stream has a different dimension"};
+        }
+        // every point takes at least a byte per component, so a count the
+        // bytes can't hold is caught before anyone allocates for it
+        if (_header.count > static_cast<std::size_t>(_last - _next) / N) {
+            throw std::runtime_error{"point stream is truncated"};
+        }
+    }
+
+    point_stream_header const & header() const { return _header; }
+
+    /** The amount of points in the stream. */
+    std::size_t size() const { return _header.count; }
+
+    /** The amount of points left to decode. */
+    std::size_t remaining() const { return _header.count - _decoded; }
+
+    /** Decode the next points of the stream.
+     *
+     * Return
+     *   The amount of points that were decoded, which is less than the size of
+     *   out only at the end of the stream.
+     *
+     * Throws std::runtime_error if the stream is truncated or corrupt.
+     */
+    std::size_t decode(std::span<Vector> out)
+    {
+        std::size_t written = 0;
+        while (written < out.size() and _decoded < _header.count) {
+            if (_pending_size > 0) {
+                // points decoded in a group that didn't fit in the last buffer
+                std::size_t const n = std::min(_pending_size, out.size() - written);
+                auto const first = static_cast<std::ptrdiff_t>(4 - _pending_size);
+                std::copy_n(_pending.begin() + first, n,
+                            out.begin() + static_cast<std::ptrdiff_t>(written));
+                _pending_size -= n;
+                written += n;
+                _decoded += n;
+                continue;
+            }
+            if (_block_left == 0) { start_block(); }
+
+            std::size_t const in_group = std::min<std::size_t>(4, _block_left);
+            if (out.size() - written >= 4 and in_group == 4) {
+                decode_group(out.data() + written);
+                written += 4;
+                _decoded += 4;
+            }
+            else {
+                decode_group(_pending.data());
+                _pending_size = in_group;
+                // move the group to the back, where pending points are read
+                auto const group_end =
+                    _pending.begin() + static_cast<std::ptrdiff_t>(in_group);
+                std::copy_backward(_pending.begin(), group_end, _pending.end());
+            }
+            _block_left -= in_group;
+        }
+        return written;
+    }
+private:
+    struct component_cursor {
+        std::uint8_t const * control;
+        std::byte const * data;
+        std::byte const * data_end;
+    };
+
+    point_stream_header _header{};
+    std::byte const * _next;
+    std::byte const * _last;
+    std::size_t _decoded = 0;
+    std::size_t _block_left = 0;
+    std::array<component_cursor, N> _cursors{};
+    std::array<std::uint32_t, N> _previous{};
+    std::array<Vector, 4> _pending{};
+    std::size_t _pending_size = 0;
+
+    template<class T>
+    T read()
+    {
+        if (static_cast<std::size_t>(_last - _next) < sizeof(T)) {
+            throw std::runtime_error{"point stream is truncated"};
+        }
+        T value;
+        std::memcpy(&value, _next, sizeof(T));
+        _next += sizeof(T);
+        return value;
+    }
+
+    void start_block()
+    {
+        auto const count = read<std::uint32_t>();
+        if (count == 0 or count > remaining() or count > _header.block_size) {
+            throw std::runtime_error{"point stream is corrupt"};
+        }
+        _block_left = count;
+        std::size_t const groups = (count + 3) / 4;
+        for (auto & cursor : _cursors) {
+            auto const data_size = read<std::uint32_t>();
+            std::size_t const left = static_cast<std::size_t>(_last - _next);
+            if (groups > left or data_size > left - groups or
+                    data_size > groups * 16 or data_size < groups * 4) {
+                throw std::runtime_error{"point stream is truncated"};
+            }
+            cursor.control = reinterpret_cast<std::uint8_t const *>(_next);
+            cursor.data = _next + groups;
+            cursor.data_end = cursor.data + data_size;
+            _next = cursor.data_end;
+        }
+    }
+
+    // decode the next four points of the block, including any padding
+    void decode_group(Vector * out)
+    {
+        using scalar = scalar_field_t<Vector>;
+        std::array<std::array<std::uint32_t, 4>, N> q;
+        for (std::size_t i = 0; i < N; ++i) {
+            auto & cursor = _cursors[i];
+            std::uint8_t const control = *cursor.control++;
+            if (detail::vbyte_lengths[control] > cursor.data_end - cursor.data) {
+                throw std::runtime_error{"point stream is corrupt"};
+            }
+            detail::decode_vbyte4(control, cursor.data, cursor.data_end, q[i].data());
+            std::uint32_t last = _previous[i];
+            // padding deltas are zero, so the last point of a group is the last
+            for (auto & value : q[i]) { value = last += detail::unzigzag(value); }
+            _previous[i] = last;
+        }
+        for (std::size_t p = 0; p < 4; ++p) {
+            Vector v{};
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((get_component<I>(v) = to_scalar<scalar>(
+                    _header.origin[I] + q[I][p] * _header.step[I])), ...);
+            }(std::make_index_sequence<N>{});
+            out[p] = v;
+        }
+    }
+
+    template<class Scalar>
+    static Scalar to_scalar(double value)
+    {
+        if constexpr (std::integral<Scalar>) {
+            return static_cast<Scalar>(std::llround(value));
+        }
+        else {
+            return static_cast<Scalar>(value);
+        }
+    }
+};
+
+/** Decode a whole encoded point stream.
+ *
+ * Throws std::runtime_error if the stream isn't a valid stream of points of
+ * the same dimension as Vector.
+ */
+template<semivector Vector>
+    requires std::is_arithmetic_v<scalar_field_t<Vector>>
+
+std::vector<Vector> decode_points(std::span<std::byte const> encoded)
+{
+    point_decoder<Vector> decoder{encoded};
+    std::vector<Vector> points(decoder.size());
+    decoder.decode(points);
+    return points;
+}
+}
@@ -0,0 +1,460 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+#include "spatula/layouts.hpp"
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "spatula/mapped_file.hpp"
+
+// algorithms
+#include <algorithm>
+#include <cstring>
+
+namespace sp {
+
+/** The scalar types that point files can store. */
+enum class point_scalar : std::uint8_t {
+    int8, uint8, int16, uint16, int32, uint32, int64, uint64, float32, float64
+};
+
+/** How the components of the points in a point file are arranged.
+ *
+ * Array-of-structures files store each point's components together, like an
+ * array of packed vectors. Structure-of-arrays files store one array per
+ * component, each aligned to 64 bytes.
+ */
+enum class point_layout : std::uint8_t { aos, soa };
+
+namespace detail {
+template<class Scalar> struct point_scalar_of;
+template<> struct point_scalar_of<std::int8_t> { static constexpr auto value = point_scalar::int8; };
+template<> struct point_scalar_of<std::uint8_t> { static constexpr auto value = point_scalar::uint8; };
+template<> struct point_scalar_of<std::int16_t> { static constexpr auto value = point_scalar::int16; };
+template<> struct point_scalar_of<std::uint16_t> { static constexpr auto value = point_scalar::uint16; };
+template<> struct point_scalar_of<std::int32_t> { static constexpr auto value = point_scalar::int32; };
+template<> struct point_scalar_of<std::uint32_t> { static constexpr auto value = point_scalar::uint32; };
+template<> struct point_scalar_of<std::int64_t> { static constexpr auto value = point_scalar::int64; };
+template<> struct point_scalar_of<std::uint64_t> { static constexpr auto value = point_scalar::uint64; };
+template<> struct point_scalar_of<float> { static constexpr auto value = point_scalar::float32; };
+template<> struct point_scalar_of<double> { static constexpr auto value = point_scalar::float64; };
+
+constexpr std::size_t point_scalar_size(point_scalar scalar)
+{
+    switch (scalar) {
+    case point_scalar::int8: case point_scalar::uint8: return 1;
+    case point_scalar::int16: case point_scalar::uint16: return 2;
+    case point_scalar::int32: case point_scalar::uint32: case point_scalar::float32: return 4;
+    case point_scalar::int64: case point_scalar::uint64: case point_scalar::float64: return 8;
+    }
+    return 0;
+}
+
+constexpr std::uint64_t align_up(std::uint64_t n, std::uint64_t alignment)
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+}
+
+/** A scalar type that can be stored in a point file. */
+template<class Scalar>
+concept point_file_scalar = requires {
+    detail::point_scalar_of<std::remove_cv_t<Scalar>>::value;
+};
+
+/** The tag of a scalar type in point file headers. */
+template<point_file_scalar Scalar>
+constexpr point_scalar point_scalar_v =
+    detail::point_scalar_of<std::remove_cv_t<Scalar>>::value;
+
+/** The header at the start of every point file.
+ *
+ * The header is 64 bytes long and stored in the byte order of the machine that
+ * wrote it, which it records so that other machines can reject it. The payload
+ * starts at payload_offset; in structure-of-arrays files, component i starts
+ * at payload_offset + i * component_stride.
+ */
+struct point_file_header {
+    static constexpr std::array<char, 8> signature{'s', 'p', 'p', 'o', 'i', 'n', 't', 's'};
+    static constexpr std::uint16_t current_version = 1;
+
+    std::array<char, 8> magic = signature;
+    std::uint16_t version = current_version;
+    std::uint8_t little_endian = std::endian::native == std::endian::little;
+    std::uint8_t dimension = 0;
+    point_scalar scalar = point_scalar::float32;
+    point_layout layout = point_layout::aos;
+    std::uint16_t reserved = 0;
+    std::uint64_t count = 0;
+    std::uint64_t payload_offset = 64;
+    std::uint64_t component_stride = 0;
+    std::array<std::uint64_t, 3> padding{};
+};
+static_assert(sizeof(point_file_header) == 64 and
+              std::is_trivially_copyable_v<point_file_header>);
+
+/** A read-only point file, mapped into memory.
+ *
+ * Opening a point file only validates its header: the points themselves are
+ * paged in as they're accessed, and the accessors view them in place without
+ * copying. On platforms without mmap, the file is read into memory instead.
+ *
+ * Example:
+ *     sp::point_file const file{"terrain.spp"};
+ *     std::span<glm::vec3 const> points = file.points<glm::vec3>();
+ */
+class point_file {
+public:
+    point_file() = default;
+
+    /** Map a point file into memory.
+     *
+     * Throws std::system_error if the file can't be opened or mapped, and
+     * std::runtime_error if it isn't a valid point file for this machine.
+     */
+    explicit point_file(std::filesystem::path const & path)
+        : _file(path)
+    {
+        if (_file.size() < sizeof(point_file_header)) {
+            throw std::runtime_error{"point file is too small: " + path.string()};
+        }
+        std::memcpy(&_header, _file.data(), sizeof(point_file_header));
+        validate(path);
+    }
+
+    point_file_header const & header() const { return _header; }
+    std::size_t size() const { return _header.count; }
+    std::size_t dimension() const { return _header.dimension; }
+    point_layout layout() const { return _header.layout; }
+
+    /** View the points of an array-of-structures file as vectors.
+     *
+     * Throws std::runtime_error if the file doesn't store packed vectors of
+     * the same dimension and scalar type as Vector.
+     */
+    template<packed_layout Vector>
+        requires point_file_scalar<scalar_field_t<Vector>>
+
+    std::span<Vector const> points() const
+    {
+        if (_header.layout != point_layout::aos or
+                _header.dimension != dimension_v<Vector> or
+                _header.scalar != point_scalar_v<scalar_field_t<Vector>>) {
+            throw std::runtime_error{"point file doesn't store this vector type"};
+        }
+        return {reinterpret_cast<Vector const *>(_file.data() + _header.payload_offset),
+                size()};
+    }
+
+    /** View one component of the points of a structure-of-arrays file.
+     *
+     * Throws std::runtime_error if the file doesn't store components of type
+     * Scalar, or if i isn't less than the dimension of the points.
+     */
+    template<point_file_scalar Scalar>
+    std::span<Scalar const> component(std::size_t i) const
+    {
+        if (_header.layout != point_layout::soa or i >= dimension() or
+                _header.scalar != point_scalar_v<Scalar>) {
+            throw std::runtime_error{"point file doesn't store this component"};
+        }
+        auto const offset = _header.payload_offset + i * _header.component_stride;
+        return {reinterpret_cast<Scalar const *>(_file.data() + offset), size()};
+    }
+
+    /** Copy the points of a file of either layout into vectors.
+     *
+     * Return
+     *   An iterator past the last copied point.
+     *
+     * Parameters
+     *   out - iterator to the start of the copied points
+     *
+     * The points are converted to the scalar type of Vector, and must have the
+     * same dimension.
+     */
+    template<semivector Vector, std::weakly_incrementable Out>
+        requires std::indirectly_writable<Out, Vector>
+
+    Out copy_points(Out out) const
+    {
+        if (_header.dimension != dimension_v<Vector>) {
+            throw std::runtime_error{"point file has a different dimension"};
+        }
+        switch (_header.scalar) {
+        case point_scalar::int8: return copy_as<std::int8_t, Vector>(out);
+        case point_scalar::uint8: return copy_as<std::uint8_t, Vector>(out);
+        case point_scalar::int16: return copy_as<std::int16_t, Vector>(out);
+        case point_scalar::uint16: return copy_as<std::uint16_t, Vector>(out);
+        case point_scalar::int32: return copy_as<std::int32_t, Vector>(out);
+        case point_scalar::uint32: return copy_as<std::uint32_t, Vector>(out);
+        case point_scalar::int64: return copy_as<std::int64_t, Vector>(out);
+        case point_scalar::uint64: return copy_as<std::uint64_t, Vector>(out);
+        case point_scalar::float32: return copy_as<float, Vector>(out);
+        case point_scalar::float64: return copy_as<double, Vector>(out);
+        }
+        return out;
+    }
+private:
+    point_file_header _header{};
+    mapped_file _file;
+
+    void validate(std::filesystem::path const & path)
+    {
+        auto const invalid = [&](char const * reason) {
+            return std::runtime_error{reason + (": " + path.string())};
+        };
+        if (_header.magic != point_file_header::signature) {
+            throw invalid("not a point file");
+        }
+        if (_header.version > point_file_header::current_version) {
+            throw invalid("point file version is newer than this reader");
+        }
+        if ((_header.little_endian != 0) !=
+                (std::endian::native == std::endian::little)) {
+            throw invalid("point file has a different byte order");
+        }
+        std::size_t const scalar_size = detail::point_scalar_size(_header.scalar);
+        if (_header.dimension < 2 or _header.dimension > 4 or scalar_size == 0 or
+                _header.payload_offset % scalar_size != 0) {
+            throw invalid("point file header is corrupt");
+        }
+
+        // make sure the payload fits without overflowing the size computations
+        std::uint64_t const count = _header.count;
+        std::uint64_t const components = _header.layout == point_layout::aos?
+            _header.dimension : 1;
+        std::uint64_t const size = _file.size();
+        std::uint64_t const available = size >= _header.payload_offset?
+            size - _header.payload_offset : 0;
+        bool fits = size >= _header.payload_offset and
+                    count <= available / (components * scalar_size);
+        if (_header.layout == point_layout::soa) {
+            std::uint64_t const last = _header.dimension - 1u;
+            fits = fits and _header.component_stride >= count * scalar_size and
+                   _header.component_stride % scalar_size == 0 and
+                   _header.component_stride <= available / last and
+                   last * _header.component_stride + count * scalar_size <= available;
+        }
+        else if (_header.layout != point_layout::aos) {
+            throw invalid("point file header is corrupt");
+        }
+        if (not fits) { throw invalid("point file is truncated"); }
+    }
+
+    template<class Scalar, class Vector, class Out>
+    Out copy_as(Out out) const
+    {
+        using field = scalar_field_t<Vector>;
+        auto const * payload = reinterpret_cast<Scalar const *>(
+            _file.data() + _header.payload_offset);
+        std::size_t const stride = _header.component_stride / sizeof(Scalar);
+        bool const aos = _header.layout == point_layout::aos;
+        constexpr std::size_t N = dimension_v<Vector>;
+
+        for (std::size_t p = 0; p < size(); ++p, ++out) {
+            Vector v{};
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((get_component<I>(v) = static_cast<field>(
+                    aos? payload[p * N + I] : payload[I * stride + p])), ...);
+            }(std::make_index_sequence<N>{});
+            *out = v;
+        }
+        return out;
+    }
+};
+
+/** Writes a point file in chunks, without holding the points in memory.
+ *
+ * Array-of-structures files can grow without bound. Structure-of-arrays files
+ * reserve space for each component array up front, so they need a capacity.
+ * The header is completed by finish(), or by the destructor, which ignores
+ * any errors; call finish() to find out whether the file was written.
+ *
+ * Example:
+ *     sp::point_file_writer<glm::vec3> writer{"terrain.spp"};
+ *     for (auto const & tile : tiles) { writer.append(tile.points()); }
+ *     writer.finish();
+ */
+template<semivector Vector>
+    requires point_file_scalar<scalar_field_t<Vector>>
+class point_file_writer {
+public:
+    using scalar = scalar_field_t<Vector>;
+    static constexpr std::size_t chunk_size = 1 << 16;
+
+    /** Create or replace a point file.
+     *
+     * Throws std::ios_base::failure if the file can't be written.
+     */
+    explicit point_file_writer(std::filesystem::path const & path,
+                               point_layout layout = point_layout::aos,
+                               std::size_t capacity = 0)
+        : _capacity(capacity)
+    {
+        _header.dimension = static_cast<std::uint8_t>(dimension_v<Vector>);
+        _header.scalar = point_scalar_v<scalar>;
+        _header.layout = layout;
+        if (layout == point_layout::soa) {
+            _header.component_stride = detail::align_up(capacity * sizeof(scalar), 64);
+        }
+        else {
+            _header.component_stride = sizeof(scalar) * dimension_v<Vector>;
+        }
+        _file.exceptions(std::ios::failbit | std::ios::badbit);
+        _file.open(path, std::ios::binary | std::ios::trunc);
+        write_header();
+        _buffer.reserve(chunk_size * dimension_v<Vector>);
+    }
+
+    point_file_writer(point_file_writer &&) = default;
+    point_file_writer & operator=(point_file_writer &&) = default;
+    ~point_file_writer()
+    {
+        try { finish(); } catch (...) {}
+    }
+
+    /** The amount of points written so far. */
+    std::size_t size() const { return _header.count + pending(); }
+
+    /** Write a single point.
+     *
+     * Throws std::length_error if a structure-of-arrays file is full.
+     */
+    void push_back(Vector const & point)
+    {
+        if (_header.layout == point_layout::soa and size() == _capacity) {
+            throw std::length_error{"point file is full"};
+        }
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (_buffer.push_back(get_component<I>(point)), ...);
+        }(std::make_index_sequence<dimension_v<Vector>>{});
+        if (pending() == chunk_size) { flush(); }
+    }
+
+    /** Write a range of points, in bulk when the range is contiguous and its
+     * vectors are packed.
+     */
+    template<ranges::input_range Range>
+        requires std::convertible_to<ranges::range_reference_t<Range>, Vector const &>
+
+    void append(Range && points)
+    {
+        if constexpr (ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+                      std::same_as<ranges::range_value_t<Range>, Vector> and
+                      packed_layout<Vector>) {
+            if (_header.layout == point_layout::aos) {
+                flush();
+                auto const count = static_cast<std::size_t>(ranges::size(points));
+                _file.write(reinterpret_cast<char const *>(ranges::data(points)),
+                            static_cast<std::streamsize>(count * sizeof(Vector)));
+                _header.count += count;
+                return;
+            }
+        }
+        for (auto const & point : points) { push_back(point); }
+    }
+
+    /** Write any buffered points and complete the header.
+     *
+     * The writer can't be used after it's finished.
+     */
+    void finish()
+    {
+        if (not _file.is_open()) { return; }
+        flush();
+        _file.seekp(0);
+        write_header();
+        _file.close();
+    }
+private:
+    point_file_header _header{};
+    std::size_t _capacity;
+    std::ofstream _file;
+    std::vector<scalar> _buffer;
+
+    std::size_t pending() const { return _buffer.size() / dimension_v<Vector>; }
+
+    void write_header()
+    {
+        _file.write(reinterpret_cast<char const *>(&_header), sizeof(_header));
+    }
+
+    void flush()
+    {
+        std::size_t const count = pending();
+        if (count == 0) { return; }
+        if (_header.layout == point_layout::aos) {
+            _file.write(reinterpret_cast<char const *>(_buffer.data()),
+                        static_cast<std::streamsize>(_buffer.size() * sizeof(scalar)));
+        }
+        else {
+            // transpose the chunk and write each component where its array
+            // left off
+            std::vector<scalar> component(count);
+            for (std::size_t c = 0; c < dimension_v<Vector>; ++c) {
+                for (std::size_t p = 0; p < count; ++p) {
+                    component[p] = _buffer[p * dimension_v<Vector> + c];
+                }
+                _file.seekp(static_cast<std::streamoff>(
+                    _header.payload_offset + c * _header.component_stride +
+                    _header.count * sizeof(scalar)));
+                _file.write(reinterpret_cast<char const *>(component.data()),
+                            static_cast<std::streamsize>(count * sizeof(scalar)));
+            }
+        }
+        _header.count += count;
+        _buffer.clear();
+    }
+};
+
+/** Write a range of points to a new point file.
+ *
+ * Parameters
+ *   path - where to write the file
+ *   points - the points to write
+ *   layout - how to arrange the components of the points in the file
+ *
+ * Throws std::ios_base::failure if the file can't be written.
+ */
+template<ranges::input_range Range>
+    requires semivector<ranges::range_value_t<Range>> and
+             point_file_scalar<scalar_field_t<ranges::range_value_t<Range>>>
+
+void write_point_file(std::filesystem::path const & path, Range && points,
+                      point_layout layout = point_layout::aos)
+{
+    using Vector = ranges::range_value_t<Range>;
+    if constexpr (not ranges::sized_range<Range>) {
+        // structure-of-arrays files need to know how many points to expect
+        if (layout == point_layout::soa) {
+            std::vector<Vector> copied;
+            ranges::copy(points, std::back_inserter(copied));
+            write_point_file(path, copied, layout);
+            return;
+        }
+    }
+    std::size_t capacity = 0;
+    if constexpr (ranges::sized_range<Range>) {
+        capacity = static_cast<std::size_t>(ranges::size(points));
+    }
+    point_file_writer<Vector> writer{path, layout, capacity};
+    writer.append(points);
+    writer.finish();
+}
+}
@@ -0,0 +1,390 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <cstddef>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "spatula/mapped_file.hpp"
+
+// algorithms
+#include <algorithm>
+#include <cfloat>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "spatula/parallel.hpp"
+
+namespace sp {
+
+/** A vector whose components can be parsed from text. */
+template<class Vector>
+concept text_point = semivector<Vector> and
+                     field_nd_constructible<Vector, dimension_v<Vector>> and
+                     std::is_arithmetic_v<scalar_field_t<Vector>> and
+                     (not std::same_as<scalar_field_t<Vector>, bool>);
+
+namespace detail {
+
+constexpr bool is_field_separator(char c)
+{
+    return c == ' ' or c == ',' or c == '\t' or c == ';' or c == '\r';
+}
+
+// the start of the line after the one containing p
+inline char const * next_line(char const * p, char const * last)
+{
+    if (p != last and *p == '\n') { return p + 1; }
+    auto const * newline = static_cast<char const *>(
+        std::memchr(p, '\n', static_cast<std::size_t>(last - p)));
+    return newline? newline + 1 : last;
+}
+
+// append the run of decimal digits at p to an integer, eight bytes at a time:
+// the first byte that isn't a digit is found with a word-sized compare, and
+// the digits before it are converted with three multiplications
+inline int read_digits(char const *& p, char const * last, std::uint64_t & value)
+{
+    constexpr std::uint64_t powers[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+    };
+    int digits = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        while (last - p >= 8) {
+            std::uint64_t chunk;
+            std::memcpy(&chunk, p, 8);
+            chunk ^= 0x3030303030303030;
+            // flag bytes greater than 9; carries only reach flagged bytes
+            std::uint64_t const over = ((chunk + 0x7676767676767676) | chunk) &
+                                       0x8080808080808080;
+            int const n = over == 0? 8 : std::countr_zero(over) / 8;
+            if (n > 0) {
+                // move the digits to the end, behind zeros, and combine pairs,
+                // then quads, then the two halves
+                std::uint64_t v = chunk << (8 * (8 - n));
+                v = (v * 10 + (v >> 8)) & 0x00ff00ff00ff00ff;
+                v = (v * 100 + (v >> 16)) & 0x0000ffff0000ffff;
+                v = (v * 10000 + (v >> 32)) & 0xffffffff;
+                value = value * powers[n] + v;
+                digits += n;
+                p += n;
+            }
+            if (n < 8) { return digits; }
+            // the caller rejects runs that could overflow, so stop counting
+            if (digits > 19) { return digits; }
+        }
+    }
+    for (; p != last and static_cast<unsigned>(*p - '0') < 10; ++p, ++digits) {
+        value = value * 10 + static_cast<unsigned>(*p - '0');
+    }
+    return digits;
+}
+
+// parse a plain decimal like -12.375 or 4e-3 without from_chars, returning
+// nullptr when the value can't be computed exactly this way. A mantissa and
+// power of ten that are both exact in Float give a correctly rounded result
+// from a single multiplication or division, the same as from_chars would.
+template<std::floating_point Float>
+char const * parse_decimal(char const * p, char const * last, Float & value)
+{
+    constexpr std::uint64_t max_mantissa =
+        std::uint64_t{1} << std::numeric_limits<Float>::digits;
+    constexpr int max_power = std::same_as<Float, float>? 10 : 22;
+    constexpr Float powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+#if FLT_EVAL_METHOD != 0
+    // the operations have to round to Float, not to a wider type
+    return nullptr;
+#endif
+    bool const negative = p != last and *p == '-';
+    if (negative) { ++p; }
+
+    std::uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = read_digits(p, last, mantissa);
+    if (p != last and *p == '.') {
+        ++p;
+        int const fraction = read_digits(p, last, mantissa);
+        digits += fraction;
+        exponent -= fraction;
+    }
+    // more digits than fit in 64 bits may have overflowed the mantissa
+    if (digits == 0 or digits > 19 or mantissa > max_mantissa) {
+        return nullptr;
+    }
+    if (p != last and (*p == 'e' or *p == 'E')) {
+        char const * q = p + 1;
+        bool const negative_exponent = q != last and *q == '-';
+        if (q != last and (*q == '-' or *q == '+')) { ++q; }
+        int written = 0;
+        char const * const exponent_start = q;
+        for (; q != last and static_cast<unsigned>(*q - '0') < 10 and q - exponent_start < 4; ++q) {
+            written = written * 10 + (*q - '0');
+        }
+        if (q == exponent_start or (q != last and static_cast<unsigned>(*q - '0') < 10)) {
+            return nullptr;
+        }
+        exponent += negative_exponent? -written : written;
+        p = q;
+    }
+    if (exponent < -max_power or exponent > max_power) { return nullptr; }
+
+    Float const m = static_cast<Float>(mantissa);
+    value = exponent < 0? m / powers[-exponent] : m * powers[exponent];
+    if (negative) { value = -value; }
+    return p;
+}
+
+template<class Scalar>
+std::from_chars_result parse_scalar(char const * p, char const * last, Scalar & value)
+{
+    if constexpr (std::floating_point<Scalar> and
+                  std::numeric_limits<Scalar>::is_iec559 and
+                  (std::same_as<Scalar, float> or std::same_as<Scalar, double>)) {
+        if (char const * end = parse_decimal(p, last, value)) {
+            return {end, std::errc{}};
+        }
+    }
+    return std::from_chars(p, last, value);
+}
+
+enum class line_kind { point, blank, malformed };
+
+// parse the line starting at cursor and move the cursor to the next line
+template<text_point Vector>
+line_kind parse_line(char const *& cursor, char const * last, Vector & point)
+{
+    using scalar = scalar_field_t<Vector>;
+    constexpr std::size_t N = dimension_v<Vector>;
+
+    char const * p = cursor;
+    while (p != last and is_field_separator(*p)) { ++p; }
+    if (p == last or *p == '\n' or *p == '#') {
+        cursor = next_line(p, last);
+        return line_kind::blank;
+    }
+
+    std::array<scalar, N> values;
+    for (std::size_t i = 0; i < N; ++i) {
+        if (i > 0) {
+            while (p != last and is_field_separator(*p)) { ++p; }
+        }
+        if (p != last and *p == '+') { ++p; }
+        auto const [end, error] = parse_scalar(p, last, values[i]);
+        if (error != std::errc{}) {
+            cursor = next_line(p, last);
+            return line_kind::malformed;
+        }
+        p = end;
+    }
+    // any further columns, like colors or normals, are ignored
+    bool const separated = p == last or *p == '\n' or is_field_separator(*p);
+    cursor = next_line(p, last);
+    if (not separated) { return line_kind::malformed; }
+
+    point = [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return Vector{values[I]...};
+    }(std::make_index_sequence<N>{});
+    return line_kind::point;
+}
+
+// parse the lines of text into out, returning the offset of the first
+// malformed line, or npos if every line was parsed. The first line with any
+// content may be a header, which is skipped if it isn't a point.
+template<text_point Vector, class Out>
+std::size_t parse_points(std::string_view text, Out & out, bool & at_header)
+{
+    char const * const first = text.data();
+    char const * const last = first + text.size();
+    char const * cursor = first;
+    Vector point{};
+    while (cursor != last) {
+        char const * const line = cursor;
+        switch (parse_line(cursor, last, point)) {
+        case line_kind::point:
+            *out = point;
+            ++out;
+            at_header = false;
+            break;
+        case line_kind::blank:
+            break;
+        case line_kind::malformed:
+            if (not std::exchange(at_header, false)) {
+                return static_cast<std::size_t>(line - first);
+            }
+            break;
+        }
+    }
+    return std::string_view::npos;
+}
+
+[[noreturn]] inline void throw_malformed_point(std::size_t line)
+{
+    throw std::runtime_error{"malformed point on line " + std::to_string(line)};
+}
+
+// the line number of an offset into text
+inline std::size_t line_number(std::string_view text, std::size_t offset)
+{
+    return static_cast<std::size_t>(
+        std::count(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(offset), '\n')) + 1;
+}
+
+// texts are only split for parallel parsing into chunks at least this large
+constexpr std::size_t min_text_chunk = 1 << 20;
+}
+
+/** Parse points from CSV or XYZ text.
+ *
+ * Return
+ *   An iterator past the last parsed point.
+ *
+ * Parameters
+ *   text - lines of points, one per line
+ *   out - iterator to the start of the parsed points, in the order of text
+ *   workers - the maximum amount of threads to parse with
+ *
+ * Each line holds the components of a point, separated by any run of spaces,
+ * tabs, commas or semicolons, and parsed with std::from_chars. Columns after
+ * the components of the point are ignored, as are blank lines, lines starting
+ * with '#', and a header line before the first point. Large texts are split at
+ * line breaks into one chunk per worker, and each worker parses its chunk with
+ * no allocation besides the growth of its output.
+ *
+ * Throws std::runtime_error with the line number of the first line that isn't
+ * a point.
+ *
+ * Example:
+ *     sp::mapped_file const file{"scan.xyz"};
+ *     std::vector<glm::vec3> points;
+ *     sp::read_points<glm::vec3>(file.text(), std::back_inserter(points));
+ */
+template<text_point Vector, std::weakly_incrementable Out>
+    requires std::indirectly_writable<Out, Vector>
+
+Out read_points(std::string_view text, Out out,
+                std::size_t workers = worker_count())
+{
+    workers = std::min(workers, text.size() / detail::min_text_chunk + 1);
+    bool at_header = true;
+    if (workers <= 1) {
+        std::size_t const error = detail::parse_points<Vector>(text, out, at_header);
+        if (error != std::string_view::npos) {
+            detail::throw_malformed_point(detail::line_number(text, error));
+        }
+        return out;
+    }
+
+    // split at the line breaks after evenly spaced offsets
+    std::vector<std::size_t> bounds(workers + 1, text.size());
+    bounds.front() = 0;
+    for (std::size_t i = 1; i < workers; ++i) {
+        std::size_t const nominal = std::max(bounds[i - 1], i * text.size() / workers);
+        std::size_t const newline = text.find('\n', nominal);
+        bounds[i] = newline == std::string_view::npos? text.size() : newline + 1;
+    }
+
+    // workers can't throw, so they report where they failed instead
+    std::vector<std::vector<Vector>> parts(workers);
+    std::vector<std::size_t> errors(workers, std::string_view::npos);
+    parallel_for(workers, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t chunk = begin; chunk < end; ++chunk) {
+            auto inserter = std::back_inserter(parts[chunk]);
+            bool chunk_header = chunk == 0;
+            auto const part = text.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk]);
+            std::size_t const error = detail::parse_points<Vector>(part, inserter, chunk_header);
+            if (error != std::string_view::npos) { errors[chunk] = bounds[chunk] + error; }
+        }
+    }, workers);
+
+    auto const failed = std::ranges::find_if(errors, [](std::size_t error) {
+        return error != std::string_view::npos;
+    });
+    if (failed != errors.end()) {
+        detail::throw_malformed_point(detail::line_number(text, *failed));
+    }
+    for (auto const & part : parts) { out = std::ranges::copy(part, out).out; }
+    return out;
+}
+
+/** Parse points from CSV or XYZ text into a new vector. */
+template<text_point Vector>
+std::vector<Vector> read_points(std::string_view text,
+                                std::size_t workers = worker_count())
+{
+    std::vector<Vector> points;
+    read_points<Vector>(text, std::back_inserter(points), workers);
+    return points;
+}
+
+/** Parse points from a stream of CSV or XYZ text.
+ *
+ * The stream is read in chunks, and only the lines of each chunk are held in
+ * memory, so the text can be arbitrarily large.
+ *
+ * Throws std::runtime_error with the line number of the first line that isn't
+ * a point.
+ */
+template<text_point Vector>
+std::vector<Vector> read_points(std::istream & stream)
+{
+    constexpr std::size_t chunk_size = 1 << 20;
+    std::vector<Vector> points;
+    auto out = std::back_inserter(points);
+
+    std::string buffer;
+    std::size_t carried = 0;
+    std::size_t lines = 0;
+    bool at_header = true;
+    while (stream) {
+        // append the next chunk after the partial line left over from the last
+        buffer.resize(carried + chunk_size);
+        stream.read(buffer.data() + carried, static_cast<std::streamsize>(chunk_size));
+        std::size_t const size = carried + static_cast<std::size_t>(stream.gcount());
+
+        std::string_view const text{buffer.data(), size};
+        std::size_t const end = stream? text.rfind('\n') + 1 : size;
+        std::string_view const whole_lines = text.substr(0, end);
+
+        std::size_t const error = detail::parse_points<Vector>(whole_lines, out, at_header);
+        if (error != std::string_view::npos) {
+            detail::throw_malformed_point(lines + detail::line_number(whole_lines, error));
+        }
+        lines += static_cast<std::size_t>(std::ranges::count(whole_lines, '\n'));
+        carried = size - end;
+        std::memmove(buffer.data(), buffer.data() + end, carried);
+    }
+    return points;
+}
+
+/** Parse the points of a CSV or XYZ file in parallel.
+ *
+ * The file is mapped into memory and parsed in place, as with read_points.
+ *
+ * Throws std::system_error if the file can't be read.
+ */
+template<text_point Vector>
+std::vector<Vector> read_points_file(std::filesystem::path const & path,
+                                     std::size_t workers = worker_count())
+{
+    mapped_file const file{path};
+    return read_points<Vector>(file.text(), workers);
+}
+}
@@ -0,0 +1,621 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <cstddef>
+#include <array>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace sp {
+
+/** A semivector whose components are float or double, which every predicate
+ * evaluates exactly in double precision.
+ */
+template<class Vector>
+concept floating_semivector =
+    semivector<Vector> and
+    (std::same_as<scalar_field_t<Vector>, float> or
+     std::same_as<scalar_field_t<Vector>, double>);
+
+namespace detail {
+
+// Shewchuk's error bounds for the first, floating-point stage of each predicate
+constexpr double predicate_epsilon = 0x1p-53;
+constexpr double orient2d_bound = (3.0 + 16.0 * predicate_epsilon) * predicate_epsilon;
+constexpr double orient3d_bound = (7.0 + 56.0 * predicate_epsilon) * predicate_epsilon;
+constexpr double incircle_bound = (10.0 + 96.0 * predicate_epsilon) * predicate_epsilon;
+constexpr double insphere_bound = (16.0 + 224.0 * predicate_epsilon) * predicate_epsilon;
+
+//
+// Expansion arithmetic
+//
+// An expansion is a sum of doubles ordered by increasing magnitude, whose
+// nonzero terms don't overlap, so that it represents a value exactly and its
+// last term has the sign of the whole sum. These are the "zeroelim" routines
+// of Shewchuk's "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+// Geometric Predicates", which need round-to-nearest double arithmetic, so
+// they don't survive -ffast-math.
+//
+
+using expansion = std::vector<double>;
+
+// a + b = x + y exactly, given |a| >= |b|
+inline void fast_two_sum(double a, double b, double & x, double & y)
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+// a + b = x + y exactly
+inline void two_sum(double a, double b, double & x, double & y)
+{
+    x = a + b;
+    double const b_virtual = x - a;
+    double const a_virtual = x - b_virtual;
+    y = (a - a_virtual) + (b - b_virtual);
+}
+
+// a * b = x + y exactly
+inline void two_product(double a, double b, double & x, double & y)
+{
+    x = a * b;
+#if defined(__FMA__)
+    y = std::fma(a, b, -x);
+#else
+    // split each factor into halves of 26 bits, whose products are exact
+    auto const split = [](double value, double & high, double & low) {
+        double const c = 134217729.0 * value;    // 2^27 + 1
+        high = c - (c - value);
+        low = value - high;
+    };
+    double a_high, a_low, b_high, b_low;
+    split(a, a_high, a_low);
+    split(b, b_high, b_low);
+    double const error = x - a_high * b_high - a_low * b_high - a_high * b_low;
+    y = a_low * b_low - error;
+#endif
+}
+
+// the exact difference a - b as an expansion
+inline expansion exact_difference(double a, double b)
+{
+    double x = a - b;
+    double const b_virtual = a - x;
+    double const a_virtual = x + b_virtual;
+    double const y = (a - a_virtual) + (b_virtual - b);
+    if (y == 0.0) { return {x}; }
+    return {y, x};
+}
+
+inline expansion expansion_sum(expansion const & e, expansion const & f)
+{
+    expansion h;
+    h.reserve(e.size() + f.size());
+    std::size_t i = 0, j = 0;
+    // take the smaller of the next terms, by magnitude
+    auto const next = [&] {
+        if (j == f.size() or
+                (i < e.size() and (f[j] > e[i]) == (f[j] > -e[i]))) {
+            return e[i++];
+        }
+        return f[j++];
+    };
+
+    double q = next();
+    double q_new, h_term;
+    if (i < e.size() and j < f.size()) {
+        double const now = next();
+        fast_two_sum(now, q, q_new, h_term);
+        q = q_new;
+        if (h_term != 0.0) { h.push_back(h_term); }
+    }
+    while (i < e.size() or j < f.size()) {
+        two_sum(q, next(), q_new, h_term);
+        q = q_new;
+        if (h_term != 0.0) { h.push_back(h_term); }
+    }
+    if (q != 0.0 or h.empty()) { h.push_back(q); }
+    return h;
+}
+
+inline expansion scale_expansion(expansion const & e, double b)
+{
+    expansion h;
+    h.reserve(2 * e.size());
+    double q, h_term;
+    two_product(e[0], b, q, h_term);
+    if (h_term != 0.0) { h.push_back(h_term); }
+    for (std::size_t i = 1; i < e.size(); ++i) {
+        double product_high, product_low, partial;
+        two_product(e[i], b, product_high, product_low);
+        two_sum(q, product_low, partial, h_term);
+        if (h_term != 0.0) { h.push_back(h_term); }
+        fast_two_sum(product_high, partial, q, h_term);
+        if (h_term != 0.0) { h.push_back(h_term); }
+    }
+    if (q != 0.0 or h.empty()) { h.push_back(q); }
+    return h;
+}
+
+inline expansion expansion_product(expansion const & e, expansion const & f)
+{
+    expansion h = scale_expansion(e, f[0]);
+    for (std::size_t i = 1; i < f.size(); ++i) {
+        h = expansion_sum(h, scale_expansion(e, f[i]));
+    }
+    return h;
+}
+
+inline expansion negate_expansion(expansion e)
+{
+    for (double & term : e) { term = -term; }
+    return e;
+}
+
+inline expansion expansion_difference(expansion const & e, expansion const & f)
+{
+    return expansion_sum(e, negate_expansion(f));
+}
+
+// the determinant | a b ; c d | = a d - b c
+inline expansion expansion_cross(expansion const & a, expansion const & b,
+                       expansion const & c, expansion const & d)
+{
+    return expansion_difference(expansion_product(a, d), expansion_product(b, c));
+}
+
+//
+// Exact predicates, for when the filters can't decide
+//
+
+inline double orient2d_exact(double const * a, double const * b, double const * c)
+{
+    auto const acx = exact_difference(a[0], c[0]);
+    auto const acy = exact_difference(a[1], c[1]);
+    auto const bcx = exact_difference(b[0], c[0]);
+    auto const bcy = exact_difference(b[1], c[1]);
+    return expansion_cross(acx, acy, bcx, bcy).back();
+}
+
+inline double orient3d_exact(double const * a, double const * b, double const * c,
+                             double const * d)
+{
+    std::array<expansion, 3> ad, bd, cd;
+    for (std::size_t i = 0; i < 3; ++i) {
+        ad[i] = exact_difference(a[i], d[i]);
+        bd[i] = exact_difference(b[i], d[i]);
+        cd[i] = exact_difference(c[i], d[i]);
+    }
+    auto const bc = expansion_cross(bd[0], bd[1], cd[0], cd[1]);
+    auto const ca = expansion_cross(cd[0], cd[1], ad[0], ad[1]);
+    auto const ab = expansion_cross(ad[0], ad[1], bd[0], bd[1]);
+    auto const det = expansion_sum(expansion_product(ad[2], bc),
+                                   expansion_product(bd[2], ca));
+    return expansion_sum(det, expansion_product(cd[2], ab)).back();
+}
+
+inline double incircle_exact(double const * a, double const * b, double const * c,
+                             double const * d)
+{
+    std::array<expansion, 2> ad, bd, cd;
+    for (std::size_t i = 0; i < 2; ++i) {
+        ad[i] = exact_difference(a[i], d[i]);
+        bd[i] = exact_difference(b[i], d[i]);
+        cd[i] = exact_difference(c[i], d[i]);
+    }
+    auto const lift = [](std::array<expansion, 2> const & v) {
+        return expansion_sum(expansion_product(v[0], v[0]),
+                             expansion_product(v[1], v[1]));
+    };
+    auto const bc = expansion_cross(bd[0], bd[1], cd[0], cd[1]);
+    auto const ca = expansion_cross(cd[0], cd[1], ad[0], ad[1]);
+    auto const ab = expansion_cross(ad[0], ad[1], bd[0], bd[1]);
+    auto const det = expansion_sum(expansion_product(lift(ad), bc),
+                                   expansion_product(lift(bd), ca));
+    return expansion_sum(det, expansion_product(lift(cd), ab)).back();
+}
+
+inline double insphere_exact(double const * a, double const * b, double const * c,
+                             double const * d, double const * e)
+{
+    std::array<expansion, 3> ae, be, ce, de;
+    for (std::size_t i = 0; i < 3; ++i) {
+        ae[i] = exact_difference(a[i], e[i]);
+        be[i] = exact_difference(b[i], e[i]);
+        ce[i] = exact_difference(c[i], e[i]);
+        de[i] = exact_difference(d[i], e[i]);
+    }
+    auto const ab = expansion_cross(ae[0], ae[1], be[0], be[1]);
+    auto const bc = expansion_cross(be[0], be[1], ce[0], ce[1]);
+    auto const cd = expansion_cross(ce[0], ce[1], de[0], de[1]);
+    auto const da = expansion_cross(de[0], de[1], ae[0], ae[1]);
+    auto const ac = expansion_cross(ae[0], ae[1], ce[0], ce[1]);
+    auto const bd = expansion_cross(be[0], be[1], de[0], de[1]);
+
+    // z times the 2d minors, signed by their cofactors
+    auto const minor3 = [](expansion const & z0, expansion const & m0, int s0,
+                           expansion const & z1, expansion const & m1, int s1,
+                           expansion const & z2, expansion const & m2, int s2) {
+        auto const term = [](expansion const & z, expansion const & m, int sign) {
+            auto t = expansion_product(z, m);
+            return sign < 0? negate_expansion(std::move(t)) : t;
+        };
+        return expansion_sum(expansion_sum(term(z0, m0, s0), term(z1, m1, s1)),
+                             term(z2, m2, s2));
+    };
+    auto const abc = minor3(ae[2], bc, 1, be[2], ac, -1, ce[2], ab, 1);
+    auto const bcd = minor3(be[2], cd, 1, ce[2], bd, -1, de[2], bc, 1);
+    auto const cda = minor3(ce[2], da, 1, de[2], ac, 1, ae[2], cd, 1);
+    auto const dab = minor3(de[2], ab, 1, ae[2], bd, 1, be[2], da, 1);
+
+    auto const lift = [](std::array<expansion, 3> const & v) {
+        auto const xy = expansion_sum(expansion_product(v[0], v[0]),
+                                      expansion_product(v[1], v[1]));
+        return expansion_sum(xy, expansion_product(v[2], v[2]));
+    };
+    auto const dc = expansion_difference(expansion_product(lift(de), abc),
+                                         expansion_product(lift(ce), dab));
+    auto const ba = expansion_difference(expansion_product(lift(be), cda),
+                                         expansion_product(lift(ae), bcd));
+    return expansion_sum(dc, ba).back();
+}
+
+//
+// Floating-point filters, which set the determinant and a bound on its error
+//
+
+inline void orient2d_filter(double const * a, double const * b, double const * c,
+                            double & det, double & bound)
+{
+    double const left = (a[0] - c[0]) * (b[1] - c[1]);
+    double const right = (a[1] - c[1]) * (b[0] - c[0]);
+    det = left - right;
+    bound = orient2d_bound * (std::abs(left) + std::abs(right));
+}
+
+inline void orient3d_filter(double const * a, double const * b, double const * c,
+                            double const * d, double & det, double & bound)
+{
+    double const adx = a[0] - d[0], bdx = b[0] - d[0], cdx = c[0] - d[0];
+    double const ady = a[1] - d[1], bdy = b[1] - d[1], cdy = c[1] - d[1];
+    double const adz = a[2] - d[2], bdz = b[2] - d[2], cdz = c[2] - d[2];
+
+    double const bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double const cdxady = cdx * ady, adxcdy = adx * cdy;
+    double const adxbdy = adx * bdy, bdxady = bdx * ady;
+
+    det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    double const permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz) +
+                             (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz) +
+                             (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+    bound = orient3d_bound * permanent;
+}
+
+inline void incircle_filter(double const * a, double const * b, double const * c,
+                            double const * d, double & det, double & bound)
+{
+    double const adx = a[0] - d[0], bdx = b[0] - d[0], cdx = c[0] - d[0];
+    double const ady = a[1] - d[1], bdy = b[1] - d[1], cdy = c[1] - d[1];
+
+    double const bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double const cdxady = cdx * ady, adxcdy = adx * cdy;
+    double const adxbdy = adx * bdy, bdxady = bdx * ady;
+    double const alift = adx * adx + ady * ady;
+    double const blift = bdx * bdx + bdy * bdy;
+    double const clift = cdx * cdx + cdy * cdy;
+
+    det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) +
+          clift * (adxbdy - bdxady);
+    double const permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+                             (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                             (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+    bound = incircle_bound * permanent;
+}
+
+inline void insphere_filter(double const * a, double const * b, double const * c,
+                            double const * d, double const * e,
+                            double & det, double & bound)
+{
+    double const aex = a[0] - e[0], bex = b[0] - e[0], cex = c[0] - e[0], dex = d[0] - e[0];
+    double const aey = a[1] - e[1], bey = b[1] - e[1], cey = c[1] - e[1], dey = d[1] - e[1];
+    double const aez = a[2] - e[2], bez = b[2] - e[2], cez = c[2] - e[2], dez = d[2] - e[2];
+
+    double const aexbey = aex * bey, bexaey = bex * aey;
+    double const bexcey = bex * cey, cexbey = cex * bey;
+    double const cexdey = cex * dey, dexcey = dex * cey;
+    double const dexaey = dex * aey, aexdey = aex * dey;
+    double const aexcey = aex * cey, cexaey = cex * aey;
+    double const bexdey = bex * dey, dexbey = dex * bey;
+    double const ab = aexbey - bexaey, bc = bexcey - cexbey;
+    double const cd = cexdey - dexcey, da = dexaey - aexdey;
+    double const ac = aexcey - cexaey, bd = bexdey - dexbey;
+
+    double const abc = aez * bc - bez * ac + cez * ab;
+    double const bcd = bez * cd - cez * bd + dez * bc;
+    double const cda = cez * da + dez * ac + aez * cd;
+    double const dab = dez * ab + aez * bd + bez * da;
+
+    double const alift = aex * aex + aey * aey + aez * aez;
+    double const blift = bex * bex + bey * bey + bez * bez;
+    double const clift = cex * cex + cey * cey + cez * cez;
+    double const dlift = dex * dex + dey * dey + dez * dez;
+
+    det = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+
+    double const aezplus = std::abs(aez), bezplus = std::abs(bez);
+    double const cezplus = std::abs(cez), dezplus = std::abs(dez);
+    double const ab_plus = std::abs(aexbey) + std::abs(bexaey);
+    double const bc_plus = std::abs(bexcey) + std::abs(cexbey);
+    double const cd_plus = std::abs(cexdey) + std::abs(dexcey);
+    double const da_plus = std::abs(dexaey) + std::abs(aexdey);
+    double const ac_plus = std::abs(aexcey) + std::abs(cexaey);
+    double const bd_plus = std::abs(bexdey) + std::abs(dexbey);
+    double const permanent =
+        (cd_plus * bezplus + bd_plus * cezplus + bc_plus * dezplus) * alift +
+        (da_plus * cezplus + ac_plus * dezplus + cd_plus * aezplus) * blift +
+        (ab_plus * dezplus + bd_plus * aezplus + da_plus * bezplus) * clift +
+        (bc_plus * aezplus + ac_plus * bezplus + ab_plus * cezplus) * dlift;
+    bound = insphere_bound * permanent;
+}
+
+template<std::size_t N, class Vector>
+std::array<double, N> coordinates(Vector const & v)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<double, N>{static_cast<double>(get_component<I>(v))...};
+    }(std::make_index_sequence<N>{});
+}
+
+// run a predicate over a range of query points in blocks, running the filter
+// over a whole block first and then resolving only the points it can't decide
+// with exact arithmetic, so that the filter's loop stays free of branches
+template<std::size_t N, class Range, class Out, class Filter, class Exact>
+Out filter_points(Range && points, Out out, Filter filter, Exact exact)
+{
+    constexpr std::size_t block = 256;
+    std::array<std::array<double, N>, block> coordinates;
+    std::array<double, block> determinants, bounds;
+
+    auto it = ranges::begin(points);
+    auto const last = ranges::end(points);
+    while (it != last) {
+        std::size_t count = 0;
+        for (; count < block and it != last; ++count, ++it) {
+            coordinates[count] = detail::coordinates<N>(*it);
+        }
+        std::size_t undecided = 0;
+        for (std::size_t k = 0; k < count; ++k) {
+            filter(coordinates[k].data(), determinants[k], bounds[k]);
+            undecided += std::abs(determinants[k]) <= bounds[k];
+        }
+        for (std::size_t k = 0; undecided > 0 and k < count; ++k) {
+            if (std::abs(determinants[k]) <= bounds[k]) {
+                determinants[k] = exact(coordinates[k].data());
+                --undecided;
+            }
+        }
+        out = std::copy_n(determinants.begin(), count, out);
+    }
+    return out;
+}
+}
+
+/** The orientation of three points in the plane.
+ *
+ * Return
+ *   A positive value if a, b and c are in counterclockwise order, a negative
+ *   value if they're in clockwise order, and zero if they're collinear. The
+ *   value approximates twice the signed area of the triangle, but only its
+ *   sign is exact.
+ *
+ * A floating-point filter decides almost every input. Only when the rounding
+ * error of the filter could change the sign does the predicate fall back to
+ * exact expansion arithmetic, so near-degenerate inputs still give consistent
+ * answers.
+ *
+ * Example:
+ *     if (sp::orient2d(edge_start, edge_end, p) > 0) { // p is left of the edge
+ */
+template<floating_semivector Vector>
+    requires (dimension_v<Vector> == 2)
+
+double orient2d(Vector const & a, Vector const & b, Vector const & c)
+{
+    auto const pa = detail::coordinates<2>(a);
+    auto const pb = detail::coordinates<2>(b);
+    auto const pc = detail::coordinates<2>(c);
+    double det, bound;
+    detail::orient2d_filter(pa.data(), pb.data(), pc.data(), det, bound);
+    if (std::abs(det) > bound) [[likely]] { return det; }
+    return detail::orient2d_exact(pa.data(), pb.data(), pc.data());
+}
+
+/** The orientation of a point relative to the plane through three others.
+ *
+ * Return
+ *   A positive value if d lies below the plane through a, b and c, where below
+ *   is the side from which a, b and c appear clockwise, a negative value if d
+ *   lies above it, and zero if the points are coplanar. Only the sign is exact.
+ */
+template<floating_semivector Vector>
+    requires (dimension_v<Vector> == 3)
+
+double orient3d(Vector const & a, Vector const & b, Vector const & c, Vector const & d)
+{
+    auto const pa = detail::coordinates<3>(a);
+    auto const pb = detail::coordinates<3>(b);
+    auto const pc = detail::coordinates<3>(c);
+    auto const pd = detail::coordinates<3>(d);
+    double det, bound;
+    detail::orient3d_filter(pa.data(), pb.data(), pc.data(), pd.data(), det, bound);
+    if (std::abs(det) > bound) [[likely]] { return det; }
+    return detail::orient3d_exact(pa.data(), pb.data(), pc.data(), pd.data());
+}
+
+/** Whether a point lies inside the circle through three others.
+ *
+ * Return
+ *   A positive value if d lies inside the circle through a, b and c, a
+ *   negative value if it lies outside, and zero if the four points are
+ *   cocircular, given that a, b and c are in counterclockwise order; the sign
+ *   is reversed if they're clockwise. Only the sign is exact.
+ */
+template<floating_semivector Vector>
+    requires (dimension_v<Vector> == 2)
+
+double incircle(Vector const & a, Vector const & b, Vector const & c, Vector const & d)
+{
+    auto const pa = detail::coordinates<2>(a);
+    auto const pb = detail::coordinates<2>(b);
+    auto const pc = detail::coordinates<2>(c);
+    auto const pd = detail::coordinates<2>(d);
+    double det, bound;
+    detail::incircle_filter(pa.data(), pb.data(), pc.data(), pd.data(), det, bound);
+    if (std::abs(det) > bound) [[likely]] { return det; }
+    return detail::incircle_exact(pa.data(), pb.data(), pc.data(), pd.data());
+}
+
+/** Whether a point lies inside the sphere through four others.
+ *
+ * Return
+ *   A positive value if e lies inside the sphere through a, b, c and d, a
+ *   negative value if it lies outside, and zero if the five points are
+ *   cospherical, given that orient3d(a, b, c, d) is positive; the sign is
+ *   reversed otherwise. Only the sign is exact.
+ */
+template<floating_semivector Vector>
+    requires (dimension_v<Vector> == 3)
+
+double insphere(Vector const & a, Vector const & b, Vector const & c,
+                Vector const & d, Vector const & e)
+{
+    auto const pa = detail::coordinates<3>(a);
+    auto const pb = detail::coordinates<3>(b);
+    auto const pc = detail::coordinates<3>(c);
+    auto const pd = detail::coordinates<3>(d);
+    auto const pe = detail::coordinates<3>(e);
+    double det, bound;
+    detail::insphere_filter(pa.data(), pb.data(), pc.data(), pd.data(), pe.data(),
+                            det, bound);
+    if (std::abs(det) > bound) [[likely]] { return det; }
+    return detail::insphere_exact(pa.data(), pb.data(), pc.data(), pd.data(), pe.data());
+}
+
+/** The orientation of each of a range of points relative to a directed line.
+ *
+ * Return
+ *   An iterator past the last orientation, where each is orient2d(a, b, p)
+ *   for the next point p.
+ *
+ * Parameters
+ *   a, b - two points on the line, directed from a to b
+ *   points - the points to test
+ *   out - iterator to the start of the orientations
+ *
+ * The filter runs over blocks of points at a time, so that it vectorizes, and
+ * the exact fallback only runs for the points it can't decide.
+ */
+template<floating_semivector Vector, ranges::input_range Range,
+         std::weakly_incrementable Out>
+    requires (dimension_v<Vector> == 2) and
+             std::same_as<ranges::range_value_t<Range>, Vector> and
+             std::indirectly_writable<Out, double>
+
+Out orient2d(Vector const & a, Vector const & b, Range && points, Out out)
+{
+    auto const pa = detail::coordinates<2>(a);
+    auto const pb = detail::coordinates<2>(b);
+    return detail::filter_points<2>(points, out,
+        [&](double const * p, double & det, double & bound) {
+            detail::orient2d_filter(pa.data(), pb.data(), p, det, bound);
+        },
+        [&](double const * p) {
+            return detail::orient2d_exact(pa.data(), pb.data(), p);
+        });
+}
+
+/** The orientation of each of a range of points relative to a plane, where
+ * each is orient3d(a, b, c, p) for the next point p.
+ */
+template<floating_semivector Vector, ranges::input_range Range,
+         std::weakly_incrementable Out>
+    requires (dimension_v<Vector> == 3) and
+             std::same_as<ranges::range_value_t<Range>, Vector> and
+             std::indirectly_writable<Out, double>
+
+Out orient3d(Vector const & a, Vector const & b, Vector const & c,
+             Range && points, Out out)
+{
+    auto const pa = detail::coordinates<3>(a);
+    auto const pb = detail::coordinates<3>(b);
+    auto const pc = detail::coordinates<3>(c);
+    return detail::filter_points<3>(points, out,
+        [&](double const * p, double & det, double & bound) {
+            detail::orient3d_filter(pa.data(), pb.data(), pc.data(), p, det, bound);
+        },
+        [&](double const * p) {
+            return detail::orient3d_exact(pa.data(), pb.data(), pc.data(), p);
+        });
+}
+
+/** Whether each of a range of points lies inside a circle, where each result
+ * is incircle(a, b, c, p) for the next point p.
+ */
+template<floating_semivector Vector, ranges::input_range Range,
+         std::weakly_incrementable Out>
+    requires (dimension_v<Vector> == 2) and
+             std::same_as<ranges::range_value_t<Range>, Vector> and
+             std::indirectly_writable<Out, double>
+
+Out incircle(Vector const & a, Vector const & b, Vector const & c,
+             Range && points, Out out)
+{
+    auto const pa = detail::coordinates<2>(a);
+    auto const pb = detail::coordinates<2>(b);
+    auto const pc = detail::coordinates<2>(c);
+    return detail::filter_points<2>(points, out,
+        [&](double const * p, double & det, double & bound) {
+            detail::incircle_filter(pa.data(), pb.data(), pc.data(), p, det, bound);
+        },
+        [&](double const * p) {
+            return detail::incircle_exact(pa.data(), pb.data(), pc.data(), p);
+        });
+}
+
+/** Whether each of a range of points lies inside a sphere, where each result
+ * is insphere(a, b, c, d, p) for the next point p.
+ */
+template<floating_semivector Vector, ranges::input_range Range,
+         std::weakly_incrementable Out>
+    requires (dimension_v<Vector> == 3) and
+             std::same_as<ranges::range_value_t<Range>, Vector> and
+             std::indirectly_writable<Out, double>
+
+Out insphere(Vector const & a, Vector const & b, Vector const & c, Vector const & d,
+             Range && points, Out out)
+{
+    auto const pa = detail::coordinates<3>(a);
+    auto const pb = detail::coordinates<3>(b);
+    auto const pc = detail::coordinates<3>(c);
+    auto const pd = detail::coordinates<3>(d);
+    return detail::filter_points<3>(points, out,
+        [&](double const * p, double & det, double & bound) {
+            detail::insphere_filter(pa.data(), pb.data(), pc.data(), pd.data(), p,
+                                    det, bound);
+        },
+        [&](double const * p) {
+            return detail::insphere_exact(pa.data(), pb.data(), pc.data(), pd.data(), p);
+        });
+}
+}
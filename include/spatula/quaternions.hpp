@@ -0,0 +1,574 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+#include "spatula/layouts.hpp"
+
+// data types and data structures
+#include <cstddef>
+#include <array>
+#include "spatula/affine.hpp"
+
+// algorithms
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace sp {
+
+/** A floating-point semivector4 used as a quaternion x i + y j + z k + w.
+ *
+ * Any four-component vector type works, so glm::vec4 or Eigen::Vector4f can
+ * hold rotations alongside the library's own quaternion types, using the same
+ * (x, y, z, w) order as glm::quat and Eigen::Quaternion coefficients. Unit
+ * quaternions represent rotations.
+ *
+ * Example:
+ *     auto const turn = sp::axis_angle<glm::vec4>(glm::vec3{0, 1, 0}, yaw);
+ *     auto const facing = sp::rotate(turn, glm::vec3{0, 0, 1});
+ */
+template<class Quaternion>
+concept quaternion = semivector4<Quaternion> and
+                     std::floating_point<scalar_field_t<Quaternion>>;
+
+/** The unit quaternion that rotates by an angle in radians about an axis,
+ * counterclockwise when the axis points towards the viewer. The axis doesn't
+ * need to be normalized, but it can't be zero.
+ */
+template<quaternion Quaternion, semivector3 Vector>
+Quaternion axis_angle(Vector const & axis, scalar_field_t<Quaternion> radians)
+{
+    using scalar = scalar_field_t<Quaternion>;
+    scalar const x = static_cast<scalar>(get_x(axis));
+    scalar const y = static_cast<scalar>(get_y(axis));
+    scalar const z = static_cast<scalar>(get_z(axis));
+    scalar const scale = std::sin(radians / 2) / std::sqrt(x * x + y * y + z * z);
+    return Quaternion{x * scale, y * scale, z * scale, std::cos(radians / 2)};
+}
+
+/** The Hamilton product of two quaternions, which rotates by b and then by a. */
+template<quaternion Quaternion>
+constexpr Quaternion quaternion_product(Quaternion const & a, Quaternion const & b)
+{
+    auto const ax = get_x(a), ay = get_y(a), az = get_z(a), aw = get_w(a);
+    auto const bx = get_x(b), by = get_y(b), bz = get_z(b), bw = get_w(b);
+    return Quaternion{aw * bx + ax * bw + ay * bz - az * by,
+                      aw * by - ax * bz + ay * bw + az * bx,
+                      aw * bz + ax * by - ay * bx + az * bw,
+                      aw * bw - ax * bx - ay * by - az * bz};
+}
+
+/** The conjugate of a quaternion, which is the inverse rotation of a unit
+ * quaternion.
+ */
+template<quaternion Quaternion>
+constexpr Quaternion conjugate(Quaternion const & q)
+{
+    return Quaternion{-get_x(q), -get_y(q), -get_z(q), get_w(q)};
+}
+
+/** A quaternion scaled to unit length. The zero quaternion has no direction,
+ * and gives NaN components.
+ */
+template<quaternion Quaternion>
+Quaternion normalize(Quaternion const & q)
+{
+    using scalar = scalar_field_t<Quaternion>;
+    auto const x = get_x(q), y = get_y(q), z = get_z(q), w = get_w(q);
+    scalar const scale = scalar{1} / std::sqrt(x * x + y * y + z * z + w * w);
+    return Quaternion{x * scale, y * scale, z * scale, w * scale};
+}
+
+/** Rotate a vector by a unit quaternion. */
+template<quaternion Quaternion, semivector3 Vector>
+constexpr Vector rotate(Quaternion const & q, Vector const & v)
+{
+    using scalar = scalar_field_t<Quaternion>;
+    using component = scalar_field_t<Vector>;
+    scalar const qx = get_x(q), qy = get_y(q), qz = get_z(q), qw = get_w(q);
+    scalar const vx = static_cast<scalar>(get_x(v));
+    scalar const vy = static_cast<scalar>(get_y(v));
+    scalar const vz = static_cast<scalar>(get_z(v));
+
+    // v + w t + q × t, where t = 2 q × v
+    scalar const tx = 2 * (qy * vz - qz * vy);
+    scalar const ty = 2 * (qz * vx - qx * vz);
+    scalar const tz = 2 * (qx * vy - qy * vx);
+    return Vector{static_cast<component>(vx + qw * tx + (qy * tz - qz * ty)),
+                  static_cast<component>(vy + qw * ty + (qz * tx - qx * tz)),
+                  static_cast<component>(vz + qw * tz + (qx * ty - qy * tx))};
+}
+
+/** The rotation of a quaternion as an affine transform. The quaternion doesn't
+ * need to be normalized.
+ */
+template<quaternion Quaternion>
+constexpr affine<scalar_field_t<Quaternion>, 3> to_affine(Quaternion const & q)
+{
+    using scalar = scalar_field_t<Quaternion>;
+    scalar const x = get_x(q), y = get_y(q), z = get_z(q), w = get_w(q);
+    scalar const s = scalar{2} / (x * x + y * y + z * z + w * w);
+    scalar const xx = s * x * x, yy = s * y * y, zz = s * z * z;
+    scalar const xy = s * x * y, xz = s * x * z, yz = s * y * z;
+    scalar const wx = s * w * x, wy = s * w * y, wz = s * w * z;
+    return affine<scalar, 3>{{{
+        {1 - yy - zz, xy - wz, xz + wy, scalar{0}},
+        {xy + wz, 1 - xx - zz, yz - wx, scalar{0}},
+        {xz - wy, yz + wx, 1 - xx - yy, scalar{0}}
+    }}};
+}
+
+namespace detail {
+template<quaternion Quaternion>
+constexpr scalar_field_t<Quaternion> quaternion_dot(Quaternion const & a,
+                                                    Quaternion const & b)
+{
+    return get_x(a) * get_x(b) + get_y(a) * get_y(b) +
+           get_z(a) * get_z(b) + get_w(a) * get_w(b);
+}
+
+// a + t (b - a), with each component of b multiplied by sign
+template<quaternion Quaternion, class Scalar>
+constexpr Quaternion quaternion_lerp(Quaternion const & a, Quaternion const & b,
+                                     Scalar sign, Scalar t)
+{
+    auto const lerp = [&](Scalar x, Scalar y) { return x + t * (sign * y - x); };
+    return Quaternion{lerp(get_x(a), get_x(b)), lerp(get_y(a), get_y(b)),
+                      lerp(get_z(a), get_z(b)), lerp(get_w(a), get_w(b))};
+}
+}
+
+/** Interpolate between two rotations along a straight line, normalizing the
+ * result.
+ *
+ * nlerp takes the shorter way around like slerp, but it doesn't turn at a
+ * constant rate. It's much cheaper, and close to slerp when the rotations are
+ * close to each other.
+ */
+template<quaternion Quaternion>
+Quaternion nlerp(Quaternion const & a, Quaternion const & b,
+                 scalar_field_t<Quaternion> t)
+{
+    using scalar = scalar_field_t<Quaternion>;
+    scalar const sign = detail::quaternion_dot(a, b) < 0? scalar{-1} : scalar{1};
+    return normalize(detail::quaternion_lerp(a, b, sign, t));
+}
+
+/** Interpolate between two rotations at a constant rate, taking the shorter
+ * way around.
+ *
+ * Parameters
+ *   a, b - the unit quaternions to interpolate between
+ *   t - how far from a to b to go, where 0 gives a and 1 gives b
+ */
+template<quaternion Quaternion>
+Quaternion slerp(Quaternion const & a, Quaternion const & b,
+                 scalar_field_t<Quaternion> t)
+{
+    using scalar = scalar_field_t<Quaternion>;
+    scalar cosine = detail::quaternion_dot(a, b);
+    scalar const sign = cosine < 0? scalar{-1} : scalar{1};
+    cosine = std::min(cosine * sign, scalar{1});
+
+    // sin(angle) vanishes as the rotations meet, where nlerp is exact enough
+    if (cosine > scalar{0.9995}) { return nlerp(a, b, t); }
+    scalar const angle = std::acos(cosine);
+    scalar const inverse_sine = scalar{1} / std::sin(angle);
+    scalar const wa = std::sin((1 - t) * angle) * inverse_sine;
+    scalar const wb = std::sin(t * angle) * inverse_sine * sign;
+    return Quaternion{wa * get_x(a) + wb * get_x(b), wa * get_y(a) + wb * get_y(b),
+                      wa * get_z(a) + wb * get_z(b), wa * get_w(a) + wb * get_w(b)};
+}
+
+namespace detail {
+
+// a range of quaternions or vectors stored as packed floats, which the batch
+// kernels can read or write eight at a time
+template<class Range, std::size_t N>
+concept packed_float_range =
+    ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+    packed_layout<ranges::range_value_t<Range>> and
+    std::same_as<scalar_field_t<ranges::range_value_t<Range>>, float> and
+    (dimension_v<ranges::range_value_t<Range>> == N);
+
+template<class Out, class Value>
+concept packed_float_output =
+    contiguous_output<Out, Value> and packed_layout<Value> and
+    std::same_as<scalar_field_t<Value>, float>;
+
+#if defined(__AVX__)
+// eight quaternions in registers of one component each
+struct quaternions8 {
+    __m256 x, y, z, w;
+};
+
+inline void transpose4(__m256 & a, __m256 & b, __m256 & c, __m256 & d)
+{
+    __m256 const ab_low = _mm256_unpacklo_ps(a, b);
+    __m256 const cd_low = _mm256_unpacklo_ps(c, d);
+    __m256 const ab_high = _mm256_unpackhi_ps(a, b);
+    __m256 const cd_high = _mm256_unpackhi_ps(c, d);
+    a = _mm256_shuffle_ps(ab_low, cd_low, _MM_SHUFFLE(1, 0, 1, 0));
+    b = _mm256_shuffle_ps(ab_low, cd_low, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm256_shuffle_ps(ab_high, cd_high, _MM_SHUFFLE(1, 0, 1, 0));
+    d = _mm256_shuffle_ps(ab_high, cd_high, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+// the low lanes hold quaternions 0-3 and the high lanes 4-7, so transposing
+// each lane leaves the components in order
+inline quaternions8 load_quaternions(float const * q)
+{
+    auto const load = [q](std::size_t i) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(q + 4 * i)),
+                                    _mm_loadu_ps(q + 4 * i + 16), 1);
+    };
+    quaternions8 result{load(0), load(1), load(2), load(3)};
+    transpose4(result.x, result.y, result.z, result.w);
+    return result;
+}
+
+inline void store_quaternions(float * q, quaternions8 v)
+{
+    transpose4(v.x, v.y, v.z, v.w);
+    _mm256_storeu_ps(q, _mm256_permute2f128_ps(v.x, v.y, 0x20));
+    _mm256_storeu_ps(q + 8, _mm256_permute2f128_ps(v.z, v.w, 0x20));
+    _mm256_storeu_ps(q + 16, _mm256_permute2f128_ps(v.x, v.y, 0x31));
+    _mm256_storeu_ps(q + 24, _mm256_permute2f128_ps(v.z, v.w, 0x31));
+}
+
+inline __m256 dot(quaternions8 const & a, quaternions8 const & b)
+{
+    __m256 sum = _mm256_mul_ps(a.x, b.x);
+    sum = multiply_add(a.y, b.y, sum);
+    sum = multiply_add(a.z, b.z, sum);
+    return multiply_add(a.w, b.w, sum);
+}
+
+inline quaternions8 normalize(quaternions8 const & q)
+{
+    __m256 const length = _mm256_sqrt_ps(dot(q, q));
+    __m256 const scale = _mm256_div_ps(_mm256_set1_ps(1.f), length);
+    return {_mm256_mul_ps(q.x, scale), _mm256_mul_ps(q.y, scale),
+            _mm256_mul_ps(q.z, scale), _mm256_mul_ps(q.w, scale)};
+}
+
+// flip b wherever it's more than a quarter turn away from a, so that the
+// interpolation takes the shorter way around, and return the cosine between
+// them, which is then positive
+inline __m256 shorter_way(quaternions8 const & a, quaternions8 & b)
+{
+    __m256 const cosine = dot(a, b);
+    __m256 const sign = _mm256_and_ps(cosine, _mm256_set1_ps(-0.f));
+    b.x = _mm256_xor_ps(b.x, sign);
+    b.y = _mm256_xor_ps(b.y, sign);
+    b.z = _mm256_xor_ps(b.z, sign);
+    b.w = _mm256_xor_ps(b.w, sign);
+    return _mm256_xor_ps(cosine, sign);
+}
+
+// wa a + wb b
+inline quaternions8 weighted_sum(__m256 wa, quaternions8 const & a,
+                                 __m256 wb, quaternions8 const & b)
+{
+    return {multiply_add(wa, a.x, _mm256_mul_ps(wb, b.x)),
+            multiply_add(wa, a.y, _mm256_mul_ps(wb, b.y)),
+            multiply_add(wa, a.z, _mm256_mul_ps(wb, b.z)),
+            multiply_add(wa, a.w, _mm256_mul_ps(wb, b.w))};
+}
+#endif
+
+// the coefficients of sin(t θ) / sin(θ) as a polynomial in cos(θ) - 1, from
+// the series in Eberly's "A Fast and Accurate Algorithm for Computing SLERP",
+// with the last term scaled to make up for the ones left out; the error is
+// within 3.2e-8 for angles up to a quarter turn
+constexpr std::size_t slerp_terms = 16;
+
+inline std::array<float, slerp_terms + 1> slerp_coefficients(double t)
+{
+    std::array<float, slerp_terms + 1> coefficients;
+    double term = t;
+    coefficients[0] = static_cast<float>(term);
+    for (std::size_t i = 1; i <= slerp_terms; ++i) {
+        double const n = static_cast<double>(i);
+        term *= (t * t - n * n) / (n * (2 * n + 1));
+        if (i == slerp_terms) { term *= 1.92; }
+        coefficients[i] = static_cast<float>(term);
+    }
+    return coefficients;
+}
+
+template<class Quaternion>
+void normalize_packed(Quaternion const * in, std::size_t count, Quaternion * out)
+{
+    std::size_t k = 0;
+#if defined(__AVX__)
+    auto const * from = reinterpret_cast<float const *>(in);
+    auto * to = reinterpret_cast<float *>(out);
+    for (; k + 8 <= count; k += 8) {
+        store_quaternions(to + 4 * k, normalize(load_quaternions(from + 4 * k)));
+    }
+#endif
+    for (; k < count; ++k) { out[k] = sp::normalize(in[k]); }
+}
+
+template<class Quaternion>
+void nlerp_packed(Quaternion const * a, Quaternion const * b, float t,
+                  std::size_t count, Quaternion * out)
+{
+    std::size_t k = 0;
+#if defined(__AVX__)
+    auto const * from = reinterpret_cast<float const *>(a);
+    auto const * to = reinterpret_cast<float const *>(b);
+    auto * result = reinterpret_cast<float *>(out);
+    __m256 const wb = _mm256_set1_ps(t);
+    __m256 const wa = _mm256_set1_ps(1 - t);
+    for (; k + 8 <= count; k += 8) {
+        quaternions8 const qa = load_quaternions(from + 4 * k);
+        quaternions8 qb = load_quaternions(to + 4 * k);
+        shorter_way(qa, qb);
+        store_quaternions(result + 4 * k, normalize(weighted_sum(wa, qa, wb, qb)));
+    }
+#endif
+    for (; k < count; ++k) { out[k] = sp::nlerp(a[k], b[k], t); }
+}
+
+template<class Quaternion>
+void slerp_packed(Quaternion const * a, Quaternion const * b, float t,
+                  std::size_t count, Quaternion * out)
+{
+    std::size_t k = 0;
+#if defined(__AVX__)
+    auto const * from = reinterpret_cast<float const *>(a);
+    auto const * to = reinterpret_cast<float const *>(b);
+    auto * result = reinterpret_cast<float *>(out);
+
+    // the weights of a and b are polynomials in the cosine between them, so
+    // the whole interpolation vectorizes without any trigonometry
+    auto const ca = slerp_coefficients(1.0 - t);
+    auto const cb = slerp_coefficients(t);
+    __m256 const one = _mm256_set1_ps(1.f);
+    for (; k + 8 <= count; k += 8) {
+        quaternions8 const qa = load_quaternions(from + 4 * k);
+        quaternions8 qb = load_quaternions(to + 4 * k);
+        __m256 const x = _mm256_sub_ps(_mm256_min_ps(shorter_way(qa, qb), one), one);
+
+        __m256 wa = _mm256_set1_ps(ca[slerp_terms]);
+        __m256 wb = _mm256_set1_ps(cb[slerp_terms]);
+        for (std::size_t i = slerp_terms; i-- > 0;) {
+            wa = multiply_add(wa, x, _mm256_set1_ps(ca[i]));
+            wb = multiply_add(wb, x, _mm256_set1_ps(cb[i]));
+        }
+        store_quaternions(result + 4 * k, weighted_sum(wa, qa, wb, qb));
+    }
+#endif
+    for (; k < count; ++k) { out[k] = sp::slerp(a[k], b[k], t); }
+}
+
+template<class Quaternion, class Vector>
+void rotate_packed(Quaternion const * q, Vector const * in, std::size_t count,
+                   Vector * out)
+{
+    std::size_t k = 0;
+#if defined(__AVX__)
+    auto const * rotations = reinterpret_cast<float const *>(q);
+    auto const * from = reinterpret_cast<float const *>(in);
+    auto * to = reinterpret_cast<float *>(out);
+    __m256 const two = _mm256_set1_ps(2.f);
+    auto const cross = [](__m256 ay, __m256 az, __m256 by, __m256 bz) {
+        return _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(az, by));
+    };
+    for (; k + 8 <= count; k += 8) {
+        quaternions8 const r = load_quaternions(rotations + 4 * k);
+        __m256 vx, vy, vz;
+        load_points3(from + 3 * k, vx, vy, vz);
+
+        // v + w t + q × t, where t = 2 q × v
+        __m256 const tx = _mm256_mul_ps(two, cross(r.y, r.z, vy, vz));
+        __m256 const ty = _mm256_mul_ps(two, cross(r.z, r.x, vz, vx));
+        __m256 const tz = _mm256_mul_ps(two, cross(r.x, r.y, vx, vy));
+        store_points3(to + 3 * k,
+                      _mm256_add_ps(multiply_add(r.w, tx, vx), cross(r.y, r.z, ty, tz)),
+                      _mm256_add_ps(multiply_add(r.w, ty, vy), cross(r.z, r.x, tz, tx)),
+                      _mm256_add_ps(multiply_add(r.w, tz, vz), cross(r.x, r.y, tx, ty)));
+    }
+#endif
+    for (; k < count; ++k) { out[k] = sp::rotate(q[k], in[k]); }
+}
+}
+
+/** Normalize a range of quaternions.
+ *
+ * Return
+ *   An iterator past the last normalized quaternion.
+ *
+ * Parameters
+ *   quaternions - the quaternions to normalize
+ *   out - iterator to the start of the normalized quaternions, which may be
+ *         the start of the quaternions themselves
+ *
+ * Contiguous ranges of packed float quaternions are processed eight at a time
+ * with AVX when it's enabled, transposing each block of eight so that every
+ * register holds one component of eight quaternions.
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires quaternion<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out normalize(Range && quaternions, Out out)
+{
+    using Quaternion = ranges::range_value_t<Range>;
+    if constexpr (detail::packed_float_range<Range, 4> and
+                  detail::packed_float_output<Out, Quaternion>) {
+        auto const count = static_cast<std::size_t>(ranges::size(quaternions));
+        detail::normalize_packed(ranges::data(quaternions), count, std::to_address(out));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        for (auto const & q : quaternions) {
+            *out = normalize(q);
+            ++out;
+        }
+        return out;
+    }
+}
+
+/** Interpolate between two ranges of rotations pairwise with nlerp.
+ *
+ * Return
+ *   An iterator past the last interpolated rotation.
+ *
+ * Parameters
+ *   a, b - the rotations to interpolate between, where b is at least as long
+ *          as a
+ *   t - how far from each rotation in a to the matching one in b to go
+ *   out - iterator to the start of the interpolated rotations
+ */
+template<ranges::input_range A, ranges::input_range B, std::weakly_incrementable Out>
+    requires quaternion<ranges::range_value_t<A>> and
+             std::same_as<ranges::range_value_t<A>, ranges::range_value_t<B>> and
+             std::indirectly_writable<Out, ranges::range_value_t<A>>
+
+Out nlerp(A && a, B && b, scalar_field_t<ranges::range_value_t<A>> t, Out out)
+{
+    using Quaternion = ranges::range_value_t<A>;
+    if constexpr (detail::packed_float_range<A, 4> and
+                  detail::packed_float_range<B, 4> and
+                  detail::packed_float_output<Out, Quaternion>) {
+        auto const count = static_cast<std::size_t>(ranges::size(a));
+        detail::nlerp_packed(ranges::data(a), ranges::data(b), t, count,
+                             std::to_address(out));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        auto y = ranges::begin(b);
+        for (auto const & x : a) {
+            *out = nlerp(x, *y, t);
+            ++out;
+            ++y;
+        }
+        return out;
+    }
+}
+
+/** Interpolate between two ranges of unit rotations pairwise with slerp.
+ *
+ * Return
+ *   An iterator past the last interpolated rotation.
+ *
+ * Parameters
+ *   a, b - the rotations to interpolate between, where b is at least as long
+ *          as a
+ *   t - how far from each rotation in a to the matching one in b to go
+ *   out - iterator to the start of the interpolated rotations
+ *
+ * Contiguous ranges of packed float quaternions are interpolated eight at a
+ * time with AVX when it's enabled. The weights of each pair are evaluated as
+ * polynomials in the cosine between them instead of with trigonometry, which
+ * is as accurate as the scalar slerp in single precision.
+ */
+template<ranges::input_range A, ranges::input_range B, std::weakly_incrementable Out>
+    requires quaternion<ranges::range_value_t<A>> and
+             std::same_as<ranges::range_value_t<A>, ranges::range_value_t<B>> and
+             std::indirectly_writable<Out, ranges::range_value_t<A>>
+
+Out slerp(A && a, B && b, scalar_field_t<ranges::range_value_t<A>> t, Out out)
+{
+    using Quaternion = ranges::range_value_t<A>;
+    if constexpr (detail::packed_float_range<A, 4> and
+                  detail::packed_float_range<B, 4> and
+                  detail::packed_float_output<Out, Quaternion>) {
+        auto const count = static_cast<std::size_t>(ranges::size(a));
+        detail::slerp_packed(ranges::data(a), ranges::data(b), t, count,
+                             std::to_address(out));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        auto y = ranges::begin(b);
+        for (auto const & x : a) {
+            *out = slerp(x, *y, t);
+            ++out;
+            ++y;
+        }
+        return out;
+    }
+}
+
+/** Rotate each of a range of vectors by the matching unit quaternion.
+ *
+ * Return
+ *   An iterator past the last rotated vector.
+ *
+ * Parameters
+ *   rotations - the quaternions to rotate by, at least as many as vectors
+ *   vectors - the vectors to rotate
+ *   out - iterator to the start of the rotated vectors, which may be the start
+ *         of the vectors themselves
+ */
+template<ranges::input_range Rotations, ranges::input_range Range,
+         std::weakly_incrementable Out>
+    requires quaternion<ranges::range_value_t<Rotations>> and
+             semivector3<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out rotate(Rotations && rotations, Range && vectors, Out out)
+{
+    using Vector = ranges::range_value_t<Range>;
+    if constexpr (detail::packed_float_range<Rotations, 4> and
+                  detail::packed_float_range<Range, 3> and
+                  detail::packed_float_output<Out, Vector>) {
+        auto const count = static_cast<std::size_t>(ranges::size(vectors));
+        detail::rotate_packed(ranges::data(rotations), ranges::data(vectors), count,
+                              std::to_address(out));
+        return out + static_cast<std::iter_difference_t<Out>>(count);
+    }
+    else {
+        auto q = ranges::begin(rotations);
+        for (auto const & v : vectors) {
+            *out = rotate(*q, v);
+            ++out;
+            ++q;
+        }
+        return out;
+    }
+}
+
+/** Rotate a range of vectors by the same quaternion, which is converted to a
+ * matrix once and applied with transform_points.
+ */
+template<quaternion Quaternion, ranges::input_range Range,
+         std::weakly_incrementable Out>
+    requires semivector3<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out rotate(Quaternion const & q, Range && vectors, Out out)
+{
+    return transform_points(to_affine(q), vectors, out);
+}
+}
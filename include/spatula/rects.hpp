@@ -0,0 +1,556 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "spatula/grids.hpp"
+
+// algorithms
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace sp {
+
+/** An axis-aligned rectangle with a corner (x, y), a width w and a height h.
+ *
+ * Example:
+ *     static_assert(sp::rectangle<SDL_Rect>);
+ *     static_assert(sp::rectangle<SDL_FRect>);
+ *
+ *   A rectangle is empty if its width or height isn't positive, and it covers
+ *   the points in [x, x + w) × [y, y + h).
+ */
+template<class Rect>
+concept rectangle = std::semiregular<Rect> and requires(Rect r) {
+    requires std::is_arithmetic_v<decltype(r.x)>;
+    requires std::same_as<decltype(r.x), decltype(r.y)>;
+    requires std::same_as<decltype(r.x), decltype(r.w)>;
+    requires std::same_as<decltype(r.x), decltype(r.h)>;
+    Rect{r.x, r.y, r.w, r.h};
+};
+
+/** The scalar type of the components of a rectangle. */
+template<rectangle Rect>
+using rect_scalar_t = decltype(std::declval<Rect &>().x);
+
+//
+// Rectangle operations
+//
+
+/** Determine if a rectangle covers no area. */
+template<rectangle Rect>
+constexpr bool is_empty(Rect const & r)
+{
+    return not (r.w > 0 and r.h > 0);
+}
+
+/** Determine if two non-empty rectangles share any area. */
+template<rectangle Rect>
+constexpr bool overlaps(Rect const & a, Rect const & b)
+{
+    return not is_empty(a) and not is_empty(b) and
+           a.x < b.x + b.w and b.x < a.x + a.w and
+           a.y < b.y + b.h and b.y < a.y + a.h;
+}
+
+/** The area shared by two rectangles, with zero width and height if they
+ * don't overlap.
+ */
+template<rectangle Rect>
+constexpr Rect intersection(Rect const & a, Rect const & b)
+{
+    using scalar = rect_scalar_t<Rect>;
+    scalar const x0 = std::max(a.x, b.x);
+    scalar const y0 = std::max(a.y, b.y);
+    scalar const x1 = std::min(a.x + a.w, b.x + b.w);
+    scalar const y1 = std::min(a.y + a.h, b.y + b.h);
+    if (not (x1 > x0 and y1 > y0) or is_empty(a) or is_empty(b)) {
+        return Rect{x0, y0, scalar{0}, scalar{0}};
+    }
+    return Rect{x0, y0, static_cast<scalar>(x1 - x0), static_cast<scalar>(y1 - y0)};
+}
+
+/** The smallest rectangle that contains two rectangles. Empty rectangles are
+ * ignored.
+ */
+template<rectangle Rect>
+constexpr Rect bounding_rect(Rect const & a, Rect const & b)
+{
+    using scalar = rect_scalar_t<Rect>;
+    if (is_empty(a)) { return b; }
+    if (is_empty(b)) { return a; }
+    scalar const x0 = std::min(a.x, b.x);
+    scalar const y0 = std::min(a.y, b.y);
+    scalar const x1 = std::max(a.x + a.w, b.x + b.w);
+    scalar const y1 = std::max(a.y + a.h, b.y + b.h);
+    return Rect{x0, y0, static_cast<scalar>(x1 - x0), static_cast<scalar>(y1 - y0)};
+}
+
+namespace detail {
+
+// the edges of rectangles stored as separate arrays, with empty rectangles
+// given edges that never overlap anything
+template<class Scalar>
+struct rect_edges {
+    std::vector<Scalar> x0, y0, x1, y1;
+
+    std::size_t size() const { return x0.size(); }
+
+    template<class Rect>
+    void push_back(Rect const & r)
+    {
+        x0.push_back(r.x);
+        y0.push_back(r.y);
+        if (is_empty(r)) {
+            x1.push_back(std::numeric_limits<Scalar>::lowest());
+            y1.push_back(std::numeric_limits<Scalar>::lowest());
+        }
+        else {
+            x1.push_back(static_cast<Scalar>(r.x + r.w));
+            y1.push_back(static_cast<Scalar>(r.y + r.h));
+        }
+    }
+    void erase(std::size_t i)
+    {
+        for (auto * edges : {&x0, &y0, &x1, &y1}) {
+            (*edges)[i] = edges->back();
+            edges->pop_back();
+        }
+    }
+};
+
+// SDL_Rect and friends: four 32-bit integers stored in x, y, w, h order
+template<class Rect>
+constexpr bool is_simd_rect = [] {
+    if constexpr (std::same_as<rect_scalar_t<Rect>, std::int32_t> and
+                  std::is_standard_layout_v<Rect> and
+                  sizeof(Rect) == 4 * sizeof(std::int32_t)) {
+        return offsetof(Rect, x) == 0 and offsetof(Rect, y) == 4 and
+               offsetof(Rect, w) == 8 and offsetof(Rect, h) == 12;
+    }
+    else {
+        return false;
+    }
+}();
+
+// set count bits of a packed bit array starting at a bit index
+inline void or_bits(std::uint64_t * words, std::size_t index, std::uint64_t bits)
+{
+    std::size_t const offset = index % 64;
+    words[index / 64] |= bits << offset;
+    if (offset != 0 and (bits >> (64 - offset)) != 0) {
+        words[index / 64 + 1] |= bits >> (64 - offset);
+    }
+}
+
+#if defined(__SSE2__)
+
+inline __m128i max_epi32(__m128i a, __m128i b)
+{
+#if defined(__SSE4_1__)
+    return _mm_max_epi32(a, b);
+#else
+    __m128i const greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+#endif
+}
+
+inline __m128i min_epi32(__m128i a, __m128i b)
+{
+#if defined(__SSE4_1__)
+    return _mm_min_epi32(a, b);
+#else
+    __m128i const greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+#endif
+}
+
+// four rectangles transposed from (x, y, w, h) records into one register per
+// component
+struct rect_block4 {
+    __m128i x, y, w, h;
+};
+
+inline rect_block4 load_rects4(void const * rects)
+{
+    auto const * p = static_cast<__m128i const *>(rects);
+    __m128i const r0 = _mm_loadu_si128(p);
+    __m128i const r1 = _mm_loadu_si128(p + 1);
+    __m128i const r2 = _mm_loadu_si128(p + 2);
+    __m128i const r3 = _mm_loadu_si128(p + 3);
+
+    __m128i const xy01 = _mm_unpacklo_epi32(r0, r1);
+    __m128i const xy23 = _mm_unpacklo_epi32(r2, r3);
+    __m128i const wh01 = _mm_unpackhi_epi32(r0, r1);
+    __m128i const wh23 = _mm_unpackhi_epi32(r2, r3);
+    return {_mm_unpacklo_epi64(xy01, xy23), _mm_unpackhi_epi64(xy01, xy23),
+            _mm_unpacklo_epi64(wh01, wh23), _mm_unpackhi_epi64(wh01, wh23)};
+}
+
+inline void store_rects4(void * rects, rect_block4 const & block)
+{
+    auto * p = static_cast<__m128i *>(rects);
+    __m128i const xy01 = _mm_unpacklo_epi32(block.x, block.y);
+    __m128i const xy23 = _mm_unpackhi_epi32(block.x, block.y);
+    __m128i const wh01 = _mm_unpacklo_epi32(block.w, block.h);
+    __m128i const wh23 = _mm_unpackhi_epi32(block.w, block.h);
+    _mm_storeu_si128(p, _mm_unpacklo_epi64(xy01, wh01));
+    _mm_storeu_si128(p + 1, _mm_unpackhi_epi64(xy01, wh01));
+    _mm_storeu_si128(p + 2, _mm_unpacklo_epi64(xy23, wh23));
+    _mm_storeu_si128(p + 3, _mm_unpackhi_epi64(xy23, wh23));
+}
+
+// a lane mask of the non-empty rectangles of a block that overlap the
+// rectangle with edges [x0, x1) × [y0, y1)
+inline __m128i overlap_mask4(rect_block4 const & block,
+                             __m128i x0, __m128i y0, __m128i x1, __m128i y1)
+{
+    __m128i const zero = _mm_setzero_si128();
+    __m128i const bx1 = _mm_add_epi32(block.x, block.w);
+    __m128i const by1 = _mm_add_epi32(block.y, block.h);
+    __m128i mask = _mm_and_si128(_mm_cmpgt_epi32(block.w, zero),
+                                 _mm_cmpgt_epi32(block.h, zero));
+    mask = _mm_and_si128(mask, _mm_cmplt_epi32(block.x, x1));
+    mask = _mm_and_si128(mask, _mm_cmplt_epi32(x0, bx1));
+    mask = _mm_and_si128(mask, _mm_cmplt_epi32(block.y, y1));
+    mask = _mm_and_si128(mask, _mm_cmplt_epi32(y0, by1));
+    return mask;
+}
+
+inline int movemask_epi32(__m128i mask)
+{
+    return _mm_movemask_ps(_mm_castsi128_ps(mask));
+}
+
+#endif
+}
+
+//
+// Batch operations
+//
+
+/** Clip rectangles to a viewport.
+ *
+ * Return
+ *   An iterator past the last clipped rectangle.
+ *
+ * Parameters
+ *   rects - the rectangles to clip
+ *   viewport - the rectangle to clip to
+ *   out - iterator to the start of the clipped rectangles, one per input
+ *         rectangle; rectangles outside of the viewport are given zero width
+ *         and height
+ *
+ * Rectangles of four 32-bit integers, like SDL_Rect, are clipped four at a
+ * time with SSE2 into contiguous output.
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires rectangle<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, ranges::range_value_t<Range>>
+
+Out clip_rects(Range && rects, ranges::range_value_t<Range> const & viewport,
+               Out out)
+{
+    auto first = ranges::begin(rects);
+    auto const last = ranges::end(rects);
+
+#if defined(__SSE2__)
+    using Rect = ranges::range_value_t<Range>;
+    if constexpr (detail::is_simd_rect<Rect> and
+                  ranges::contiguous_range<Range> and ranges::sized_range<Range> and
+                  std::contiguous_iterator<Out>) {
+        if (is_empty(viewport)) {
+            return ranges::transform(first, last, out, [&](Rect const & r) {
+                return intersection(r, viewport);
+            }).out;
+        }
+        __m128i const vx0 = _mm_set1_epi32(viewport.x);
+        __m128i const vy0 = _mm_set1_epi32(viewport.y);
+        __m128i const vx1 = _mm_set1_epi32(viewport.x + viewport.w);
+        __m128i const vy1 = _mm_set1_epi32(viewport.y + viewport.h);
+
+        std::size_t const blocks = ranges::size(rects) / 4;
+        Rect const * in = ranges::data(rects);
+        Rect * dst = std::to_address(out);
+        for (std::size_t b = 0; b < blocks; ++b, in += 4, dst += 4) {
+            auto const block = detail::load_rects4(in);
+            __m128i const x0 = detail::max_epi32(block.x, vx0);
+            __m128i const y0 = detail::max_epi32(block.y, vy0);
+            __m128i const x1 = detail::min_epi32(_mm_add_epi32(block.x, block.w), vx1);
+            __m128i const y1 = detail::min_epi32(_mm_add_epi32(block.y, block.h), vy1);
+
+            // rectangles that don't overlap, including empty ones, get no area
+            __m128i const overlap = detail::overlap_mask4(block, vx0, vy0, vx1, vy1);
+            __m128i const w = _mm_and_si128(overlap, _mm_sub_epi32(x1, x0));
+            __m128i const h = _mm_and_si128(overlap, _mm_sub_epi32(y1, y0));
+            detail::store_rects4(dst, {x0, y0, w, h});
+        }
+        first += static_cast<std::ptrdiff_t>(blocks * 4);
+        out += static_cast<std::iter_difference_t<Out>>(blocks * 4);
+    }
+#endif
+    for (; first != last; ++first, ++out) {
+        *out = intersection(*first, viewport);
+    }
+    return out;
+}
+
+/** Find the rectangles that overlap a viewport.
+ *
+ * Return
+ *   An iterator past the last written index.
+ *
+ * Parameters
+ *   rects - the rectangles to cull
+ *   viewport - the visible area
+ *   out - iterator to the start of the indices of the visible rectangles, in
+ *         increasing order
+ *
+ * Rectangles of four 32-bit integers, like SDL_Rect, are tested four at a
+ * time with SSE2, or eight at a time when compiled with AVX2.
+ */
+template<ranges::input_range Range, std::weakly_incrementable Out>
+    requires rectangle<ranges::range_value_t<Range>> and
+             std::indirectly_writable<Out, std::size_t>
+
+Out cull_rects(Range && rects, ranges::range_value_t<Range> const & viewport,
+               Out out)
+{
+    if (is_empty(viewport)) { return out; }
+    std::size_t i = 0;
+    auto first = ranges::begin(rects);
+    auto const last = ranges::end(rects);
+
+#if defined(__SSE2__)
+    using Rect = ranges::range_value_t<Range>;
+    if constexpr (detail::is_simd_rect<Rect> and
+                  ranges::contiguous_range<Range> and ranges::sized_range<Range>) {
+        __m128i const vx0 = _mm_set1_epi32(viewport.x);
+        __m128i const vy0 = _mm_set1_epi32(viewport.y);
+        __m128i const vx1 = _mm_set1_epi32(viewport.x + viewport.w);
+        __m128i const vy1 = _mm_set1_epi32(viewport.y + viewport.h);
+
+        std::size_t const count = ranges::size(rects);
+        Rect const * in = ranges::data(rects);
+        auto const write_indices = [&](unsigned mask) {
+            for (; mask != 0; mask &= mask - 1) {
+                *out = i + static_cast<std::size_t>(std::countr_zero(mask));
+                ++out;
+            }
+        };
+#if defined(__AVX2__)
+        for (; i + 8 <= count; i += 8) {
+            auto const lo = detail::load_rects4(in + i);
+            auto const hi = detail::load_rects4(in + i + 4);
+            __m128i const mask_lo = detail::overlap_mask4(lo, vx0, vy0, vx1, vy1);
+            __m128i const mask_hi = detail::overlap_mask4(hi, vx0, vy0, vx1, vy1);
+            __m256i const mask = _mm256_set_m128i(mask_hi, mask_lo);
+            write_indices(static_cast<unsigned>(
+                _mm256_movemask_ps(_mm256_castsi256_ps(mask))));
+        }
+#endif
+        for (; i + 4 <= count; i += 4) {
+            auto const block = detail::load_rects4(in + i);
+            __m128i const mask = detail::overlap_mask4(block, vx0, vy0, vx1, vy1);
+            write_indices(static_cast<unsigned>(detail::movemask_epi32(mask)));
+        }
+        first += static_cast<std::ptrdiff_t>(i);
+    }
+#endif
+    for (; first != last; ++first, ++i) {
+        if (overlaps(*first, viewport)) {
+            *out = i;
+            ++out;
+        }
+    }
+    return out;
+}
+
+/** Determine which pairs of rectangles overlap.
+ *
+ * Parameters
+ *   rows - the rectangles to test
+ *   columns - the rectangles to test against
+ *   mask - resized to columns.size() × rows.size(); the bit (j, i) is set if
+ *          rows[i] overlaps columns[j]
+ *
+ * The columns are transposed into separate edge arrays once, and each row is
+ * then tested against eight columns at a time with AVX2, or four with SSE2.
+ */
+template<ranges::forward_range RowRange, ranges::forward_range ColumnRange>
+    requires rectangle<ranges::range_value_t<RowRange>> and
+             std::same_as<ranges::range_value_t<RowRange>,
+                          ranges::range_value_t<ColumnRange>>
+
+void overlap_mask(RowRange && rows, ColumnRange && columns, bit_grid & mask)
+{
+    using Rect = ranges::range_value_t<RowRange>;
+    using scalar = rect_scalar_t<Rect>;
+
+    detail::rect_edges<scalar> edges;
+    for (auto const & r : columns) { edges.push_back(r); }
+    std::size_t const width = edges.size();
+    mask.resize(width, static_cast<std::size_t>(ranges::distance(rows)));
+    if (width == 0) { return; }
+
+    std::size_t row = 0;
+    for (auto const & r : rows) {
+        std::size_t const start = row++ * width;
+        if (is_empty(r)) { continue; }
+        scalar const x0 = r.x, y0 = r.y;
+        scalar const x1 = r.x + r.w, y1 = r.y + r.h;
+
+        std::size_t j = 0;
+#if defined(__SSE2__)
+        if constexpr (std::same_as<scalar, std::int32_t>) {
+            auto const * ex0 = edges.x0.data();
+            auto const * ey0 = edges.y0.data();
+            auto const * ex1 = edges.x1.data();
+            auto const * ey1 = edges.y1.data();
+#if defined(__AVX2__)
+            __m256i const wx0 = _mm256_set1_epi32(x0), wy0 = _mm256_set1_epi32(y0);
+            __m256i const wx1 = _mm256_set1_epi32(x1), wy1 = _mm256_set1_epi32(y1);
+            for (; j + 8 <= width; j += 8) {
+                auto const load = [j](std::int32_t const * p) {
+                    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p + j));
+                };
+                __m256i m = _mm256_cmpgt_epi32(wx1, load(ex0));
+                m = _mm256_and_si256(m, _mm256_cmpgt_epi32(load(ex1), wx0));
+                m = _mm256_and_si256(m, _mm256_cmpgt_epi32(wy1, load(ey0)));
+                m = _mm256_and_si256(m, _mm256_cmpgt_epi32(load(ey1), wy0));
+                auto const bits = static_cast<unsigned>(
+                    _mm256_movemask_ps(_mm256_castsi256_ps(m)));
+                if (bits != 0) { detail::or_bits(mask.data(), start + j, bits); }
+            }
+#endif
+            __m128i const rx0 = _mm_set1_epi32(x0), ry0 = _mm_set1_epi32(y0);
+            __m128i const rx1 = _mm_set1_epi32(x1), ry1 = _mm_set1_epi32(y1);
+            for (; j + 4 <= width; j += 4) {
+                auto const load = [j](std::int32_t const * p) {
+                    return _mm_loadu_si128(reinterpret_cast<__m128i const *>(p + j));
+                };
+                __m128i m = _mm_cmpgt_epi32(rx1, load(ex0));
+                m = _mm_and_si128(m, _mm_cmpgt_epi32(load(ex1), rx0));
+                m = _mm_and_si128(m, _mm_cmpgt_epi32(ry1, load(ey0)));
+                m = _mm_and_si128(m, _mm_cmpgt_epi32(load(ey1), ry0));
+                auto const bits = static_cast<unsigned>(detail::movemask_epi32(m));
+                if (bits != 0) { detail::or_bits(mask.data(), start + j, bits); }
+            }
+        }
+#endif
+        for (; j < width; ++j) {
+            if (edges.x0[j] < x1 and x0 < edges.x1[j] and
+                edges.y0[j] < y1 and y0 < edges.y1[j]) {
+                detail::or_bits(mask.data(), start + j, 1);
+            }
+        }
+    }
+}
+
+/** The smallest rectangle containing every non-empty rectangle of a range, or
+ * an empty rectangle if there are none.
+ */
+template<ranges::input_range Range>
+    requires rectangle<ranges::range_value_t<Range>>
+
+auto bounding_rect(Range && rects)
+{
+    using Rect = ranges::range_value_t<Range>;
+    Rect bounds{};
+    for (auto const & r : rects) { bounds = bounding_rect(bounds, r); }
+    return bounds;
+}
+
+/** Merge overlapping rectangles, such as the dirty regions of a frame.
+ *
+ * Return
+ *   Rectangles that cover every non-empty input rectangle, where no two of
+ *   them overlap. Each rectangle is the bounding rectangle of a group of input
+ *   rectangles that overlap transitively.
+ *
+ * Parameters
+ *   rects - the rectangles to merge
+ *
+ * Merged rectangles are kept as separate edge arrays, so each new rectangle
+ * is tested against them eight at a time with AVX2, or four with SSE2.
+ */
+template<ranges::input_range Range>
+    requires rectangle<ranges::range_value_t<Range>>
+
+std::vector<ranges::range_value_t<Range>> merge_rects(Range && rects)
+{
+    using Rect = ranges::range_value_t<Range>;
+    using scalar = rect_scalar_t<Rect>;
+    detail::rect_edges<scalar> merged;
+
+    // the index of a merged rectangle that overlaps [x0, x1) × [y0, y1)
+    auto const find_overlap = [&](scalar x0, scalar y0, scalar x1, scalar y1) {
+        std::size_t const count = merged.size();
+        std::size_t j = 0;
+#if defined(__SSE2__)
+        if constexpr (std::same_as<scalar, std::int32_t>) {
+            __m128i const rx0 = _mm_set1_epi32(x0), ry0 = _mm_set1_epi32(y0);
+            __m128i const rx1 = _mm_set1_epi32(x1), ry1 = _mm_set1_epi32(y1);
+            for (; j + 4 <= count; j += 4) {
+                auto const load = [j](std::vector<std::int32_t> const & edge) {
+                    return _mm_loadu_si128(
+                        reinterpret_cast<__m128i const *>(edge.data() + j));
+                };
+                __m128i m = _mm_cmpgt_epi32(rx1, load(merged.x0));
+                m = _mm_and_si128(m, _mm_cmpgt_epi32(load(merged.x1), rx0));
+                m = _mm_and_si128(m, _mm_cmpgt_epi32(ry1, load(merged.y0)));
+                m = _mm_and_si128(m, _mm_cmpgt_epi32(load(merged.y1), ry0));
+                auto const bits = static_cast<unsigned>(detail::movemask_epi32(m));
+                if (bits != 0) {
+                    return j + static_cast<std::size_t>(std::countr_zero(bits));
+                }
+            }
+        }
+#endif
+        for (; j < count; ++j) {
+            if (merged.x0[j] < x1 and x0 < merged.x1[j] and
+                merged.y0[j] < y1 and y0 < merged.y1[j]) { return j; }
+        }
+        return count;
+    };
+
+    for (auto const & r : rects) {
+        if (is_empty(r)) { continue; }
+        scalar x0 = r.x, y0 = r.y;
+        scalar x1 = r.x + r.w, y1 = r.y + r.h;
+
+        // absorb merged rectangles until nothing overlaps the growing union
+        for (std::size_t j; (j = find_overlap(x0, y0, x1, y1)) != merged.size();) {
+            x0 = std::min(x0, merged.x0[j]);
+            y0 = std::min(y0, merged.y0[j]);
+            x1 = std::max(x1, merged.x1[j]);
+            y1 = std::max(y1, merged.y1[j]);
+            merged.erase(j);
+        }
+        merged.push_back(Rect{x0, y0, static_cast<scalar>(x1 - x0),
+                              static_cast<scalar>(y1 - y0)});
+    }
+
+    std::vector<Rect> result;
+    result.reserve(merged.size());
+    for (std::size_t j = 0; j < merged.size(); ++j) {
+        result.push_back(Rect{merged.x0[j], merged.y0[j],
+                              static_cast<scalar>(merged.x1[j] - merged.x0[j]),
+                              static_cast<scalar>(merged.y1[j] - merged.y0[j])});
+    }
+    return result;
+}
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+// type constraints
+#include <concepts>
+#include "spatula/vectors.hpp"
+#include "spatula/directions.hpp"
+#include "spatula/grids.hpp"
+
+// data types and data structures
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include "spatula/parallel.hpp"
+
+namespace sp {
+
+/** Summary statistics of a connected component of grid cells. */
+template<grid_point Vector>
+struct component_stats {
+    /** The amount of cells in the component. */
+    std::size_t size = 0;
+    /** The bounding corners (lower-left, upper-right) of the component. */
+    std::pair<Vector, Vector> corners{};
+};
+
+/** The connected components of a grid.
+ *
+ * Each cell of labels is 0 if it belongs to the background, or the 1-based
+ * index of its component otherwise. Components are numbered in the order of
+ * their first cell in row-major order.
+ */
+template<grid_point Vector>
+struct component_labels {
+    grid<std::uint32_t> labels;
+    std::vector<component_stats<Vector>> components;
+};
+
+namespace detail {
+
+// connectivity offsets that come before a cell in row-major order
+template<ranged_enum Connectivity>
+constexpr auto preceding_offsets()
+{
+    constexpr auto const & offsets = direction_offsets_v<Connectivity>;
+    constexpr std::size_t N = std::ranges::count_if(offsets, [](auto const & d) {
+        return d[1] < 0 or (d[1] == 0 and d[0] < 0);
+    });
+    std::array<std::array<int, 2>, N> preceding{};
+    std::ranges::copy_if(offsets, preceding.begin(), [](auto const & d) {
+        return d[1] < 0 or (d[1] == 0 and d[0] < 0);
+    });
+    return preceding;
+}
+
+struct region_bounds {
+    std::size_t size = 0;
+    std::size_t x0 = 0, y0 = 0;
+    std::size_t x1 = 0, y1 = 0;
+
+    void add(std::size_t x, std::size_t y)
+    {
+        if (size++ == 0) { x0 = x1 = x; y0 = y1 = y; return; }
+        x0 = std::min(x0, x); x1 = std::max(x1, x);
+        y0 = std::min(y0, y); y1 = std::max(y1, y);
+    }
+    void add(region_bounds const & other)
+    {
+        if (size == 0) { *this = other; return; }
+        size += other.size;
+        x0 = std::min(x0, other.x0); x1 = std::max(x1, other.x1);
+        y0 = std::min(y0, other.y0); y1 = std::max(y1, other.y1);
+    }
+};
+
+// union-find over cell indices where every root is the least index of its set
+inline std::uint32_t find_root(std::vector<std::uint32_t> & parent,
+                               std::uint32_t i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+inline void unite(std::vector<std::uint32_t> & parent,
+                  std::uint32_t a, std::uint32_t b)
+{
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if (a < b) { parent[b] = a; }
+    else if (b < a) { parent[a] = b; }
+}
+
+// thread-safe variants, used while different bands are merged concurrently
+inline std::uint32_t find_root_atomic(std::vector<std::uint32_t> & parent,
+                                      std::uint32_t i)
+{
+    for (;;) {
+        std::uint32_t const p =
+            std::atomic_ref(parent[i]).load(std::memory_order_acquire);
+        if (p == i) { return i; }
+        i = p;
+    }
+}
+
+inline void unite_atomic(std::vector<std::uint32_t> & parent,
+                         std::uint32_t a, std::uint32_t b)
+{
+    for (;;) {
+        a = find_root_atomic(parent, a);
+        b = find_root_atomic(parent, b);
+        if (a == b) { return; }
+        if (a < b) { std::swap(a, b); }
+
+        // link the larger root under the smaller, unless another thread has
+        // linked it somewhere in the meantime
+        std::uint32_t expected = a;
+        if (std::atomic_ref(parent[a]).compare_exchange_strong(
+                expected, b, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+}
+}
+
+/** Label the connected components of a grid.
+ *
+ * Return
+ *   A label grid the same size as cells, and the size and bounding corners of
+ *   each component.
+ *
+ * Parameters
+ *   cells - the grid to label
+ *   is_foreground - thread-safe predicate determining if a cell belongs to a
+ *                   component; other cells are background
+ *   workers - the maximum amount of threads to label with
+ *
+ * Template Parameters
+ *   Connectivity - a direction enum whose offsets define which cells are
+ *                  adjacent: sp::cardinal for 4-connected square grids,
+ *                  sp::ordinal for 8-connected square grids, or sp::flat_hex
+ *                  or sp::pointed_hex for axial hex grids
+ *   Vector - the type of the bounding corners
+ *
+ * The grid is split into horizontal bands that are labeled in parallel with
+ * union-find. Bands are then merged across their borders in parallel with a
+ * lock-free union, and finally relabeled in parallel. Labels are independent
+ * of the amount of threads used.
+ */
+template<ranged_enum Connectivity, grid_point Vector, class T,
+         std::predicate<T const &> Foreground>
+    requires has_direction_offsets<Connectivity> and
+             (direction_dimension_v<Connectivity> == 2)
+
+component_labels<Vector>
+label_components(grid<T> const & cells, Foreground && is_foreground,
+                 std::size_t workers = worker_count())
+{
+    using scalar = scalar_field_t<Vector>;
+    constexpr auto preceding = detail::preceding_offsets<Connectivity>();
+
+    std::size_t const width = cells.width();
+    std::size_t const height = cells.height();
+    component_labels<Vector> result{grid<std::uint32_t>(width, height), {}};
+    if (cells.size() == 0) { return result; }
+
+    auto & labels = result.labels;
+    std::vector<std::uint32_t> parent(cells.size());
+
+    // split the rows into one band per worker
+    std::size_t const bands = std::clamp<std::size_t>(workers, 1, height);
+    std::vector<std::size_t> band_rows(bands + 1);
+    for (std::size_t b = 0; b <= bands; ++b) {
+        band_rows[b] = b * height / bands;
+    }
+    std::vector<std::vector<std::uint32_t>> band_roots(bands);
+    std::vector<std::vector<detail::region_bounds>> band_bounds(bands);
+
+    // label each band independently, leaving band-local ids in labels
+    parallel_for(bands, [&](std::size_t b, std::size_t, std::size_t) {
+        std::size_t const first = band_rows[b], last = band_rows[b + 1];
+        for (std::size_t y = first; y < last; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            auto const i = static_cast<std::uint32_t>(y * width + x);
+            if (not is_foreground(cells(x, y))) { labels(x, y) = 0; continue; }
+
+            labels(x, y) = 1;
+            parent[i] = i;
+            for (auto const & [dx, dy] : preceding) {
+                auto const nx = static_cast<std::ptrdiff_t>(x) + dx;
+                auto const ny = static_cast<std::ptrdiff_t>(y) + dy;
+                if (nx < 0 or static_cast<std::size_t>(nx) >= width or
+                    ny < static_cast<std::ptrdiff_t>(first)) { continue; }
+                if (labels(nx, ny) != 0) {
+                    detail::unite(parent, i,
+                        static_cast<std::uint32_t>(ny * width + nx));
+                }
+            }
+        }}
+
+        // roots are the least index of their set, so they're always found
+        // before the rest of their set
+        auto & roots = band_roots[b];
+        auto & bounds = band_bounds[b];
+        for (std::size_t y = first; y < last; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            if (labels(x, y) == 0) { continue; }
+            auto const i = static_cast<std::uint32_t>(y * width + x);
+            std::uint32_t const root = detail::find_root(parent, i);
+            if (root == i) {
+                roots.push_back(i);
+                bounds.emplace_back();
+                labels(x, y) = static_cast<std::uint32_t>(roots.size());
+            }
+            else {
+                labels(x, y) = labels.data()[root];
+            }
+            bounds[labels(x, y) - 1].add(x, y);
+        }}
+    }, bands);
+
+    // merge the components that touch across band borders
+    parallel_for(bands - 1, [&](std::size_t, std::size_t first, std::size_t last) {
+        for (std::size_t b = first + 1; b <= last; ++b) {
+            std::size_t const y = band_rows[b];
+            for (std::size_t x = 0; x < width; ++x) {
+                if (labels(x, y) == 0) { continue; }
+                for (auto const & [dx, dy] : preceding) {
+                    auto const nx = static_cast<std::ptrdiff_t>(x) + dx;
+                    auto const ny = static_cast<std::ptrdiff_t>(y) + dy;
+                    if (dy == 0 or nx < 0 or
+                        static_cast<std::size_t>(nx) >= width) { continue; }
+                    if (labels(nx, ny) != 0) {
+                        detail::unite_atomic(parent,
+                            static_cast<std::uint32_t>(y * width + x),
+                            static_cast<std::uint32_t>(ny * width + nx));
+                    }
+                }
+            }
+        }
+    }, workers);
+
+    // number the components in order of their roots
+    std::vector<std::vector<std::uint32_t>> band_labels(bands);
+    std::vector<detail::region_bounds> bounds;
+    for (std::size_t b = 0; b < bands; ++b) {
+        auto const & roots = band_roots[b];
+        band_labels[b].resize(roots.size());
+        for (std::size_t id = 0; id < roots.size(); ++id) {
+            std::uint32_t const root = detail::find_root(parent, roots[id]);
+            std::uint32_t label;
+            if (root == roots[id]) {
+                bounds.emplace_back();
+                label = static_cast<std::uint32_t>(bounds.size());
+            }
+            else {
+                auto const row = root / width;
+                auto const root_band = static_cast<std::size_t>(
+                    std::ranges::upper_bound(band_rows, row) - band_rows.begin()) - 1;
+                label = band_labels[root_band][labels.data()[root] - 1];
+            }
+            band_labels[b][id] = label;
+            bounds[label - 1].add(band_bounds[b][id]);
+        }
+    }
+
+    // replace band-local ids with component labels
+    parallel_for(bands, [&](std::size_t b, std::size_t, std::size_t) {
+        auto const & local = band_labels[b];
+        for (std::size_t y = band_rows[b]; y < band_rows[b + 1]; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            if (labels(x, y) != 0) { labels(x, y) = local[labels(x, y) - 1]; }
+        }}
+    }, bands);
+
+    result.components.reserve(bounds.size());
+    for (auto const & region : bounds) {
+        result.components.push_back({region.size, {
+            Vector{static_cast<scalar>(region.x0), static_cast<scalar>(region.y0)},
+            Vector{static_cast<scalar>(region.x1), static_cast<scalar>(region.y1)}
+        }});
+    }
+    return result;
+}
+
+/** Label the connected components of the cells not equal to T{}. */
+template<ranged_enum Connectivity, grid_point Vector, std::equality_comparable T>
+    requires has_direction_offsets<Connectivity> and
+             (direction_dimension_v<Connectivity> == 2)
+
+component_labels<Vector> label_components(grid<T> const & cells)
+{
+    return label_components<Connectivity, Vector>(cells, [](T const & cell) {
+        return cell != T{};
+    });
+}
+}
@@ -0,0 +1,299 @@
+#pragma once
+
+// type constraints
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+#include "spatula/directions.hpp"
+#include "spatula/grids.hpp"
+
+// data types and data structures
+#include <cstddef>
+#include <array>
+
+// algorithms
+#include <algorithm>
+
+namespace sp {
+
+/** The shape of a ring of grid cells around a center.
+ *
+ * A ring of radius k starts at center + k * start, then walks each of the
+ * sides in order, taking k * side_length steps along each of them.
+ */
+template<std::size_t Sides>
+struct ring_shape {
+    std::array<int, 2> start;
+    std::array<std::array<int, 2>, Sides> sides;
+    int side_length;
+
+    /** The amount of cells in a ring of radius k, or none if k is negative. */
+    constexpr std::size_t size(int k) const
+    {
+        if (k < 0) { return 0; }
+        return k == 0? 1 : Sides * static_cast<std::size_t>(k * side_length);
+    }
+};
+
+/** The ring shape of a hexagonal direction enum.
+ *
+ * Consecutive directions of Enum must be adjacent, either clockwise or
+ * counter-clockwise.
+ */
+template<ranged_enum Enum>
+    requires (enum_size_v<Enum> == 6)
+constexpr ring_shape<6> hex_ring_shape()
+{
+    auto const & directions = direction_offsets_v<Enum>;
+    return {directions[4], directions, 1};
+}
+
+/** The diamond-shaped ring of cells at equal manhattan distance. */
+constexpr ring_shape<4> manhattan_ring_shape()
+{
+    auto const & directions = direction_offsets_v<cardinal::direction_name>;
+    ring_shape<4> shape{directions[0], {}, 1};
+    for (std::size_t i = 0; i < 4; ++i) {
+        auto const & [x0, y0] = directions[i];
+        auto const & [x1, y1] = directions[(i + 1) % 4];
+        shape.sides[i] = {x1 - x0, y1 - y0};
+    }
+    return shape;
+}
+
+/** The square-shaped ring of cells at equal chebyshev distance. */
+constexpr ring_shape<4> chebyshev_ring_shape()
+{
+    auto const & directions = direction_offsets_v<cardinal::direction_name>;
+    auto const & [x0, y0] = directions[3];
+    auto const & [x1, y1] = directions[0];
+    ring_shape<4> shape{{x0 + x1, y0 + y1}, {}, 2};
+    for (std::size_t i = 0; i < 4; ++i) {
+        shape.sides[i] = directions[(i + 1) % 4];
+    }
+    return shape;
+}
+
+namespace views {
+
+/** A lazy range of the grid cells in the rings around a center.
+ *
+ * The rings with radius in [first_radius, last_radius] are generated in order
+ * of increasing radius, and negative radii have no cells. No memory is
+ * allocated, and the view may be iterated in a constant expression.
+ */
+template<grid_point Vector, std::size_t Sides>
+class ring_view : public ranges::view_interface<ring_view<Vector, Sides>> {
+    using scalar = scalar_field_t<Vector>;
+public:
+    class iterator {
+    public:
+        using value_type = Vector;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        constexpr iterator() = default;
+        constexpr iterator(ring_view const & view)
+            : _shape(view._shape), _cx(get_x(view._center)),
+              _cy(get_y(view._center)), _last_radius(view._last_radius),
+              _remaining(view.size())
+        {
+            start_ring(view._first_radius);
+        }
+
+        constexpr Vector operator*() const { return Vector{_x, _y}; }
+
+        constexpr iterator & operator++()
+        {
+            --_remaining;
+            if (++_index == _shape.size(_radius)) {
+                if (_radius < _last_radius) { start_ring(_radius + 1); }
+                return *this;
+            }
+            _x += static_cast<scalar>(_shape.sides[_side][0]);
+            _y += static_cast<scalar>(_shape.sides[_side][1]);
+            if (++_step == _radius * _shape.side_length) {
+                _step = 0;
+                ++_side;
+            }
+            return *this;
+        }
+        constexpr iterator operator++(int)
+        {
+            iterator const previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        constexpr bool operator==(iterator const & other) const
+        {
+            return _remaining == other._remaining;
+        }
+        constexpr bool operator==(std::default_sentinel_t) const
+        {
+            return _remaining == 0;
+        }
+    private:
+        ring_shape<Sides> _shape{};
+        scalar _cx{}, _cy{};
+        scalar _x{}, _y{};
+        int _radius = 0;
+        int _last_radius = 0;
+        std::size_t _index = 0;
+        std::size_t _side = 0;
+        int _step = 0;
+        std::size_t _remaining = 0;
+
+        constexpr void start_ring(int radius)
+        {
+            _radius = radius;
+            _index = 0;
+            _side = 0;
+            _step = 0;
+            _x = _cx + static_cast<scalar>(radius * _shape.start[0]);
+            _y = _cy + static_cast<scalar>(radius * _shape.start[1]);
+        }
+    };
+
+    constexpr ring_view() = default;
+    constexpr ring_view(Vector const & center, ring_shape<Sides> const & shape,
+                        int first_radius, int last_radius)
+        : _center(center), _shape(shape),
+          _first_radius(std::max(first_radius, 0)), _last_radius(last_radius)
+    {
+    }
+
+    constexpr iterator begin() const { return iterator(*this); }
+    constexpr std::default_sentinel_t end() const { return {}; }
+    constexpr std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (int k = _first_radius; k <= _last_radius; ++k) {
+            total += _shape.size(k);
+        }
+        return total;
+    }
+private:
+    Vector _center{};
+    ring_shape<Sides> _shape{};
+    int _first_radius = 0;
+    int _last_radius = -1;
+};
+
+/** A lazy range of the axial hexes within a distance of a center, ordered by
+ * their first and then second component.
+ */
+template<grid_point Vector>
+class hex_range_view : public ranges::view_interface<hex_range_view<Vector>> {
+    using scalar = scalar_field_t<Vector>;
+public:
+    class iterator {
+    public:
+        using value_type = Vector;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        constexpr iterator() = default;
+        constexpr iterator(Vector const & center, int radius)
+            : _cq(get_x(center)), _cr(get_y(center)), _radius(radius),
+              _dq(-radius), _dr(0)
+        {
+            _dr = std::max(-radius, -_dq - radius);
+        }
+
+        constexpr Vector operator*() const
+        {
+            return Vector{static_cast<scalar>(_cq + _dq),
+                          static_cast<scalar>(_cr + _dr)};
+        }
+
+        constexpr iterator & operator++()
+        {
+            if (++_dr > std::min(_radius, -_dq + _radius)) {
+                ++_dq;
+                _dr = std::max(-_radius, -_dq - _radius);
+            }
+            return *this;
+        }
+        constexpr iterator operator++(int)
+        {
+            iterator const previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        constexpr bool operator==(iterator const & other) const
+        {
+            return _dq == other._dq and _dr == other._dr;
+        }
+        constexpr bool operator==(std::default_sentinel_t) const
+        {
+            return _dq > _radius;
+        }
+    private:
+        scalar _cq{}, _cr{};
+        int _radius = -1;
+        int _dq = 0, _dr = 0;
+    };
+
+    constexpr hex_range_view() = default;
+    constexpr hex_range_view(Vector const & center, int radius)
+        : _center(center), _radius(radius)
+    {
+    }
+
+    constexpr iterator begin() const { return iterator(_center, _radius); }
+    constexpr std::default_sentinel_t end() const { return {}; }
+    constexpr std::size_t size() const
+    {
+        return _radius < 0? 0 : 1 + 3 * static_cast<std::size_t>(_radius) *
+                                        static_cast<std::size_t>(_radius + 1);
+    }
+private:
+    Vector _center{};
+    int _radius = -1;
+};
+
+/** The axial hexes at exactly a distance from a center.
+ *
+ * The ring starts in the direction Enum(4) from center and walks the
+ * directions of Enum in order.
+ */
+template<ranged_enum Enum, grid_point Vector>
+    requires (enum_size_v<Enum> == 6)
+constexpr ring_view<Vector, 6> hex_ring(Vector const & center, int radius)
+{
+    return ring_view<Vector, 6>(center, hex_ring_shape<Enum>(), radius, radius);
+}
+
+/** The axial hexes within a distance of a center, ring by ring outwards. */
+template<ranged_enum Enum, grid_point Vector>
+    requires (enum_size_v<Enum> == 6)
+constexpr ring_view<Vector, 6> hex_spiral(Vector const & center, int radius)
+{
+    return ring_view<Vector, 6>(center, hex_ring_shape<Enum>(), 0, radius);
+}
+
+/** The axial hexes within a distance of a center. */
+template<grid_point Vector>
+constexpr hex_range_view<Vector> hex_range(Vector const & center, int radius)
+{
+    return hex_range_view<Vector>(center, radius);
+}
+
+/** The square-grid cells at exactly a manhattan distance from a center. */
+template<grid_point Vector>
+constexpr ring_view<Vector, 4> manhattan_ring(Vector const & center, int radius)
+{
+    return ring_view<Vector, 4>(center, manhattan_ring_shape(), radius, radius);
+}
+
+/** The square-grid cells at exactly a chebyshev distance from a center. */
+template<grid_point Vector>
+constexpr ring_view<Vector, 4> chebyshev_ring(Vector const & center, int radius)
+{
+    return ring_view<Vector, 4>(center, chebyshev_ring_shape(), radius, radius);
+}
+}
+}
@@ -0,0 +1,395 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include <cmath>
+
+// errors
+#include <stdexcept>
+
+/** Methods of simplifying polylines. */
+namespace sp::simplification {
+/** Keep the point furthest from each simplified piece until every dropped
+ * point is within the tolerance of the piece it was dropped from, from
+ * Douglas and Peucker. The tolerance is a distance.
+ */
+struct douglas_peucker {};
+/** Drop the point that makes the smallest triangle with its neighbours until
+ * every triangle is larger than the tolerance, from Visvalingam and Whyatt.
+ * The tolerance is an area, and the result keeps the overall shape of the
+ * polyline with fewer spikes than Douglas-Peucker.
+ */
+struct visvalingam_whyatt {};
+/** Extend each simplified piece for as long as the points along it stay within
+ * the tolerance, in a single pass with bounded memory, with
+ * sp::polyline_simplifier. The tolerance is a distance.
+ */
+struct streaming {};
+}
+
+namespace sp {
+
+/** A method that sp::simplify can simplify polylines with. */
+template<class Method>
+concept simplification_method =
+    std::same_as<Method, simplification::douglas_peucker> or
+    std::same_as<Method, simplification::visvalingam_whyatt> or
+    std::same_as<Method, simplification::streaming>;
+
+namespace detail {
+
+// the scalar distances and areas are measured in: double for float and
+// integer points, or the points' own scalar if it's wider
+template<class Vector>
+using simplify_scalar_t = std::common_type_t<scalar_field_t<Vector>, double>;
+
+template<class Scalar, class Vector>
+std::array<Scalar, dimension_v<Vector>> polyline_point(Vector const & p)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<Scalar, dimension_v<Vector>>{
+            static_cast<Scalar>(get_component<I>(p))...};
+    }(std::make_index_sequence<dimension_v<Vector>>{});
+}
+
+// the squared distance from p to the segment from a to b
+template<std::size_t N, class Scalar>
+Scalar segment_distance_squared(std::array<Scalar, N> const & p,
+                                std::array<Scalar, N> const & a,
+                                std::array<Scalar, N> const & b)
+{
+    Scalar length = 0, along = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        length += (b[i] - a[i]) * (b[i] - a[i]);
+        along += (p[i] - a[i]) * (b[i] - a[i]);
+    }
+    Scalar const t = length > 0? std::clamp(along / length, Scalar{0}, Scalar{1}) : 0;
+    Scalar squared = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        Scalar const d = a[i] + t * (b[i] - a[i]) - p[i];
+        squared += d * d;
+    }
+    return squared;
+}
+
+template<std::size_t N, class Scalar>
+Scalar triangle_area(std::array<Scalar, N> const & a, std::array<Scalar, N> const & b,
+                     std::array<Scalar, N> const & c)
+{
+    std::array<Scalar, N> u, v;
+    for (std::size_t i = 0; i < N; ++i) {
+        u[i] = b[i] - a[i];
+        v[i] = c[i] - a[i];
+    }
+    if constexpr (N == 2) {
+        return std::abs(u[0] * v[1] - u[1] * v[0]) / 2;
+    }
+    else {
+        Scalar const x = u[1] * v[2] - u[2] * v[1];
+        Scalar const y = u[2] * v[0] - u[0] * v[2];
+        Scalar const z = u[0] * v[1] - u[1] * v[0];
+        return std::sqrt(x * x + y * y + z * z) / 2;
+    }
+}
+
+template<class Scalar>
+void check_simplify_tolerance(Scalar tolerance)
+{
+    if (not (tolerance >= 0)) {
+        throw std::domain_error{"simplification tolerance must not be negative"};
+    }
+}
+
+// which points Douglas-Peucker keeps. The spans left to split wait on a stack
+// instead of the call stack, so long polylines can't overflow it
+template<std::size_t N, class Scalar>
+std::vector<char> mark_douglas_peucker(std::vector<std::array<Scalar, N>> const & points,
+                                       Scalar tolerance)
+{
+    std::vector<char> keep(points.size(), false);
+    keep.front() = keep.back() = true;
+    Scalar const limit = tolerance * tolerance;
+    std::vector<std::pair<std::size_t, std::size_t>> spans{{0, points.size() - 1}};
+    while (not spans.empty()) {
+        auto const [first, last] = spans.back();
+        spans.pop_back();
+        Scalar furthest = limit;
+        std::size_t split = first;
+        for (std::size_t k = first + 1; k < last; ++k) {
+            Scalar const d = segment_distance_squared(points[k], points[first],
+                                                      points[last]);
+            if (d > furthest) {
+                furthest = d;
+                split = k;
+            }
+        }
+        if (split == first) { continue; }
+        keep[split] = true;
+        spans.emplace_back(first, split);
+        spans.emplace_back(split, last);
+    }
+    return keep;
+}
+
+// which points Visvalingam-Whyatt keeps. Points are linked to their remaining
+// neighbours and held in a binary heap of the smallest area first, which
+// tracks where each point is so a neighbour's area can change in place
+template<std::size_t N, class Scalar>
+std::vector<char> mark_visvalingam_whyatt(
+    std::vector<std::array<Scalar, N>> const & points, Scalar tolerance)
+{
+    std::size_t const last = points.size() - 1;
+    std::vector<char> keep(points.size(), true);
+    std::vector<std::size_t> previous(points.size()), next(points.size());
+    std::vector<std::size_t> position(points.size());
+
+    // ties go to the earlier point, so the result doesn't depend on the heap
+    using entry = std::pair<Scalar, std::size_t>;
+    std::vector<entry> heap;
+    heap.reserve(last - 1);
+    for (std::size_t k = 1; k < last; ++k) {
+        previous[k] = k - 1;
+        next[k] = k + 1;
+        position[k] = heap.size();
+        heap.emplace_back(triangle_area(points[k - 1], points[k], points[k + 1]), k);
+    }
+    next[0] = 1;
+    previous[last] = last - 1;
+
+    auto const place = [&](std::size_t at, entry const & e) {
+        heap[at] = e;
+        position[e.second] = at;
+    };
+    auto const sift_up = [&](std::size_t at) {
+        entry const e = heap[at];
+        for (; at > 0 and e < heap[(at - 1) / 2]; at = (at - 1) / 2) {
+            place(at, heap[(at - 1) / 2]);
+        }
+        place(at, e);
+    };
+    auto const sift_down = [&](std::size_t at) {
+        entry const e = heap[at];
+        for (std::size_t child = 2 * at + 1; child < heap.size(); child = 2 * at + 1) {
+            if (child + 1 < heap.size() and heap[child + 1] < heap[child]) { ++child; }
+            if (not (heap[child] < e)) { break; }
+            place(at, heap[child]);
+            at = child;
+        }
+        place(at, e);
+    };
+    for (std::size_t at = heap.size() / 2; at-- > 0;) { sift_down(at); }
+
+    while (not heap.empty() and heap.front().first <= tolerance) {
+        auto const [area, k] = heap.front();
+        place(0, heap.back());
+        heap.pop_back();
+        if (not heap.empty()) { sift_down(0); }
+        keep[k] = false;
+        next[previous[k]] = next[k];
+        previous[next[k]] = previous[k];
+
+        // a neighbour's area never drops below the area just removed, so
+        // points are dropped in the order of the area they represent
+        for (std::size_t const j : {previous[k], next[k]}) {
+            if (j == 0 or j == last) { continue; }
+            std::size_t const at = position[j];
+            heap[at].first = std::max(triangle_area(points[previous[j]], points[j],
+                                                    points[next[j]]), area);
+            sift_up(at);
+            sift_down(position[j]);
+        }
+    }
+    return keep;
+}
+}
+
+/** Simplify a polyline of unbounded length as its points arrive, in bounded
+ * memory.
+ *
+ * Each piece of the simplified polyline is extended to each new point for as
+ * long as every point since the piece started stays within the tolerance of
+ * it, and otherwise ends at the point before. At most capacity points wait at
+ * once, and a piece also ends when that many are waiting, which bounds both
+ * the memory and the work per point. As with Douglas-Peucker, every dropped
+ * point is within the tolerance of the simplified polyline, though the greedy
+ * pieces may keep a few more points.
+ *
+ * Example:
+ *     sp::polyline_simplifier<vec2> simplifier(0.5);
+ *     for (auto const & p : incoming) { out = simplifier.add(p, out); }
+ *     out = simplifier.finish(out);
+ */
+template<class Vector>
+    requires semivector2<Vector> or semivector3<Vector>
+class polyline_simplifier {
+public:
+    using scalar = detail::simplify_scalar_t<Vector>;
+
+    /** Start simplifying a polyline.
+     *
+     * Parameters
+     *   tolerance - the greatest distance a dropped point may be from the
+     *               simplified polyline
+     *   capacity - the most points that may wait to be dropped or kept
+     *
+     * Throws
+     *   std::domain_error if the tolerance is negative
+     */
+    explicit polyline_simplifier(scalar tolerance, std::size_t capacity = 256)
+        : _limit{tolerance * tolerance}, _capacity{std::max<std::size_t>(capacity, 1)}
+    {
+        detail::check_simplify_tolerance(tolerance);
+        _pending.reserve(_capacity);
+    }
+
+    /** Add the next point of the polyline.
+     *
+     * Return
+     *   An iterator past the points that were kept, which is either none or the
+     *   end of the piece the point couldn't extend.
+     */
+    template<std::weakly_incrementable Out>
+        requires std::indirectly_writable<Out, Vector const &>
+    Out add(Vector const & p, Out out)
+    {
+        auto const q = detail::polyline_point<scalar>(p);
+        if (not _started) {
+            _started = true;
+            _anchor = q;
+            *out = p;
+            ++out;
+            return out;
+        }
+        bool const fits = _pending.size() < _capacity and
+                          ranges::all_of(_pending, [&](auto const & waiting) {
+            return detail::segment_distance_squared(waiting.second, _anchor, q) <= _limit;
+        });
+        if (not fits) {
+            *out = _pending.back().first;
+            ++out;
+            _anchor = _pending.back().second;
+            _pending.clear();
+        }
+        _pending.emplace_back(p, q);
+        return out;
+    }
+
+    /** Keep the last point of the polyline, and start over with a new one.
+     *
+     * Return
+     *   An iterator past the last point, if there is one.
+     */
+    template<std::weakly_incrementable Out>
+        requires std::indirectly_writable<Out, Vector const &>
+    Out finish(Out out)
+    {
+        if (not _pending.empty()) {
+            *out = _pending.back().first;
+            ++out;
+        }
+        _pending.clear();
+        _started = false;
+        return out;
+    }
+private:
+    using point = std::array<scalar, dimension_v<Vector>>;
+    std::vector<std::pair<Vector, point>> _pending;
+    point _anchor{};
+    scalar _limit;
+    std::size_t _capacity;
+    bool _started = false;
+};
+
+/** Simplify a polyline, keeping fewer points along the same shape.
+ *
+ * Return
+ *   An iterator past the last kept point.
+ *
+ * Parameters
+ *   points - the points of the polyline
+ *   tolerance - the greatest distance a dropped point may be from the
+ *               simplified polyline, or for Visvalingam-Whyatt, the greatest
+ *               area of the triangle a dropped point made with its neighbours
+ *   out - iterator to the start of the kept points
+ *
+ * Template Parameters
+ *   Method - one of the sp::simplification methods. Douglas-Peucker and
+ *            Visvalingam-Whyatt need to see every point at once, while the
+ *            streaming method takes a single pass over any input range
+ *
+ * Throws
+ *   std::domain_error if the tolerance is negative
+ *
+ * The first and last points are always kept, and kept points are copied from
+ * the polyline unchanged and in order. Douglas-Peucker and Visvalingam-Whyatt
+ * work on a copy of the points in double precision or wider, and neither
+ * recurses, so polylines of millions of points are fine.
+ *
+ * Example:
+ *     std::vector<vec2> simplified;
+ *     sp::simplify(trace, 0.5, std::back_inserter(simplified));
+ *     sp::simplify<sp::simplification::visvalingam_whyatt>(
+ *         contour, 2.0, std::back_inserter(simplified));
+ */
+template<simplification_method Method = simplification::douglas_peucker,
+         ranges::input_range Range, std::weakly_incrementable Out>
+    requires (semivector2<ranges::range_value_t<Range>> or
+              semivector3<ranges::range_value_t<Range>>) and
+             (ranges::forward_range<Range> or
+              std::same_as<Method, simplification::streaming>) and
+             std::indirectly_writable<Out, ranges::range_value_t<Range> const &>
+
+Out simplify(Range && points,
+             detail::simplify_scalar_t<ranges::range_value_t<Range>> tolerance, Out out)
+{
+    using Vector = ranges::range_value_t<Range>;
+    using Scalar = detail::simplify_scalar_t<Vector>;
+    constexpr std::size_t N = dimension_v<Vector>;
+    detail::check_simplify_tolerance(tolerance);
+
+    if constexpr (std::same_as<Method, simplification::streaming>) {
+        polyline_simplifier<Vector> simplifier(tolerance);
+        for (Vector const & p : points) { out = simplifier.add(p, out); }
+        return simplifier.finish(out);
+    }
+    else {
+        std::vector<std::array<Scalar, N>> coordinates;
+        if constexpr (ranges::sized_range<Range>) {
+            coordinates.reserve(static_cast<std::size_t>(ranges::size(points)));
+        }
+        for (Vector const & p : points) {
+            coordinates.push_back(detail::polyline_point<Scalar>(p));
+        }
+        std::vector<char> keep(coordinates.size(), true);
+        if (coordinates.size() > 2) {
+            if constexpr (std::same_as<Method, simplification::douglas_peucker>) {
+                keep = detail::mark_douglas_peucker(coordinates, tolerance);
+            }
+            else {
+                keep = detail::mark_visvalingam_whyatt(coordinates, tolerance);
+            }
+        }
+        std::size_t k = 0;
+        for (Vector const & p : points) {
+            if (keep[k++]) {
+                *out = p;
+                ++out;
+            }
+        }
+        return out;
+    }
+}
+}
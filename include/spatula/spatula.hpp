@@ -1,3 +1,28 @@
 #pragma once
 
 #include "spatula/math.hpp"
+#include "spatula/grids.hpp"
+#include "spatula/distances.hpp"
+#include "spatula/lines.hpp"
+#include "spatula/rings.hpp"
+#include "spatula/layouts.hpp"
+#include "spatula/compact_vectors.hpp"
+#include "spatula/fixed.hpp"
+#include "spatula/predicates.hpp"
+#include "spatula/affine.hpp"
+#include "spatula/quaternions.hpp"
+#include "spatula/expressions.hpp"
+#include "spatula/views.hpp"
+#include "spatula/statistics.hpp"
+#include "spatula/oriented_boxes.hpp"
+#include "spatula/curves.hpp"
+#include "spatula/simplify.hpp"
+#include "spatula/rects.hpp"
+#include "spatula/packing.hpp"
+#include "spatula/colors.hpp"
+#include "spatula/mapped_file.hpp"
+#include "spatula/point_files.hpp"
+#include "spatula/point_text.hpp"
+#include "spatula/point_codec.hpp"
+#include "spatula/regions.hpp"
+#include "spatula/visibility.hpp"
@@ -0,0 +1,595 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// algorithms
+#include <algorithm>
+#include <cmath>
+#include "spatula/parallel.hpp"
+
+// errors
+#include <stdexcept>
+
+namespace sp {
+
+/** The count, mean and scatter of a set of points.
+ *
+ * The scatter is the sum of the outer products of each point's deviation from
+ * the mean, so dividing it by the count gives the population covariance, and
+ * dividing by one less than the count gives the sample covariance.
+ */
+template<std::size_t N, std::floating_point Scalar = double>
+struct point_moments {
+    std::size_t count = 0;
+    std::array<Scalar, N> mean{};
+    std::array<std::array<Scalar, N>, N> scatter{};
+};
+
+namespace detail {
+
+// the amount of points summed directly before partial sums are combined
+// pairwise, which fixes the order of every addition no matter how many
+// threads compute the blocks
+inline constexpr std::size_t statistics_block = 4096;
+
+// the least amount of blocks worth handing to another thread
+inline constexpr std::size_t min_statistics_chunk = 16;
+
+// independent partial sums within a block, so additions don't wait on each
+// other, combined at the end of each block as (0 + 1) + (2 + 3)
+inline constexpr std::size_t statistics_lanes = 4;
+
+// float and integer points are accumulated in double, and wider types in
+// their own precision
+template<class Scalar>
+using accumulator_t = std::common_type_t<Scalar, double>;
+
+template<std::size_t N, class Function>
+constexpr void for_components(Function && f)
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<std::size_t, I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+template<class Scalar>
+struct unit_weights {
+    constexpr Scalar operator[](std::size_t) const { return Scalar{1}; }
+};
+
+template<std::size_t N, class Scalar>
+struct weighted_total {
+    Scalar weight{};
+    std::array<Scalar, N> sum{};
+};
+
+template<std::size_t N, class Scalar>
+constexpr weighted_total<N, Scalar>
+merge_statistics(weighted_total<N, Scalar> const & a, weighted_total<N, Scalar> const & b)
+{
+    weighted_total<N, Scalar> result{a.weight + b.weight, {}};
+    for (std::size_t i = 0; i < N; ++i) { result.sum[i] = a.sum[i] + b.sum[i]; }
+    return result;
+}
+
+// the moments of two disjoint sets of points, from Chan, Golub and LeVeque
+template<std::size_t N, class Scalar>
+constexpr point_moments<N, Scalar>
+merge_statistics(point_moments<N, Scalar> const & a, point_moments<N, Scalar> const & b)
+{
+    if (a.count == 0) { return b; }
+    if (b.count == 0) { return a; }
+
+    auto const na = static_cast<Scalar>(a.count);
+    auto const nb = static_cast<Scalar>(b.count);
+    auto const n = na + nb;
+    point_moments<N, Scalar> result{a.count + b.count, {}, {}};
+    std::array<Scalar, N> delta;
+    for (std::size_t i = 0; i < N; ++i) {
+        delta[i] = b.mean[i] - a.mean[i];
+        result.mean[i] = a.mean[i] + delta[i] * (nb / n);
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            result.scatter[i][j] = a.scatter[i][j] + b.scatter[i][j] +
+                                   delta[i] * delta[j] * (na * nb / n);
+        }
+    }
+    return result;
+}
+
+// the weighted sum of a block of points
+template<std::size_t N, class Scalar, std::random_access_iterator It, class Weights>
+weighted_total<N, Scalar> block_sum(It points, Weights const & weights, std::size_t count)
+{
+    constexpr std::size_t L = statistics_lanes;
+    Scalar weight[L]{};
+    Scalar sum[L][N]{};
+
+    auto const accumulate = [&](std::size_t lane, std::size_t k) {
+        auto const & p = points[static_cast<std::iter_difference_t<It>>(k)];
+        auto const w = static_cast<Scalar>(weights[k]);
+        weight[lane] += w;
+        for_components<N>([&](auto i) {
+            sum[lane][i] += w * static_cast<Scalar>(get_component<i>(p));
+        });
+    };
+    std::size_t k = 0;
+    for (; k + L <= count; k += L) {
+        for (std::size_t lane = 0; lane < L; ++lane) { accumulate(lane, k + lane); }
+    }
+    for (std::size_t lane = 0; k < count; ++k, ++lane) { accumulate(lane, k); }
+
+    weighted_total<N, Scalar> result{};
+    result.weight = (weight[0] + weight[1]) + (weight[2] + weight[3]);
+    for (std::size_t i = 0; i < N; ++i) {
+        result.sum[i] = (sum[0][i] + sum[1][i]) + (sum[2][i] + sum[3][i]);
+    }
+    return result;
+}
+
+// the moments of a block of points, with the scatter taken about the block's
+// own mean so it doesn't lose precision to a large offset
+template<std::size_t N, class Scalar, std::random_access_iterator It>
+point_moments<N, Scalar> block_moments(It points, std::size_t count)
+{
+    constexpr std::size_t L = statistics_lanes;
+    auto const total = block_sum<N, Scalar>(points, unit_weights<Scalar>{}, count);
+    point_moments<N, Scalar> result{count, {}, {}};
+    for (std::size_t i = 0; i < N; ++i) {
+        result.mean[i] = total.sum[i] / static_cast<Scalar>(count);
+    }
+
+    Scalar scatter[L][N][N]{};
+    auto const accumulate = [&](std::size_t lane, std::size_t k) {
+        auto const & p = points[static_cast<std::iter_difference_t<It>>(k)];
+        auto const deviation = [&](auto i) {
+            return static_cast<Scalar>(get_component<i>(p)) - result.mean[i];
+        };
+        // deviations aren't stored in an array, which would be reloaded
+        // across its stores and stall every iteration
+        for_components<N>([&](auto i) {
+            for_components<N>([&](auto j) {
+                if constexpr (j >= i) {
+                    scatter[lane][i][j] += deviation(i) * deviation(j);
+                }
+            });
+        });
+    };
+    std::size_t k = 0;
+    for (; k + L <= count; k += L) {
+        for (std::size_t lane = 0; lane < L; ++lane) { accumulate(lane, k + lane); }
+    }
+    for (std::size_t lane = 0; k < count; ++k, ++lane) { accumulate(lane, k); }
+
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = i; j < N; ++j) {
+            result.scatter[i][j] = (scatter[0][i][j] + scatter[1][i][j]) +
+                                   (scatter[2][i][j] + scatter[3][i][j]);
+            result.scatter[j][i] = result.scatter[i][j];
+        }
+    }
+    return result;
+}
+
+// combine partial results in a balanced binary tree over their order
+template<class Partial>
+Partial reduce_pairwise(std::vector<Partial> & partials)
+{
+    for (std::size_t stride = 1; stride < partials.size(); stride *= 2) {
+        for (std::size_t i = 0; i + stride < partials.size(); i += 2 * stride) {
+            partials[i] = merge_statistics(partials[i], partials[i + stride]);
+        }
+    }
+    return partials.empty()? Partial{} : partials.front();
+}
+
+// apply block(first, count) to consecutive blocks of points and combine the
+// results pairwise. Random access ranges are split between threads by whole
+// blocks, and other ranges are buffered one block at a time, so the result is
+// the same either way
+template<class Partial, ranges::input_range Range, class Block>
+Partial reduce_blocks(Range && points, Block const & block, std::size_t workers)
+{
+    constexpr std::size_t B = statistics_block;
+    std::vector<Partial> partials;
+    if constexpr (ranges::random_access_range<Range> and ranges::sized_range<Range>) {
+        auto const count = static_cast<std::size_t>(ranges::size(points));
+        std::size_t const blocks = (count + B - 1) / B;
+        partials.resize(blocks);
+        auto const first = ranges::begin(points);
+        workers = std::min(workers, blocks / min_statistics_chunk + 1);
+        parallel_for(blocks, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t b = begin; b < end; ++b) {
+                auto const offset = static_cast<ranges::range_difference_t<Range>>(b * B);
+                partials[b] = block(first + offset, std::min(B, count - b * B));
+            }
+        }, workers);
+    }
+    else {
+        std::vector<ranges::range_value_t<Range>> buffer;
+        buffer.reserve(B);
+        for (auto && p : points) {
+            buffer.push_back(p);
+            if (buffer.size() == B) {
+                partials.push_back(block(buffer.begin(), B));
+                buffer.clear();
+            }
+        }
+        if (not buffer.empty()) {
+            partials.push_back(block(buffer.begin(), buffer.size()));
+        }
+    }
+    return reduce_pairwise(partials);
+}
+
+template<class To, class Vector, class Scalar, std::size_t N>
+auto mean_vector(weighted_total<N, Scalar> const & total)
+{
+    using Result = std::conditional_t<std::is_void_v<To>, Vector, To>;
+    using scalar = scalar_field_t<Result>;
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return Result{static_cast<scalar>(total.sum[I] / total.weight)...};
+    }(std::make_index_sequence<N>{});
+}
+}
+
+/** Compute the moments of a set of points up to the second.
+ *
+ * Return
+ *   The count, mean and scatter of the points, accumulated in double for float
+ *   and integer points. An empty range has zero count.
+ *
+ * Parameters
+ *   points - the points to measure
+ *   workers - the maximum amount of threads to compute with
+ *
+ * Points are summed in fixed blocks, with the scatter of each block taken
+ * about its own mean, and the blocks are then combined pairwise. The order of
+ * every operation only depends on the amount of points, so the result is the
+ * same for any amount of workers, and its error grows with the logarithm of
+ * the amount of points rather than linearly. Random access ranges are
+ * computed in parallel; other ranges are buffered one block at a time.
+ */
+template<ranges::input_range Range>
+    requires semivector<ranges::range_value_t<Range>>
+
+auto second_moments(Range && points, std::size_t workers = worker_count())
+{
+    using Vector = ranges::range_value_t<Range>;
+    constexpr std::size_t N = dimension_v<Vector>;
+    using Scalar = detail::accumulator_t<scalar_field_t<Vector>>;
+
+    return detail::reduce_blocks<point_moments<N, Scalar>>(
+        std::forward<Range>(points), [](auto first, std::size_t count) {
+            return detail::block_moments<N, Scalar>(first, count);
+        }, workers);
+}
+
+/** Compute the mean of a range of vectors.
+ *
+ * Return
+ *   The mean as the given vector type or, by default, the type of the input.
+ *
+ * Parameters
+ *   values - the vectors to average
+ *   workers - the maximum amount of threads to compute with
+ *
+ * Throws
+ *   std::domain_error if the range is empty
+ *
+ * The vectors are summed in double for float and integer vectors, in the same
+ * deterministic pairwise order as second_moments, so the mean of a hundred
+ * million floats is still accurate to within rounding of the result.
+ */
+template<class To = void, ranges::input_range Range>
+    requires semivector<ranges::range_value_t<Range>>
+
+auto mean(Range && values, std::size_t workers = worker_count())
+{
+    using Vector = ranges::range_value_t<Range>;
+    constexpr std::size_t N = dimension_v<Vector>;
+    using Scalar = detail::accumulator_t<scalar_field_t<Vector>>;
+
+    auto const total = detail::reduce_blocks<detail::weighted_total<N, Scalar>>(
+        std::forward<Range>(values), [](auto first, std::size_t count) {
+            return detail::block_sum<N, Scalar>(first, detail::unit_weights<Scalar>{},
+                                                count);
+        }, workers);
+    if (total.weight == 0) {
+        throw std::domain_error{"mean of an empty range"};
+    }
+    return detail::mean_vector<To, Vector>(total);
+}
+
+/** Compute the centroid of a set of points, their mean position.
+ *
+ * Throws
+ *   std::domain_error if there are no points
+ */
+template<class To = void, ranges::input_range Range>
+    requires semivector<ranges::range_value_t<Range>>
+
+auto centroid(Range && points, std::size_t workers = worker_count())
+{
+    return mean<To>(std::forward<Range>(points), workers);
+}
+
+/** Compute the weighted centroid of a set of points.
+ *
+ * Parameters
+ *   points - the points to find the centroid of
+ *   weights - the weight of each point, such as its mass or area
+ *   workers - the maximum amount of threads to compute with
+ *
+ * Throws
+ *   std::invalid_argument if there are fewer weights than points
+ *   std::domain_error if the weights sum to zero
+ */
+template<class To = void, ranges::random_access_range Range,
+         ranges::random_access_range Weights>
+    requires ranges::sized_range<Range> and ranges::sized_range<Weights> and
+             semivector<ranges::range_value_t<Range>> and
+             std::is_arithmetic_v<ranges::range_value_t<Weights>>
+
+auto centroid(Range && points, Weights && weights, std::size_t workers = worker_count())
+{
+    using Vector = ranges::range_value_t<Range>;
+    constexpr std::size_t N = dimension_v<Vector>;
+    using Scalar = detail::accumulator_t<scalar_field_t<Vector>>;
+
+    if (ranges::size(weights) < ranges::size(points)) {
+        throw std::invalid_argument{"centroid needs a weight for every point"};
+    }
+    auto const first_point = ranges::begin(points);
+    auto const first_weight = ranges::begin(weights);
+    auto const count = static_cast<std::size_t>(ranges::size(points));
+
+    // reduce over the indices of the points, so each block finds its weights
+    auto const total = detail::reduce_blocks<detail::weighted_total<N, Scalar>>(
+        ranges::views::iota(std::size_t{0}, count), [&](auto first, std::size_t n) {
+            auto const k = *first;
+            return detail::block_sum<N, Scalar>(
+                first_point + static_cast<ranges::range_difference_t<Range>>(k),
+                first_weight + static_cast<ranges::range_difference_t<Weights>>(k), n);
+        }, workers);
+    if (total.weight == 0) {
+        throw std::domain_error{"centroid weights sum to zero"};
+    }
+    return detail::mean_vector<To, Vector>(total);
+}
+
+/** Accumulate the moments of points one at a time, with bounded memory.
+ *
+ * Points are buffered into the same blocks that second_moments uses, and each
+ * full block is combined right away with a stack of partial results, one for
+ * each level of the pairwise tree. Only one block of points and a logarithmic
+ * amount of partial results are held, and the moments of a sequence of points
+ * are identical to second_moments of the same sequence.
+ *
+ * Example:
+ *     sp::moment_accumulator<3> accumulator;
+ *     for (auto const & p : incoming) { accumulator.add(p); }
+ *     auto const axes = sp::principal_axes(accumulator.moments());
+ */
+template<std::size_t N, std::floating_point Scalar = double>
+class moment_accumulator {
+public:
+    moment_accumulator() { _buffer.reserve(detail::statistics_block); }
+
+    /** Add a point to the moments. */
+    template<semivector Vector>
+        requires (dimension_v<Vector> == N)
+    void add(Vector const & p)
+    {
+        std::array<Scalar, N> & q = _buffer.emplace_back();
+        detail::for_components<N>([&](auto i) {
+            q[i] = static_cast<Scalar>(get_component<i>(p));
+        });
+        if (_buffer.size() == detail::statistics_block) {
+            push(detail::block_moments<N, Scalar>(_buffer.begin(), _buffer.size()));
+            _buffer.clear();
+        }
+    }
+
+    /** The moments of every point added so far. */
+    point_moments<N, Scalar> moments() const
+    {
+        // the last, partial block and then each level of the stack from the
+        // top, which is the order reduce_pairwise combines them in
+        point_moments<N, Scalar> result{};
+        if (not _buffer.empty()) {
+            result = detail::block_moments<N, Scalar>(_buffer.begin(), _buffer.size());
+        }
+        for (auto level = _levels.rbegin(); level != _levels.rend(); ++level) {
+            result = detail::merge_statistics(level->moments, result);
+        }
+        return result;
+    }
+private:
+    struct partial {
+        std::size_t level;
+        point_moments<N, Scalar> moments;
+    };
+    std::vector<std::array<Scalar, N>> _buffer;
+    std::vector<partial> _levels;
+
+    void push(point_moments<N, Scalar> moments)
+    {
+        std::size_t level = 0;
+        while (not _levels.empty() and _levels.back().level == level) {
+            moments = detail::merge_statistics(_levels.back().moments, moments);
+            _levels.pop_back();
+            ++level;
+        }
+        _levels.push_back({level, moments});
+    }
+};
+
+/** Compute the sample covariance of a set of points from their moments.
+ *
+ * Throws
+ *   std::domain_error if there are fewer than two points
+ */
+template<std::size_t N, class Scalar>
+std::array<std::array<Scalar, N>, N> covariance(point_moments<N, Scalar> const & moments)
+{
+    if (moments.count < 2) {
+        throw std::domain_error{"covariance needs at least two points"};
+    }
+    auto const n = static_cast<Scalar>(moments.count - 1);
+    auto result = moments.scatter;
+    for (auto & row : result) {
+        for (auto & x : row) { x /= n; }
+    }
+    return result;
+}
+
+/** Compute the sample covariance of a set of points.
+ *
+ * Return
+ *   The covariance matrix of the points' components, accumulated in double
+ *   for float and integer points
+ *
+ * Throws
+ *   std::domain_error if there are fewer than two points
+ */
+template<ranges::input_range Range>
+    requires semivector<ranges::range_value_t<Range>>
+
+auto covariance(Range && points, std::size_t workers = worker_count())
+{
+    return covariance(second_moments(std::forward<Range>(points), workers));
+}
+
+/** The mean of a set of points and the axes along which they vary. */
+template<std::size_t N, std::floating_point Scalar = double>
+struct principal_components {
+    std::array<Scalar, N> mean{};
+
+    // unit axes in order of decreasing variance
+    std::array<std::array<Scalar, N>, N> axes{};
+    std::array<Scalar, N> variances{};
+};
+
+namespace detail {
+
+// the eigenvalues and unit eigenvectors of a symmetric matrix by cyclic
+// jacobi rotations, which converge quadratically and stay accurate for the
+// small matrices of point moments
+template<std::size_t N, class Scalar>
+void symmetric_eigen(std::array<std::array<Scalar, N>, N> a,
+                     std::array<Scalar, N> & values,
+                     std::array<std::array<Scalar, N>, N> & vectors)
+{
+    std::array<std::array<Scalar, N>, N> v{};
+    Scalar norm = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        v[i][i] = 1;
+        for (std::size_t j = 0; j < N; ++j) { norm += a[i][j] * a[i][j]; }
+    }
+    constexpr Scalar epsilon = std::numeric_limits<Scalar>::epsilon();
+    for (int sweep = 0; sweep < 32; ++sweep) {
+        Scalar off = 0;
+        for (std::size_t p = 0; p < N; ++p) {
+            for (std::size_t q = p + 1; q < N; ++q) { off += a[p][q] * a[p][q]; }
+        }
+        if (off <= norm * epsilon * epsilon) { break; }
+
+        for (std::size_t p = 0; p < N; ++p) {
+            for (std::size_t q = p + 1; q < N; ++q) {
+                if (a[p][q] == 0) { continue; }
+                // the rotation that zeroes a[p][q]
+                Scalar const theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+                Scalar const t = std::copysign(Scalar{1}, theta) /
+                                 (std::abs(theta) + std::sqrt(theta * theta + 1));
+                Scalar const c = 1 / std::sqrt(t * t + 1);
+                Scalar const s = t * c;
+                auto const rotate = [=](Scalar & x, Scalar & y) {
+                    Scalar const xp = x, yp = y;
+                    x = c * xp - s * yp;
+                    y = s * xp + c * yp;
+                };
+                for (std::size_t k = 0; k < N; ++k) { rotate(a[k][p], a[k][q]); }
+                for (std::size_t k = 0; k < N; ++k) { rotate(a[p][k], a[q][k]); }
+                for (std::size_t k = 0; k < N; ++k) { rotate(v[k][p], v[k][q]); }
+            }
+        }
+    }
+
+    // order by decreasing eigenvalue, with each vector's largest component
+    // positive so the axes don't flip between similar inputs
+    std::array<std::size_t, N> order;
+    for (std::size_t i = 0; i < N; ++i) { order[i] = i; }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) {
+        return a[i][i] > a[j][j];
+    });
+    for (std::size_t r = 0; r < N; ++r) {
+        std::size_t const k = order[r];
+        values[r] = a[k][k];
+        std::size_t largest = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            vectors[r][i] = v[i][k];
+            if (std::abs(v[i][k]) > std::abs(v[largest][k])) { largest = i; }
+        }
+        if (v[largest][k] < 0) {
+            for (auto & x : vectors[r]) { x = -x; }
+        }
+    }
+}
+}
+
+/** Compute the principal axes of a set of points from their moments.
+ *
+ * Return
+ *   The mean of the points, the unit eigenvectors of their covariance in
+ *   order of decreasing variance, and the variance along each. A single point
+ *   has zero variance along every axis.
+ *
+ * Throws
+ *   std::domain_error if there are no points
+ */
+template<std::size_t N, class Scalar>
+principal_components<N, Scalar> principal_axes(point_moments<N, Scalar> const & moments)
+{
+    if (moments.count == 0) {
+        throw std::domain_error{"principal axes of an empty set of points"};
+    }
+    principal_components<N, Scalar> result{moments.mean, {}, {}};
+    detail::symmetric_eigen(moments.scatter, result.variances, result.axes);
+    auto const n = static_cast<Scalar>(std::max<std::size_t>(moments.count - 1, 1));
+    for (auto & variance : result.variances) {
+        variance = std::max(variance / n, Scalar{0});
+    }
+    return result;
+}
+
+/** Compute the principal axes of a set of points.
+ *
+ * Throws
+ *   std::domain_error if there are no points
+ *
+ * Example:
+ *     auto const pca = sp::principal_axes(points);
+ *     auto const [x, y, z] = pca.axes[0]; // the direction of greatest spread
+ */
+template<ranges::input_range Range>
+    requires semivector<ranges::range_value_t<Range>>
+
+auto principal_axes(Range && points, std::size_t workers = worker_count())
+{
+    return principal_axes(second_moments(std::forward<Range>(points), workers));
+}
+}
@@ -177,18 +177,18 @@ using scalar_field_t = typename scalar_field<Vector>::type;
 
 /** Get the x component of a vector */
 template<class Vector> struct x_getter{
-    auto const & operator()(Vector const & v) const;
-    auto & operator()(Vector & v) const;
+    constexpr auto const & operator()(Vector const & v) const;
+    constexpr auto & operator()(Vector & v) const;
 };
 
 template<class Vector>
     requires has_x_component<Vector>
 struct x_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.x;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.x;
     }
@@ -197,11 +197,11 @@ struct x_getter<Vector> {
 template<class Vector>
     requires has_X_component<Vector>
 struct x_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.X;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.X;
     }
@@ -210,11 +210,11 @@ struct x_getter<Vector> {
 template<class Vector>
     requires has_q_component<Vector>
 struct x_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.q;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.q;
     }
@@ -224,11 +224,11 @@ template<class Vector>
     requires has_i_component<Vector> and
             (not (has_x_component<Vector> or has_X_component<Vector>))
 struct x_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v[0];
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v[0];
     }
@@ -236,18 +236,18 @@ struct x_getter<Vector> {
 
 /** Get the y component of a vector */
 template<class Vector> struct y_getter{
-    auto const & operator()(Vector const & v) const;
-    auto & operator()(Vector & v) const;
+    constexpr auto const & operator()(Vector const & v) const;
+    constexpr auto & operator()(Vector & v) const;
 };
 
 template<class Vector>
     requires has_y_component<Vector>
 struct y_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.y;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.y;
     }
@@ -256,11 +256,11 @@ struct y_getter<Vector> {
 template<class Vector>
     requires has_Y_component<Vector>
 struct y_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.Y;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.Y;
     }
@@ -269,11 +269,11 @@ struct y_getter<Vector> {
 template <class Vector>
     requires has_r_component<Vector>
 struct y_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.r;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.r;
     }
@@ -283,11 +283,11 @@ template<class Vector>
     requires has_i_component<Vector> and
             (not (has_y_component<Vector> or has_Y_component<Vector>))
 struct y_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v[1];
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v[1];
     }
@@ -295,18 +295,18 @@ struct y_getter<Vector> {
 
 /** Get the z component of a vector */
 template<class Vector> struct z_getter{
-    auto const & operator()(Vector const & v) const;
-    auto & operator()(Vector & v) const;
+    constexpr auto const & operator()(Vector const & v) const;
+    constexpr auto & operator()(Vector & v) const;
 };
 
 template<class Vector>
     requires has_z_component<Vector>
 struct z_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.z;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.z;
     }
@@ -315,11 +315,11 @@ struct z_getter<Vector> {
 template<class Vector>
     requires has_Z_component<Vector>
 struct z_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.Z;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.Z;
     }
@@ -329,11 +329,11 @@ template<class Vector>
     requires has_i_component<Vector> and 
             (not (has_z_component<Vector> or has_Z_component<Vector>))
 struct z_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v[2];
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v[2];
     }
@@ -341,18 +341,18 @@ struct z_getter<Vector> {
 
 /** Get the w component of a vector */
 template<class Vector> struct w_getter{
-    auto const & operator()(Vector const & v) const;
-    auto & operator()(Vector & v) const;
+    constexpr auto const & operator()(Vector const & v) const;
+    constexpr auto & operator()(Vector & v) const;
 };
 
 template<class Vector>
     requires has_w_component<Vector>
 struct w_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.w;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.w;
     }
@@ -361,11 +361,11 @@ struct w_getter<Vector> {
 template<class Vector>
     requires has_W_component<Vector>
 struct w_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v.W;
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v.W;
     }
@@ -375,66 +375,58 @@ template<class Vector>
     requires has_i_component<Vector> and 
             (not (has_w_component<Vector> or has_W_component<Vector>))
 struct w_getter<Vector> {
-    auto const & operator()(Vector const & v) const
+    constexpr auto const & operator()(Vector const & v) const
     {
         return v[3];
     }
-    auto & operator()(Vector & v) const
+    constexpr auto & operator()(Vector & v) const
     {
         return v[3];
     }
 };
 
 template<class Vector>
-scalar_field_t<Vector> const & get_x(Vector const & v)
+constexpr scalar_field_t<Vector> const & get_x(Vector const & v)
 {
-    static x_getter<Vector> _get_x;
-    return _get_x(v);
+    return x_getter<Vector>{}(v);
 }
 template<class Vector>
-scalar_field_t<Vector> & get_x(Vector & v)
+constexpr scalar_field_t<Vector> & get_x(Vector & v)
 {
-    static x_getter<Vector> _get_x;
-    return _get_x(v);
+    return x_getter<Vector>{}(v);
 }
 
 template<class Vector>
-scalar_field_t<Vector> const & get_y(Vector const & v)
+constexpr scalar_field_t<Vector> const & get_y(Vector const & v)
 {
-    static y_getter<Vector> _get_y;
-    return _get_y(v);
+    return y_getter<Vector>{}(v);
 }
 template<class Vector>
-scalar_field_t<Vector> & get_y(Vector & v)
+constexpr scalar_field_t<Vector> & get_y(Vector & v)
 {
-    static y_getter<Vector> _get_y;
-    return _get_y(v);
+    return y_getter<Vector>{}(v);
 }
 
 template<class Vector>
-scalar_field_t<Vector> const & get_z(Vector const & v)
+constexpr scalar_field_t<Vector> const & get_z(Vector const & v)
 {
-    static z_getter<Vector> _get_z;
-    return _get_z(v);
+    return z_getter<Vector>{}(v);
 }
 template<class Vector>
-scalar_field_t<Vector> & get_z(Vector & v)
+constexpr scalar_field_t<Vector> & get_z(Vector & v)
 {
-    static z_getter<Vector> _get_z;
-    return _get_z(v);
+    return z_getter<Vector>{}(v);
 }
 
 template<class Vector>
-scalar_field_t<Vector> const & get_w(Vector const & v)
+constexpr scalar_field_t<Vector> const & get_w(Vector const & v)
 {
-    static w_getter<Vector> _get_w;
-    return _get_w(v);
+    return w_getter<Vector>{}(v);
 }
 template<class Vector>
-scalar_field_t<Vector> & get_w(Vector & v)
+constexpr scalar_field_t<Vector> & get_w(Vector & v)
 {
-    static w_getter<Vector> _get_w;
-    return _get_w(v);
+    return w_getter<Vector>{}(v);
 }
 
 //
@@ -525,6 +517,12 @@ requires(scalar_field_t<Vector> x, scalar_field_t<Vector> y,
     Vector{x, y, z, w};
 };
 
+/** A type that's constructible from a sequence of N field values. */
+template<class Vector, std::size_t N>
+concept field_nd_constructible = (N == 2 and field_2d_constructible<Vector>) or
+                                 (N == 3 and field_3d_constructible<Vector>) or
+                                 (N == 4 and field_4d_constructible<Vector>);
+
 template<class Vector>
 concept field_constructible = field_2d_constructible<Vector> or
                               field_3d_constructible<Vector> or
@@ -557,6 +555,22 @@ template<class Vector>
 concept semivector = semivector2<Vector> or semivector3<Vector> or
                      semivector4<Vector>;
 
+/** The amount of components of a semivector. */
+template<semivector Vector>
+constexpr std::size_t dimension_v = semivector2<Vector>? 2 :
+                                    semivector3<Vector>? 3 : 4;
+
+/** Get the ith component of a vector, where x is the 0th component. */
+template<std::size_t i, class Vector>
+    requires (i < 4)
+constexpr auto & get_component(Vector & v)
+{
+    if constexpr (i == 0) { return get_x(v); }
+    else if constexpr (i == 1) { return get_y(v); }
+    else if constexpr (i == 2) { return get_z(v); }
+    else { return get_w(v); }
+}
+
 /** An atomic contraint for vector operations. */
 template<class Vector>
 constexpr bool has_vector_closure =
@@ -663,11 +677,11 @@ requires std::totally_ordered<scalar_field_t<Vector>>
 auto bounding_corners2d(In begin, S end)
 {
     // find the points with the least and greatest x and y coordinates
-    auto const &[xmin, xmax] = std::minmax(begin, end, least_x);
-    auto const &[ymin, ymax] = std::minmax(begin, end, least_y);
+    auto const [xmin, xmax] = std::minmax_element(begin, end, least_x<Vector>);
+    auto const [ymin, ymax] = std::minmax_element(begin, end, least_y<Vector>);
 
-    Vector min(get_x(xmin), get_y(ymin));
-    Vector max(get_x(xmax), get_y(ymax));
+    Vector min(get_x(*xmin), get_y(*ymin));
+    Vector max(get_x(*xmax), get_y(*ymax));
     return std::make_pair(min, max);
 }
 
@@ -689,12 +703,23 @@ auto bounding_corners2d(Range && points)
 {
     using Vector = ranges::range_value_t<Range>;
 
-    // find the points with the least and greatest x and y coordinates
-    auto const &[xmin, xmax] = ranges::minmax(points, least_x);
-    auto const &[ymin, ymax] = ranges::minmax(points, least_y);
+    // find the least and greatest x and y coordinates in a single pass, so
+    // that lazy views are only evaluated once per point
+    auto it = ranges::begin(points);
+    auto const last = ranges::end(points);
+    Vector const first = *it;
+    auto xmin = get_x(first), xmax = xmin;
+    auto ymin = get_y(first), ymax = ymin;
+    for (++it; it != last; ++it) {
+        Vector const p = *it;
+        xmin = std::min(xmin, get_x(p));
+        xmax = std::max(xmax, get_x(p));
+        ymin = std::min(ymin, get_y(p));
+        ymax = std::max(ymax, get_y(p));
+    }
 
-    Vector min(get_x(xmin), get_y(ymin));
-    Vector max(get_x(xmax), get_y(ymax));
+    Vector min(xmin, ymin);
+    Vector max(xmax, ymax);
     return std::make_pair(min, max);
 }
 
@@ -0,0 +1,286 @@
+#pragma once
+
+// type constraints
+#include <type_traits>
+#include <concepts>
+#include <ranges>
+#include "spatula/vectors.hpp"
+
+// data types and data structures
+#include <cstddef>
+#include <utility>
+
+// algorithms
+#include <algorithm>
+
+namespace sp {
+
+namespace detail {
+
+template<class T>
+concept scalar_argument = std::is_arithmetic_v<T>;
+
+// a number or a vector of the same dimension as Vector
+template<class Operand, class Vector>
+concept component_operand =
+    scalar_argument<Operand> or
+    (semivector<Operand> and dimension_v<Operand> == dimension_v<Vector>);
+
+// the i-th component of a vector operand, or a number applied to every component
+template<std::size_t I, class Operand>
+constexpr auto operand_component(Operand const & x)
+{
+    if constexpr (scalar_argument<Operand>) { return x; }
+    else { return get_component<I>(x); }
+}
+
+// a vector whose components are the results of f applied to each component index
+template<class Vector, class Function>
+constexpr Vector map_components(Function && f)
+{
+    using scalar = scalar_field_t<Vector>;
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return Vector{static_cast<scalar>(f(std::integral_constant<std::size_t, I>{}))...};
+    }(std::make_index_sequence<dimension_v<Vector>>{});
+}
+
+template<class Operand>
+struct add_components {
+    Operand offset;
+
+    template<semivector Vector>
+        requires component_operand<Operand, Vector>
+    constexpr Vector operator()(Vector const & v) const
+    {
+        return map_components<Vector>([&](auto i) {
+            return get_component<i>(v) + operand_component<i>(offset);
+        });
+    }
+};
+
+template<class Operand>
+struct subtract_components {
+    Operand offset;
+
+    template<semivector Vector>
+        requires component_operand<Operand, Vector>
+    constexpr Vector operator()(Vector const & v) const
+    {
+        return map_components<Vector>([&](auto i) {
+            return get_component<i>(v) - operand_component<i>(offset);
+        });
+    }
+};
+
+template<class Operand>
+struct scale_components {
+    Operand factor;
+
+    template<semivector Vector>
+        requires component_operand<Operand, Vector>
+    constexpr Vector operator()(Vector const & v) const
+    {
+        return map_components<Vector>([&](auto i) {
+            return get_component<i>(v) * operand_component<i>(factor);
+        });
+    }
+};
+
+template<class Target, class Weight>
+struct lerp_components {
+    Target target;
+    Weight t;
+
+    template<semivector Vector>
+        requires component_operand<Target, Vector>
+    constexpr Vector operator()(Vector const & v) const
+    {
+        return map_components<Vector>([&](auto i) {
+            auto const a = get_component<i>(v);
+            return a + (operand_component<i>(target) - a) * t;
+        });
+    }
+};
+
+template<class Lower, class Upper>
+struct clamp_components {
+    Lower lower;
+    Upper upper;
+
+    template<semivector Vector>
+        requires component_operand<Lower, Vector> and
+                 component_operand<Upper, Vector> and
+                 std::totally_ordered<scalar_field_t<Vector>>
+    constexpr Vector operator()(Vector const & v) const
+    {
+        using scalar = scalar_field_t<Vector>;
+        return map_components<Vector>([&](auto i) {
+            return std::clamp(get_component<i>(v),
+                              static_cast<scalar>(operand_component<i>(lower)),
+                              static_cast<scalar>(operand_component<i>(upper)));
+        });
+    }
+};
+
+// f followed by g, so that a chain of adaptors is applied in one transform
+template<class F, class G>
+struct composed_components {
+    F f;
+    G g;
+
+    template<class Vector>
+        requires std::invocable<F const &, Vector const &> and
+                 std::invocable<G const &, std::invoke_result_t<F const &, Vector const &>>
+    constexpr auto operator()(Vector const & v) const
+    {
+        return g(f(v));
+    }
+};
+}
+
+namespace views {
+
+/** A pipeable adaptor that applies a function to each vector of a range.
+ *
+ * Piping a range into the adaptor gives a lazy view of the results, and
+ * piping one adaptor into another fuses them, so that the whole chain is
+ * applied to each vector in a single step as the view is iterated.
+ */
+template<class Function>
+class component_adaptor {
+public:
+    explicit constexpr component_adaptor(Function f) : _function(std::move(f)) {}
+
+    constexpr Function const & function() const { return _function; }
+
+    template<ranges::viewable_range Range>
+        requires semivector<ranges::range_value_t<Range>> and
+                 std::invocable<Function const &, ranges::range_reference_t<Range>>
+    constexpr auto operator()(Range && points) const
+    {
+        return ranges::views::transform(std::forward<Range>(points), _function);
+    }
+
+    template<ranges::viewable_range Range>
+        requires semivector<ranges::range_value_t<Range>> and
+                 std::invocable<Function const &, ranges::range_reference_t<Range>>
+    friend constexpr auto operator|(Range && points, component_adaptor const & adaptor)
+    {
+        return adaptor(std::forward<Range>(points));
+    }
+
+    template<class Next>
+    friend constexpr auto operator|(component_adaptor const & first,
+                                    component_adaptor<Next> const & next)
+    {
+        using composed = detail::composed_components<Function, Next>;
+        return component_adaptor<composed>{composed{first._function, next.function()}};
+    }
+private:
+    Function _function;
+};
+
+/** Lazily add an offset to each vector of a range.
+ *
+ * Parameters
+ *   offset - a vector of the same dimension as the points, or a number that's
+ *            added to every component
+ *
+ * Example:
+ *     auto const bounds = sp::bounding_corners2d(points | sp::views::add(origin));
+ */
+template<class Operand>
+    requires detail::scalar_argument<Operand> or semivector<Operand>
+
+constexpr auto add(Operand const & offset)
+{
+    return component_adaptor{detail::add_components<Operand>{offset}};
+}
+
+/** Lazily subtract an offset from each vector of a range. */
+template<class Operand>
+    requires detail::scalar_argument<Operand> or semivector<Operand>
+
+constexpr auto subtract(Operand const & offset)
+{
+    return component_adaptor{detail::subtract_components<Operand>{offset}};
+}
+
+/** Lazily scale each vector of a range, by a number or component-wise by a
+ * vector of the same dimension.
+ */
+template<class Operand>
+    requires detail::scalar_argument<Operand> or semivector<Operand>
+
+constexpr auto scale(Operand const & factor)
+{
+    return component_adaptor{detail::scale_components<Operand>{factor}};
+}
+
+/** Lazily interpolate each vector of a range toward a target.
+ *
+ * Each vector v becomes v + (target - v) * t, so t = 0 leaves the range as it
+ * is and t = 1 replaces every vector with the target.
+ */
+template<class Target, detail::scalar_argument Weight>
+    requires detail::scalar_argument<Target> or semivector<Target>
+
+constexpr auto lerp(Target const & target, Weight t)
+{
+    return component_adaptor{detail::lerp_components<Target, Weight>{target, t}};
+}
+
+/** Lazily clamp each component of the vectors of a range to [lower, upper],
+ * where either bound may be a number or a vector of the same dimension.
+ */
+template<class Lower, class Upper>
+    requires (detail::scalar_argument<Lower> or semivector<Lower>) and
+             (detail::scalar_argument<Upper> or semivector<Upper>)
+
+constexpr auto clamp(Lower const & lower, Upper const & upper)
+{
+    return component_adaptor{detail::clamp_components<Lower, Upper>{lower, upper}};
+}
+
+/** The range adaptors above, called with the range as the first argument. */
+template<ranges::viewable_range Range, class Operand>
+    requires semivector<ranges::range_value_t<Range>>
+
+constexpr auto add(Range && points, Operand const & offset)
+{
+    return std::forward<Range>(points) | add(offset);
+}
+
+template<ranges::viewable_range Range, class Operand>
+    requires semivector<ranges::range_value_t<Range>>
+
+constexpr auto subtract(Range && points, Operand const & offset)
+{
+    return std::forward<Range>(points) | subtract(offset);
+}
+
+template<ranges::viewable_range Range, class Operand>
+    requires semivector<ranges::range_value_t<Range>>
+
+constexpr auto scale(Range && points, Operand const & factor)
+{
+    return std::forward<Range>(points) | scale(factor);
+}
+
+template<ranges::viewable_range Range, class Target, class Weight>
+    requires semivector<ranges::range_value_t<Range>>
+
+constexpr auto lerp(Range && points, Target const & target, Weight t)
+{
+    return std::forward<Range>(points) | lerp(target, t);
+}
+
+template<ranges::viewable_range Range, class Lower, class Upper>
+    requires semivector<ranges::range_value_t<Range>>
+
+constexpr auto clamp(Range && points, Lower const & lower, Upper const & upper)
+{
+    return std::forward<Range>(points) | clamp(lower, upper);
+}
+}
+}
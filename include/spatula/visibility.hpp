@@ -0,0 +1,283 @@
+#pragma once
+
+// type constraints
+#include <concepts>
+#include <ranges>
+#include "spatula/vectors.hpp"
+#include "spatula/grids.hpp"
+#include "spatula/rings.hpp"
+
+// data types and data structures
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <iterator>
+
+// algorithms
+#include <algorithm>
+#include "spatula/parallel.hpp"
+
+namespace sp {
+
+/** Reusable working memory for field of view computations.
+ *
+ * A scratch object may be reused across calls to avoid allocating on every
+ * computation, but must not be shared between threads.
+ */
+struct fov_scratch {
+    struct scan {
+        int row;
+        double start_slope;
+        double end_slope;
+        int octant;
+    };
+    struct shadow {
+        double start;
+        double end;
+    };
+    std::vector<scan> scans;
+    std::vector<shadow> shadows;
+};
+
+namespace detail {
+
+// transforms from octant-local (dx, dy) offsets into grid offsets
+constexpr std::array<std::array<int, 4>, 8> octant_transforms{{
+    {1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}, {-1, 0, 0, 1},
+    {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}
+}};
+
+// determine if [start, end] is fully covered by a set of sorted, disjoint
+// shadows
+inline bool in_shadow(std::vector<fov_scratch::shadow> const & shadows,
+                      double start, double end)
+{
+    auto const covering = std::ranges::upper_bound(
+        shadows, start, {}, &fov_scratch::shadow::start);
+    return covering != shadows.begin() and std::prev(covering)->end >= end;
+}
+
+// add [start, end] to a set of sorted, disjoint shadows
+inline void cast_shadow(std::vector<fov_scratch::shadow> & shadows,
+                        double start, double end)
+{
+    auto first = std::ranges::lower_bound(
+        shadows, start, {}, &fov_scratch::shadow::end);
+    auto last = first;
+    while (last != shadows.end() and last->start <= end) {
+        start = std::min(start, last->start);
+        end = std::max(end, last->end);
+        ++last;
+    }
+    first = shadows.erase(first, last);
+    shadows.insert(first, fov_scratch::shadow{start, end});
+}
+}
+
+/** Mark the square-grid cells visible from a point.
+ *
+ * Parameters
+ *   origin - the point to view from
+ *   radius - the maximum euclidean distance a cell may be from origin
+ *   is_opaque - predicate determining if a cell blocks vision
+ *   visible - the cells visible from origin are set, all others are reset
+ *   scratch - working memory to reuse between calls
+ *
+ * Visibility is computed with recursive shadowcasting over each octant, with
+ * the recursion kept on an explicit stack in scratch. Cells outside of visible
+ * are treated as opaque. A cell is visible if any part of it is lit, so opaque
+ * cells bordering a lit area are visible as well.
+ */
+template<grid_point Vector, std::predicate<Vector> Opaque>
+void field_of_view(Vector const & origin, int radius, Opaque && is_opaque,
+                   bit_grid & visible, fov_scratch & scratch)
+{
+    using scalar = scalar_field_t<Vector>;
+    visible.clear();
+
+    auto const cx = get_x(origin);
+    auto const cy = get_y(origin);
+    if (not visible.contains(cx, cy)) { return; }
+    visible.set(cx, cy);
+
+    auto const radius2 = static_cast<long long>(radius) * radius;
+    auto & scans = scratch.scans;
+    scans.clear();
+    for (int octant = 0; octant < 8; ++octant) {
+        scans.push_back({1, 1.0, 0.0, octant});
+    }
+
+    while (not scans.empty()) {
+        auto [row, start, end, octant] = scans.back();
+        scans.pop_back();
+        if (start < end) { continue; }
+
+        auto const [xx, xy, yx, yy] = detail::octant_transforms[octant];
+        double next_start = start;
+        for (int j = row; j <= radius; ++j) {
+            int const dy = -j;
+            bool blocked = false;
+            for (int dx = -j; dx <= 0; ++dx) {
+                double const left_slope = (dx - 0.5) / (dy + 0.5);
+                double const right_slope = (dx + 0.5) / (dy - 0.5);
+                if (start < right_slope) { continue; }
+                if (end > left_slope) { break; }
+
+                scalar const x = cx + static_cast<scalar>(dx*xx + dy*xy);
+                scalar const y = cy + static_cast<scalar>(dx*yx + dy*yy);
+                bool const inside = visible.contains(x, y);
+                bool const opaque = not inside or is_opaque(Vector{x, y});
+                if (inside and static_cast<long long>(dx)*dx + dy*dy <= radius2) {
+                    visible.set(x, y);
+                }
+
+                if (blocked) {
+                    if (opaque) { next_start = right_slope; }
+                    else { blocked = false; start = next_start; }
+                }
+                else if (opaque and j < radius) {
+                    blocked = true;
+                    scans.push_back({j + 1, start, left_slope, octant});
+                    next_start = right_slope;
+                }
+            }
+            if (blocked) { break; }
+        }
+    }
+}
+
+template<grid_point Vector, std::predicate<Vector> Opaque>
+void field_of_view(Vector const & origin, int radius, Opaque && is_opaque,
+                   bit_grid & visible)
+{
+    fov_scratch scratch;
+    field_of_view(origin, radius, is_opaque, visible, scratch);
+}
+
+/** Mark the square-grid cells visible from each of a set of points.
+ *
+ * Parameters
+ *   viewers - the points to view from
+ *   radius - the maximum euclidean distance a cell may be from its viewer
+ *   is_opaque - thread-safe predicate determining if a cell blocks vision
+ *   visible - one grid per viewer, overwritten with the cells it can see
+ *
+ * Viewers are processed in parallel, with one scratch buffer per worker.
+ */
+template<ranges::random_access_range Viewers,
+         ranges::random_access_range Outputs,
+         std::predicate<ranges::range_value_t<Viewers>> Opaque>
+    requires grid_point<ranges::range_value_t<Viewers>> and
+             std::same_as<ranges::range_value_t<Outputs>, bit_grid>
+
+void field_of_view(Viewers && viewers, int radius, Opaque && is_opaque,
+                   Outputs && visible)
+{
+    auto const count = static_cast<std::size_t>(ranges::size(viewers));
+    parallel_for(count, [&](std::size_t, std::size_t first, std::size_t last) {
+        fov_scratch scratch;
+        for (std::size_t i = first; i < last; ++i) {
+            field_of_view(ranges::begin(viewers)[i], radius, is_opaque,
+                          ranges::begin(visible)[i], scratch);
+        }
+    });
+}
+
+/** Mark the hex-grid cells visible from an axial point.
+ *
+ * Parameters
+ *   origin - the point to view from
+ *   radius - the maximum hex distance a cell may be from origin
+ *   is_opaque - predicate determining if a cell blocks vision
+ *   visible - the cells visible from origin are set, all others are reset
+ *   scratch - working memory to reuse between calls
+ *
+ * Visibility is computed by shadowcasting ring by ring. Angles are measured
+ * along the perimeter of each ring, which is the same for every ring up to
+ * scale, so a hex at index i of ring k spans [i - 1/2, i + 1/2] / k of the six
+ * sides. Cells outside of visible are treated as opaque. A cell is visible if
+ * any part of it is lit, so opaque cells bordering a lit area are visible too.
+ */
+template<grid_point Vector, std::predicate<Vector> Opaque>
+void hex_field_of_view(Vector const & origin, int radius, Opaque && is_opaque,
+                       bit_grid & visible, fov_scratch & scratch)
+{
+    visible.clear();
+
+    auto const cq = get_x(origin);
+    auto const cr = get_y(origin);
+    if (not visible.contains(cq, cr)) { return; }
+    visible.set(cq, cr);
+
+    auto & shadows = scratch.shadows;
+    shadows.clear();
+    for (int k = 1; k <= radius; ++k) {
+        using ring_order = pointed_hex::direction_name;
+        double const half_width = 0.5 / k;
+
+        int i = 0;
+        for (Vector const & hex : views::hex_ring<ring_order>(origin, k)) {
+            double const middle = static_cast<double>(i) / k;
+            double const start = middle - half_width;
+            double const end = middle + half_width;
+
+            // the first hex of each ring straddles the starting angle
+            bool const lit = i == 0?
+                not (detail::in_shadow(shadows, 0.0, end) and
+                     detail::in_shadow(shadows, 6.0 + start, 6.0)) :
+                not detail::in_shadow(shadows, start, end);
+
+            bool const inside = visible.contains(hex);
+            if (lit and inside) { visible.set(get_x(hex), get_y(hex)); }
+            if (not inside or is_opaque(hex)) {
+                if (i == 0) {
+                    detail::cast_shadow(shadows, 0.0, end);
+                    detail::cast_shadow(shadows, 6.0 + start, 6.0);
+                }
+                else {
+                    detail::cast_shadow(shadows, start, end);
+                }
+            }
+            ++i;
+        }
+        if (detail::in_shadow(shadows, 0.0, 6.0)) { break; }
+    }
+}
+
+template<grid_point Vector, std::predicate<Vector> Opaque>
+void hex_field_of_view(Vector const & origin, int radius, Opaque && is_opaque,
+                       bit_grid & visible)
+{
+    fov_scratch scratch;
+    hex_field_of_view(origin, radius, is_opaque, visible, scratch);
+}
+
+/** Mark the hex-grid cells visible from each of a set of axial points.
+ *
+ * Parameters
+ *   viewers - the points to view from
+ *   radius - the maximum hex distance a cell may be from its viewer
+ *   is_opaque - thread-safe predicate determining if a cell blocks vision
+ *   visible - one grid per viewer, overwritten with the cells it can see
+ *
+ * Viewers are processed in parallel, with one scratch buffer per worker.
+ */
+template<ranges::random_access_range Viewers,
+         ranges::random_access_range Outputs,
+         std::predicate<ranges::range_value_t<Viewers>> Opaque>
+    requires grid_point<ranges::range_value_t<Viewers>> and
+             std::same_as<ranges::range_value_t<Outputs>, bit_grid>
+
+void hex_field_of_view(Viewers && viewers, int radius, Opaque && is_opaque,
+                       Outputs && visible)
+{
+    auto const count = static_cast<std::size_t>(ranges::size(viewers));
+    parallel_for(count, [&](std::size_t, std::size_t first, std::size_t last) {
+        fov_scratch scratch;
+        for (std::size_t i = first; i < last; ++i) {
+            hex_field_of_view(ranges::begin(viewers)[i], radius, is_opaque,
+                              ranges::begin(visible)[i], scratch);
+        }
+    });
+}
+}
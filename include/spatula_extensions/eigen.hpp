@@ -3,6 +3,10 @@
 #include <Eigen/Dense>
 #include <tuple>
 #include <cstddef>
+#include <array>
+#include <ranges>
+#include <type_traits>
+#include "spatula/layouts.hpp"
 
 //
 // tuple size
@@ -44,3 +48,72 @@ template<std::size_t i, typename Field>
 struct std::tuple_element<i, Eigen::Matrix<Field, 4, 1>> {
     using type = typename std::add_const<Field>::type;
 };
+
+//
+// component layouts
+//
+
+template<typename Field, int N>
+    requires (N >= 2 and N <= 4)
+struct sp::component_layout<Eigen::Matrix<Field, N, 1>> {
+    static constexpr std::array<std::size_t, N> offsets = [] {
+        std::array<std::size_t, N> offsets{};
+        for (std::size_t i = 0; i < N; ++i) { offsets[i] = i * sizeof(Field); }
+        return offsets;
+    }();
+};
+
+//
+// mapping foreign vectors
+//
+
+namespace sp {
+
+/** The Eigen::Map type that views a contiguous array of Vector. */
+template<ordered_layout Vector, bool Const = false>
+using eigen_map_t = std::conditional_t<packed_layout<Vector>,
+    Eigen::Map<std::conditional_t<Const,
+        Eigen::Matrix<scalar_field_t<Vector>, dimension_v<Vector>, Eigen::Dynamic> const,
+        Eigen::Matrix<scalar_field_t<Vector>, dimension_v<Vector>, Eigen::Dynamic>>>,
+    Eigen::Map<std::conditional_t<Const,
+        Eigen::Matrix<scalar_field_t<Vector>, dimension_v<Vector>, Eigen::Dynamic> const,
+        Eigen::Matrix<scalar_field_t<Vector>, dimension_v<Vector>, Eigen::Dynamic>>,
+        Eigen::Unaligned,
+        Eigen::OuterStride<static_cast<int>(component_stride_v<Vector>)>>>;
+
+/** View a contiguous range of vectors as the columns of an Eigen matrix.
+ *
+ * Return
+ *   An Eigen::Map with one column per vector that reads and writes points in
+ *   place, so Eigen's vectorized kernels can transform or reduce them without
+ *   copying. Vectors that are padded are mapped with an outer stride. The map
+ *   is read-only if the range's elements are const.
+ *
+ * Parameters
+ *   points - a contiguous range of vectors whose components are stored in
+ *            order, such as std::vector<SDL_Point> or std::vector<sf::Vector2f>
+ *
+ * Example:
+ *     std::vector<sf::Vector2f> points = ...;
+ *     auto columns = sp::eigen_map(points);
+ *     columns = rotation * columns;
+ *     Eigen::Vector2f const centroid = columns.rowwise().mean();
+ */
+template<std::ranges::contiguous_range Range>
+    requires std::ranges::sized_range<Range> and
+             ordered_layout<std::ranges::range_value_t<Range>>
+
+auto eigen_map(Range && points)
+{
+    using Vector = std::ranges::range_value_t<Range>;
+    using scalar = scalar_field_t<Vector>;
+    using element = std::remove_reference_t<std::ranges::range_reference_t<Range>>;
+    constexpr bool is_const = std::is_const_v<element>;
+    using pointer = std::conditional_t<is_const, scalar const *, scalar *>;
+
+    return eigen_map_t<Vector, is_const>(
+        reinterpret_cast<pointer>(std::ranges::data(points)),
+        dimension_v<Vector>,
+        static_cast<Eigen::Index>(std::ranges::size(points)));
+}
+}
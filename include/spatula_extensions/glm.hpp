@@ -3,6 +3,8 @@
 #include <glm/glm.hpp>
 #include <tuple>
 #include <cstddef>
+#include <array>
+#include "spatula/layouts.hpp"
 
 template<>
 struct std::tuple_size<glm::vec2> {
@@ -63,3 +65,13 @@ template<>
 struct std::tuple_size<glm::uvec4> {
     static constexpr std::size_t value = 4;
 };
+
+template<glm::length_t L, typename Field, glm::qualifier Q>
+    requires (L >= 2 and L <= 4)
+struct sp::component_layout<glm::vec<L, Field, Q>> {
+    static constexpr std::array<std::size_t, L> offsets = [] {
+        std::array<std::size_t, L> offsets{};
+        for (std::size_t i = 0; i < L; ++i) { offsets[i] = i * sizeof(Field); }
+        return offsets;
+    }();
+};
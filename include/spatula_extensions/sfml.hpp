@@ -3,6 +3,8 @@
 #include <SFML/System.hpp>
 #include <tuple>
 #include <cstddef>
+#include <array>
+#include "spatula/layouts.hpp"
 
 //
 // tuple size
@@ -33,3 +35,22 @@ template<std::size_t i, typename Field>
 struct std::tuple_element<i, sf::Vector3<Field>> {
     using type = typename std::add_const<Field>::type;
 };
+
+//
+// component layouts
+//
+
+template<typename Field>
+struct sp::component_layout<sf::Vector2<Field>> {
+    static constexpr std::array<std::size_t, 2> offsets{
+        offsetof(sf::Vector2<Field>, x), offsetof(sf::Vector2<Field>, y)
+    };
+};
+
+template<typename Field>
+struct sp::component_layout<sf::Vector3<Field>> {
+    static constexpr std::array<std::size_t, 3> offsets{
+        offsetof(sf::Vector3<Field>, x), offsetof(sf::Vector3<Field>, y),
+        offsetof(sf::Vector3<Field>, z)
+    };
+};
@@ -0,0 +1,87 @@
+#include "spatula/point_codec.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Reports the compressed size of encode_points in bytes per point, and the
+// encoding and decoding throughput in megabytes of uncompressed points per
+// second, for a random cloud and for a coherent terrain scan
+
+namespace bench_point_codec {
+struct vec3 { float x, y, z; };
+
+constexpr std::size_t point_count = 1'000'000;
+constexpr int repetitions = 5;
+
+// the fastest of a few runs, in seconds
+template<class Function>
+double fastest(Function function)
+{
+    double best = 1e300;
+    for (int k = 0; k < repetitions; ++k) {
+        auto const start = std::chrono::steady_clock::now();
+        function();
+        auto const end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+void measure(char const * input, std::vector<vec3> const & points,
+             sp::point_encoding const & encoding)
+{
+    std::vector<std::byte> bytes;
+    double const encoding_time = fastest([&] {
+        bytes = sp::encode_points(points, encoding);
+    });
+    std::vector<vec3> decoded;
+    double const decoding_time = fastest([&] {
+        decoded = sp::decode_points<vec3>(bytes);
+    });
+
+    double const megabytes = points.size() * sizeof(vec3) / 1e6;
+    std::printf("%-8s %-7s %6.2f %10.1f %10.1f\n", input,
+                encoding.morton_order? "morton" : "input",
+                static_cast<double>(bytes.size()) / points.size(),
+                megabytes / encoding_time, megabytes / decoding_time);
+}
+}
+
+using namespace bench_point_codec;
+
+int main()
+{
+    std::mt19937 rng{1};
+
+    // scattered points in a 100 meter cube
+    std::uniform_real_distribution<float> coordinate(-50.f, 50.f);
+    std::vector<vec3> cloud(point_count);
+    for (auto & p : cloud) { p = {coordinate(rng), coordinate(rng), coordinate(rng)}; }
+
+    // a scan of rolling terrain, row by row at 5 centimeter spacing
+    std::normal_distribution<float> noise(0.f, 0.002f);
+    std::vector<vec3> terrain;
+    terrain.reserve(point_count);
+    std::size_t const width = 1000;
+    for (std::size_t k = 0; k < point_count; ++k) {
+        float const x = static_cast<float>(k % width) * 0.05f;
+        float const y = static_cast<float>(k / width) * 0.05f;
+        float const z = 3.f * std::sin(x * 0.1f) * std::cos(y * 0.13f) + noise(rng);
+        terrain.push_back({x, y, z});
+    }
+
+    std::printf("raw points take %zu bytes each; MB/s counts raw point bytes\n",
+                sizeof(vec3));
+    std::printf("%-8s %-7s %6s %10s %10s\n",
+                "input", "order", "B/pt", "enc MB/s", "dec MB/s");
+    for (bool const morton_order : {true, false}) {
+        sp::point_encoding const encoding{.morton_order = morton_order};
+        measure("cloud", cloud, encoding);
+        measure("terrain", terrain, encoding);
+    }
+}
@@ -0,0 +1,174 @@
+#include "spatula/predicates.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <numbers>
+#include <random>
+#include <vector>
+
+// Counts how many queries each predicate decides with its floating-point filter
+// and how many fall back to exact arithmetic, and times the queries, for random
+// inputs and for inputs rounded from degenerate configurations
+
+namespace bench_predicates {
+struct vec2 { double x, y; };
+struct vec3 { double x, y, z; };
+
+constexpr std::size_t query_count = 200'000;
+
+struct result {
+    std::size_t filtered = 0;
+    double nanoseconds = 0;
+};
+
+// count the queries the filter decides, then time the predicate over them
+template<class Filter, class Predicate>
+result measure(Filter filter, Predicate predicate)
+{
+    result r;
+    for (std::size_t k = 0; k < query_count; ++k) {
+        double det, bound;
+        filter(k, det, bound);
+        if (std::abs(det) > bound) { ++r.filtered; }
+    }
+    double sum = 0;
+    auto const start = std::chrono::steady_clock::now();
+    for (std::size_t k = 0; k < query_count; ++k) { sum += predicate(k); }
+    auto const end = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::nano> const elapsed = end - start;
+    r.nanoseconds = elapsed.count() / query_count;
+
+    // keep the predicate from being optimized away
+    volatile double sink = sum;
+    (void)sink;
+    return r;
+}
+
+void report(char const * predicate, char const * input, result const & r)
+{
+    std::printf("%-9s %-16s %10zu %10zu %9.1f\n", predicate, input, r.filtered,
+                query_count - r.filtered, r.nanoseconds);
+}
+
+using sp::detail::coordinates;
+
+void orient2d(char const * input, vec2 a, vec2 b, std::vector<vec2> const & points)
+{
+    auto const pa = coordinates<2>(a), pb = coordinates<2>(b);
+    report("orient2d", input, measure(
+        [&](std::size_t k, double & det, double & bound) {
+            auto const p = coordinates<2>(points[k]);
+            sp::detail::orient2d_filter(pa.data(), pb.data(), p.data(), det, bound);
+        },
+        [&](std::size_t k) { return sp::orient2d(a, b, points[k]); }));
+}
+
+void orient3d(char const * input, vec3 a, vec3 b, vec3 c,
+              std::vector<vec3> const & points)
+{
+    auto const pa = coordinates<3>(a), pb = coordinates<3>(b), pc = coordinates<3>(c);
+    report("orient3d", input, measure(
+        [&](std::size_t k, double & det, double & bound) {
+            auto const p = coordinates<3>(points[k]);
+            sp::detail::orient3d_filter(pa.data(), pb.data(), pc.data(), p.data(),
+                                        det, bound);
+        },
+        [&](std::size_t k) { return sp::orient3d(a, b, c, points[k]); }));
+}
+
+void incircle(char const * input, vec2 a, vec2 b, vec2 c,
+              std::vector<vec2> const & points)
+{
+    auto const pa = coordinates<2>(a), pb = coordinates<2>(b), pc = coordinates<2>(c);
+    report("incircle", input, measure(
+        [&](std::size_t k, double & det, double & bound) {
+            auto const p = coordinates<2>(points[k]);
+            sp::detail::incircle_filter(pa.data(), pb.data(), pc.data(), p.data(),
+                                        det, bound);
+        },
+        [&](std::size_t k) { return sp::incircle(a, b, c, points[k]); }));
+}
+
+void insphere(char const * input, vec3 a, vec3 b, vec3 c, vec3 d,
+              std::vector<vec3> const & points)
+{
+    auto const pa = coordinates<3>(a), pb = coordinates<3>(b);
+    auto const pc = coordinates<3>(c), pd = coordinates<3>(d);
+    report("insphere", input, measure(
+        [&](std::size_t k, double & det, double & bound) {
+            auto const p = coordinates<3>(points[k]);
+            sp::detail::insphere_filter(pa.data(), pb.data(), pc.data(), pd.data(),
+                                        p.data(), det, bound);
+        },
+        [&](std::size_t k) { return sp::insphere(a, b, c, d, points[k]); }));
+}
+}
+
+using namespace bench_predicates;
+
+int main()
+{
+    std::mt19937 rng{1};
+    std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::normal_distribution<double> normal;
+
+    std::vector<vec2> planar(query_count);
+    std::vector<vec3> spatial(query_count);
+    auto const random2 = [&] { return vec2{coordinate(rng), coordinate(rng)}; };
+    auto const random3 = [&] {
+        return vec3{coordinate(rng), coordinate(rng), coordinate(rng)};
+    };
+
+    std::printf("%-9s %-16s %10s %10s %9s\n",
+                "predicate", "input", "filtered", "exact", "ns/query");
+
+    // uniformly random points, which the filter should nearly always decide
+    for (auto & p : planar) { p = random2(); }
+    for (auto & p : spatial) { p = random3(); }
+    orient2d("random", random2(), random2(), planar);
+    orient3d("random", random3(), random3(), random3(), spatial);
+    incircle("random", random2(), random2(), random2(), planar);
+    insphere("random", random3(), random3(), random3(), random3(), spatial);
+
+    // points on a line or plane, rounded to the nearest doubles
+    vec2 const a2{0.1, 0.7}, b2{9.3, -3.1};
+    for (auto & p : planar) {
+        double const t = unit(rng);
+        p = {a2.x + t * (b2.x - a2.x), a2.y + t * (b2.y - a2.y)};
+    }
+    orient2d("near-collinear", a2, b2, planar);
+
+    vec3 const a3{0.1, 0.7, -0.3}, b3{9.3, -3.1, 1.7}, c3{-4.9, 2.3, 6.1};
+    for (auto & p : spatial) {
+        double const s = unit(rng), t = unit(rng);
+        p = {a3.x + s * (b3.x - a3.x) + t * (c3.x - a3.x),
+             a3.y + s * (b3.y - a3.y) + t * (c3.y - a3.y),
+             a3.z + s * (b3.z - a3.z) + t * (c3.z - a3.z)};
+    }
+    orient3d("near-coplanar", a3, b3, c3, spatial);
+
+    // points on a circle or sphere, rounded to the nearest doubles
+    vec2 const center2{0.3, -1.1};
+    double const radius = 7.3;
+    auto const on_circle = [&] {
+        double const angle = 2 * std::numbers::pi * unit(rng);
+        return vec2{center2.x + radius * std::cos(angle),
+                    center2.y + radius * std::sin(angle)};
+    };
+    for (auto & p : planar) { p = on_circle(); }
+    incircle("near-cocircular", on_circle(), on_circle(), on_circle(), planar);
+
+    vec3 const center3{0.3, -1.1, 2.9};
+    auto const on_sphere = [&] {
+        double const x = normal(rng), y = normal(rng), z = normal(rng);
+        double const scale = radius / std::sqrt(x * x + y * y + z * z);
+        return vec3{center3.x + scale * x, center3.y + scale * y,
+                    center3.z + scale * z};
+    };
+    for (auto & p : spatial) { p = on_sphere(); }
+    insphere("near-cospherical", on_sphere(), on_sphere(), on_sphere(), on_sphere(),
+             spatial);
+}
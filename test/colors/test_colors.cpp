@@ -0,0 +1,201 @@
+#include <catch2/catch.hpp>
+#include "spatula/colors.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace test_colors {
+struct color { std::uint8_t r, g, b, a; };
+struct bgra { std::uint8_t b, g, r, a; };
+struct vec4 { std::uint8_t x, y, z, w; };
+
+bool same(color const & a, color const & b)
+{
+    return a.r == b.r and a.g == b.g and a.b == b.b and a.a == b.a;
+}
+
+std::vector<color> random_colors(std::size_t count, unsigned seed)
+{
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<int> channel(0, 255);
+    std::vector<color> colors(count);
+    for (auto & c : colors) {
+        c = color{static_cast<std::uint8_t>(channel(rng)),
+                  static_cast<std::uint8_t>(channel(rng)),
+                  static_cast<std::uint8_t>(channel(rng)),
+                  static_cast<std::uint8_t>(channel(rng))};
+    }
+    // make sure the extreme alphas show up in every register
+    for (std::size_t i = 0; i < count; i += 3) { colors[i].a = i % 2 == 0? 0 : 255; }
+    return colors;
+}
+
+std::uint8_t rounded(double x)
+{
+    return static_cast<std::uint8_t>(std::floor(x + .5));
+}
+
+// compare a batch operation against the same operation one color at a time,
+// over sizes that end partway through a register
+template<class Batch, class Single>
+void require_batch_matches(Batch batch, Single single)
+{
+    for (std::size_t count : {0, 1, 3, 4, 7, 8, 13, 16, 35, 1000}) {
+        auto const colors = random_colors(count, static_cast<unsigned>(count));
+        std::vector<color> actual(count);
+        REQUIRE(batch(colors, actual.begin()) == actual.end());
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(same(actual[i], single(colors[i])));
+        }
+    }
+}
+}
+
+using namespace sp;
+using namespace test_colors;
+
+TEST_CASE("rgba8_color:concept", "[colors]") {
+    STATIC_REQUIRE(rgba8_color<color>);
+    STATIC_REQUIRE(not rgba8_color<bgra>);
+    STATIC_REQUIRE(not rgba8_color<vec4>);
+}
+
+TEST_CASE("premultiply:exact", "[colors]") {
+    for (unsigned a = 0; a < 256; ++a) {
+    for (unsigned c = 0; c < 256; ++c) {
+        auto const channel = static_cast<std::uint8_t>(c);
+        auto const alpha = static_cast<std::uint8_t>(a);
+        auto const p = premultiply(color{channel, 0, 255, alpha});
+        REQUIRE(p.r == rounded(c * a / 255.0));
+        REQUIRE(p.b == alpha);
+        REQUIRE(p.a == alpha);
+
+        auto const u = unpremultiply(color{channel, 0, 0, alpha});
+        if (a == 0) {
+            REQUIRE(same(u, color{0, 0, 0, 0}));
+        }
+        else {
+            REQUIRE(u.r == std::min<unsigned>(255, rounded(std::min(255.0, c * 255.0 / a))));
+            REQUIRE(u.a == alpha);
+        }
+    }}
+    // premultiplying loses precision, but unpremultiplying recovers opaque colors
+    REQUIRE(same(unpremultiply(premultiply(color{10, 20, 30, 255})),
+                 color{10, 20, 30, 255}));
+}
+
+TEST_CASE("premultiply:batch", "[colors]") {
+    require_batch_matches(
+        [](auto const & colors, auto out) { return premultiply(colors, out); },
+        [](color const & c) { return premultiply(c); });
+    require_batch_matches(
+        [](auto const & colors, auto out) { return unpremultiply(colors, out); },
+        [](color const & c) { return unpremultiply(c); });
+
+    // in place, and through iterators that aren't contiguous
+    auto colors = random_colors(21, 1);
+    std::list<color> const listed(colors.begin(), colors.end());
+    std::vector<color> expected;
+    premultiply(listed, std::back_inserter(expected));
+    premultiply(colors, colors.begin());
+    REQUIRE(std::ranges::equal(colors, expected, same));
+}
+
+TEST_CASE("blend:exact", "[colors]") {
+    color const destination{200, 100, 0, 128};
+    REQUIRE(same(blend(color{0, 0, 255, 0}, destination), destination));
+    REQUIRE(same(blend(color{0, 0, 255, 255}, destination), color{0, 0, 255, 255}));
+
+    auto const half = blend(color{0, 50, 255, 128}, destination);
+    REQUIRE(half.r == rounded((200 * 127) / 255.0));
+    REQUIRE(half.g == rounded((50 * 128 + 100 * 127) / 255.0));
+    REQUIRE(half.b == rounded((255 * 128) / 255.0));
+    REQUIRE(half.a == rounded(128 + 128 * 127 / 255.0));
+}
+
+TEST_CASE("blend:batch", "[colors]") {
+    for (std::size_t count : {0, 5, 8, 12, 17, 999}) {
+        auto const sources = random_colors(count, 2);
+        auto destinations = random_colors(count + 3, 3);
+        std::vector<color> actual(count);
+        REQUIRE(blend(sources, destinations, actual.begin()) == actual.end());
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(same(actual[i], blend(sources[i], destinations[i])));
+        }
+        blend(sources, destinations, destinations.begin());
+        REQUIRE(std::equal(actual.begin(), actual.end(), destinations.begin(), same));
+    }
+}
+
+TEST_CASE("lerp:colors", "[colors]") {
+    color const a{0, 100, 255, 0};
+    color const b{255, 200, 255, 255};
+    REQUIRE(same(lerp(a, b, 0.f), a));
+    REQUIRE(same(lerp(a, b, 1.f), b));
+    REQUIRE(same(lerp(a, b, 2.f), b));
+    REQUIRE(same(lerp(a, b, .5f), color{128, 150, 255, 128}));
+
+    for (float t : {0.f, .1f, .5f, .77f, 1.f}) {
+        auto const from = random_colors(29, 4);
+        auto const to = random_colors(29, 5);
+        std::vector<color> actual(from.size());
+        REQUIRE(lerp(from, to, t, actual.begin()) == actual.end());
+        for (std::size_t i = 0; i < from.size(); ++i) {
+            REQUIRE(same(actual[i], lerp(from[i], to[i], t)));
+        }
+    }
+}
+
+TEST_CASE("srgb_to_linear", "[colors]") {
+    REQUIRE(same(srgb_to_linear(color{0, 255, 188, 7}), color{0, 255, 128, 7}));
+    REQUIRE(same(linear_to_srgb(color{0, 255, 128, 7}), color{0, 255, 188, 7}));
+
+    // both tables round, so a round trip is off by at most one step
+    for (unsigned c = 0; c < 256; ++c) {
+        color const linear{static_cast<std::uint8_t>(c), 0, 0, 255};
+        auto const round_trip = srgb_to_linear(linear_to_srgb(linear));
+        REQUIRE(std::abs(round_trip.r - linear.r) <= 1);
+    }
+
+    // 8-bit linear light merges dark sRGB levels, within the documented bound
+    std::vector<std::uint8_t> levels;
+    for (unsigned c = 0; c < 256; ++c) {
+        color const encoded{static_cast<std::uint8_t>(c), 0, 0, 255};
+        auto const linear = srgb_to_linear(encoded);
+        levels.push_back(linear.r);
+        REQUIRE(std::abs(linear_to_srgb(linear).r - encoded.r) <= 6);
+    }
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+    REQUIRE(levels.size() == 183);
+
+    // float linear light keeps every level
+    for (unsigned c = 0; c < 256; ++c) {
+        auto const channel = static_cast<std::uint8_t>(c);
+        REQUIRE(srgb_encode(srgb_decode(channel)) == channel);
+        REQUIRE(srgb_decode(channel) == Approx(srgb_to_linear(color{channel, 0, 0, 0}).r
+                                               / 255.0).margin(0.5 / 255));
+    }
+    REQUIRE(srgb_decode(255) == 1.f);
+    REQUIRE(srgb_encode(-1.f) == 0);
+    REQUIRE(srgb_encode(2.f) == 255);
+    REQUIRE(srgb_encode(0.2158605f) == 128);
+
+    require_batch_matches(
+        [](auto const & colors, auto out) { return srgb_to_linear(colors, out); },
+        [](color const & c) { return srgb_to_linear(c); });
+    require_batch_matches(
+        [](auto const & colors, auto out) { return linear_to_srgb(colors, out); },
+        [](color const & c) { return linear_to_srgb(c); });
+}
+
+TEST_CASE("swap_red_blue", "[colors]") {
+    REQUIRE(same(swap_red_blue(color{1, 2, 3, 4}), color{3, 2, 1, 4}));
+    require_batch_matches(
+        [](auto const & colors, auto out) { return swap_red_blue(colors, out); },
+        [](color const & c) { return swap_red_blue(c); });
+}
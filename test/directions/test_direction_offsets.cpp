@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+#include "spatula/directions.hpp"
+
+#include <Eigen/Dense>
+#include "spatula_extensions/eigen.hpp"
+
+#include <array>
+#include <set>
+#include <cstdint>
+
+namespace test_direction_offsets {
+struct point2i { int x, y; };
+struct point3f { float x, y, z; };
+struct point4d { double x, y, z, w; };
+
+enum class king_move : std::uint8_t {};
+enum class hypercube_face : std::uint8_t {};
+}
+
+using namespace test_direction_offsets;
+
+template<>
+struct sp::direction_offsets<king_move> : sp::neighborhood<2, 2> {};
+
+template<>
+struct sp::direction_offsets<hypercube_face> : sp::neighborhood<4, 1> {};
+
+using namespace sp;
+
+TEST_CASE("neighborhood_size", "[directions]") {
+    REQUIRE(neighborhood_size<2, 1>() == 4);
+    REQUIRE(neighborhood_size<2, 2>() == 8);
+    REQUIRE(neighborhood_size<3, 1>() == 6);
+    REQUIRE(neighborhood_size<3, 2>() == 18);
+    REQUIRE(neighborhood_size<3, 3>() == 26);
+    REQUIRE(neighborhood_size<4, 1>() == 8);
+}
+
+TEST_CASE("neighborhood_offsets:unique", "[directions]") {
+    constexpr auto offsets = neighborhood_offsets<3, 3>();
+    std::set<std::array<int, 3>> const unique(offsets.begin(), offsets.end());
+    REQUIRE(unique.size() == 26);
+    REQUIRE(not unique.contains({0, 0, 0}));
+}
+
+TEST_CASE("neighborhood_offsets:nested", "[directions]") {
+    constexpr auto faces = neighborhood_offsets<3, 1>();
+    constexpr auto edges = neighborhood_offsets<3, 2>();
+    constexpr auto corners = neighborhood_offsets<3, 3>();
+    for (std::size_t i = 0; i < faces.size(); ++i) {
+        REQUIRE(faces[i] == edges[i]);
+    }
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        REQUIRE(edges[i] == corners[i]);
+    }
+}
+
+TEST_CASE("enum_size:generated", "[directions]") {
+    REQUIRE(enum_size_v<cardinal::direction_name> == 4);
+    REQUIRE(enum_size_v<ordinal::direction_name> == 8);
+    REQUIRE(enum_size_v<flat_hex::direction_name> == 6);
+    REQUIRE(enum_size_v<pointed_hex::direction_name> == 6);
+    REQUIRE(enum_size_v<cubic6::direction_name> == 6);
+    REQUIRE(enum_size_v<cubic18::direction_name> == 18);
+    REQUIRE(enum_size_v<cubic26::direction_name> == 26);
+    REQUIRE(enum_size_v<king_move> == 8);
+    REQUIRE(enum_size_v<hypercube_face> == 8);
+}
+
+TEST_CASE("direction_as:2D", "[directions]") {
+    constexpr auto north = direction_as<point2i>(cardinal::north);
+    static_assert(north.x == 0 and north.y == 1);
+
+    auto const southwest = direction_as<point2i>(ordinal::southwest);
+    REQUIRE(southwest.x == -1);
+    REQUIRE(southwest.y == -1);
+
+    auto const northeast = direction_as<Eigen::Vector2f>(flat_hex::northeast);
+    REQUIRE(northeast.x() == 1.0f);
+    REQUIRE(northeast.y() == -1.0f);
+}
+
+TEST_CASE("direction_as:3D", "[directions]") {
+    constexpr std::array<std::array<float, 3>, 6> expected{{
+        {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
+    }};
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        auto const v = direction_as<point3f>(
+            static_cast<cubic6::direction_name>(i));
+        REQUIRE(v.x == expected[i][0]);
+        REQUIRE(v.y == expected[i][1]);
+        REQUIRE(v.z == expected[i][2]);
+    }
+
+    auto const up = direction_as<Eigen::Vector3d>(cubic26::up);
+    REQUIRE(up == Eigen::Vector3d(0, 0, 1));
+}
+
+TEST_CASE("direction_as:custom", "[directions]") {
+    int sum = 0;
+    for (std::size_t i = 0; i < enum_size_v<king_move>; ++i) {
+        auto const v = direction_as<point2i>(static_cast<king_move>(i));
+        REQUIRE((v.x != 0 or v.y != 0));
+        sum += v.x + v.y;
+    }
+    REQUIRE(sum == 0);
+
+    auto const w = direction_as<point4d>(static_cast<hypercube_face>(6));
+    REQUIRE(w.w == 1.0);
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+#include "spatula/affine.hpp"
+#include "../util/random_points.hpp"
+
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+namespace test_affine {
+struct vec2 { float x, y; };
+struct vec3 { float x, y, z; };
+struct dvec3 { double x, y, z; };
+struct ivec2 { int x, y; };
+
+template<class Vector>
+std::vector<Vector> random_points(std::size_t count, unsigned seed)
+{
+    return test_util::random_points<Vector>(count, seed, -100.f, 100.f);
+}
+
+template<class Scalar, std::size_t N>
+bool approx_equal(sp::affine<Scalar, N> const & a, sp::affine<Scalar, N> const & b)
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j <= N; ++j) {
+            if (std::abs(a.rows[i][j] - b.rows[i][j]) > 1e-5) { return false; }
+        }
+    }
+    return true;
+}
+}
+
+using namespace sp;
+using namespace test_affine;
+
+TEST_CASE("affine:construction", "[geometry][affine]") {
+    auto const moved = transform_point(affine2::translation(vec2{3, -2}), vec2{1, 1});
+    REQUIRE(moved.x == 4);
+    REQUIRE(moved.y == -1);
+
+    auto const scaled = transform_point(affine3::scaling(vec3{2, 3, 4}), vec3{1, 1, 1});
+    REQUIRE(scaled.y == 3);
+    REQUIRE(scaled.z == 4);
+
+    auto const turned = transform_point(daffine2::rotation(std::numbers::pi / 2),
+                                        ivec2{1, 0});
+    REQUIRE(turned.x == 0);
+    REQUIRE(turned.y == 1);
+
+    // a quarter turn about z takes x to y, and directions ignore translation
+    auto const spin = daffine3::translation(dvec3{5, 5, 5}) *
+                      daffine3::rotation(dvec3{0, 0, 2}, std::numbers::pi / 2);
+    auto const direction = transform_vector(spin, dvec3{1, 0, 0});
+    REQUIRE(direction.x == Approx(0).margin(1e-12));
+    REQUIRE(direction.y == Approx(1));
+    REQUIRE(direction.z == 0);
+    auto const point = transform_point(spin, dvec3{1, 0, 0});
+    REQUIRE(point.y == Approx(6));
+    REQUIRE(point.z == Approx(5));
+
+    REQUIRE(determinant(affine3::scaling(vec3{2, 3, -4})) == -24);
+    REQUIRE(affine2::identity() * affine2::identity() == affine2::identity());
+}
+
+TEST_CASE("affine:composition", "[geometry][affine]") {
+    auto const a = daffine3::rotation(dvec3{1, 2, 3}, 0.7) *
+                   daffine3::scaling(dvec3{2, 0.5, 3});
+    auto const b = daffine3::translation(dvec3{-4, 1, 9}) *
+                   daffine3::rotation(dvec3{0, 1, 0}, -1.3);
+    dvec3 const p{0.25, -7, 3};
+    auto const twice = transform_point(a, transform_point(b, p));
+    auto const once = transform_point(a * b, p);
+    REQUIRE(once.x == Approx(twice.x));
+    REQUIRE(once.y == Approx(twice.y));
+    REQUIRE(once.z == Approx(twice.z));
+
+    auto c = a;
+    c *= b;
+    REQUIRE(approx_equal(c, a * b));
+}
+
+TEST_CASE("affine:inverse", "[geometry][affine]") {
+    auto const m = daffine3::translation(dvec3{1, 2, 3}) *
+                   daffine3::rotation(dvec3{1, 1, 0}, 2.1) *
+                   daffine3::scaling(dvec3{1, -2, 0.5});
+    REQUIRE(approx_equal(m * inverse(m), daffine3::identity()));
+    REQUIRE(approx_equal(inverse(m) * m, daffine3::identity()));
+
+    auto const flat = affine2::translation(vec2{2, 3}) * affine2::rotation(0.4f) *
+                      affine2::scaling(vec2{4, 0.25f});
+    REQUIRE(approx_equal(inverse(flat) * flat, affine2::identity()));
+
+    REQUIRE_THROWS_AS(inverse(affine3::scaling(vec3{1, 0, 1})), std::domain_error);
+    REQUIRE_THROWS_AS(inverse(affine2{}), std::domain_error);
+}
+
+TEST_CASE("transform_points:ranges", "[geometry][affine]") {
+    auto const m3 = affine3::translation(vec3{1, -2, 3}) *
+                    affine3::rotation(vec3{3, 1, -1}, 0.3f) *
+                    affine3::scaling(vec3{1.5f, 2, -1});
+    auto const m2 = affine2::translation(vec2{-5, 7}) * affine2::rotation(1.1f);
+
+    // the blocked kernels agree with transforming one point at a time
+    auto const points3 = random_points<vec3>(1003, 3);
+    std::vector<vec3> fast(points3.size());
+    std::vector<vec3> slow;
+    REQUIRE(transform_points(m3, points3, fast.begin()) == fast.end());
+    transform_points(m3, points3, std::back_inserter(slow));
+    for (std::size_t i = 0; i < points3.size(); ++i) {
+        auto const expected = transform_point(m3, points3[i]);
+        REQUIRE(fast[i].x == Approx(expected.x).margin(1e-4));
+        REQUIRE(fast[i].y == Approx(expected.y).margin(1e-4));
+        REQUIRE(fast[i].z == Approx(expected.z).margin(1e-4));
+        REQUIRE(slow[i].z == expected.z);
+    }
+
+    auto const points2 = random_points<vec2>(517, 5);
+    std::vector<vec2> planar(points2.size());
+    transform_points(m2, points2, planar.begin());
+    for (std::size_t i = 0; i < points2.size(); ++i) {
+        auto const expected = transform_point(m2, points2[i]);
+        REQUIRE(planar[i].x == Approx(expected.x).margin(1e-4));
+        REQUIRE(planar[i].y == Approx(expected.y).margin(1e-4));
+    }
+
+    // transforming in place and then back recovers the points
+    auto moved = points3;
+    transform_points(m3, moved);
+    REQUIRE(moved[1000].x == fast[1000].x);
+    transform_points(inverse(m3), moved);
+    for (std::size_t i = 0; i < points3.size(); ++i) {
+        REQUIRE(moved[i].x == Approx(points3[i].x).margin(1e-3));
+        REQUIRE(moved[i].z == Approx(points3[i].z).margin(1e-3));
+    }
+
+    // other scalars take the one-at-a-time path
+    std::vector<dvec3> wide{{1, 2, 3}, {-4, 5, 6}};
+    std::vector<dvec3> wide_out(2);
+    transform_points(daffine3::scaling(2.0), wide, wide_out.begin());
+    REQUIRE(wide_out[1].x == -8);
+}
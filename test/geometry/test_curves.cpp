@@ -0,0 +1,159 @@
+#include <catch2/catch.hpp>
+#include "spatula/curves.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+namespace test_curves {
+struct vec2 { float x, y; };
+struct dvec2 { double x, y; };
+struct dvec3 { double x, y, z; };
+
+double distance(dvec2 a, dvec2 b) { return std::hypot(a.x - b.x, a.y - b.y); }
+
+double distance_to_segment(dvec2 p, dvec2 a, dvec2 b)
+{
+    double const dx = b.x - a.x, dy = b.y - a.y;
+    double const length = dx * dx + dy * dy;
+    double const t = length > 0?
+        std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / length, 0.0, 1.0) : 0.0;
+    return distance(p, {a.x + t * dx, a.y + t * dy});
+}
+
+// a quarter of the unit circle, to within 3e-4
+sp::cubic_bezier<dvec2> const quarter{{dvec2{1, 0}, dvec2{1, 0.5523}, dvec2{0.5523, 1},
+                                       dvec2{0, 1}}};
+}
+
+using namespace sp;
+using namespace test_curves;
+
+TEST_CASE("point_at", "[geometry][curves]") {
+    cubic_bezier<vec2> const bezier{{vec2{0, 0}, vec2{1, 2}, vec2{3, 2}, vec2{4, 0}}};
+    REQUIRE(point_at(bezier, 0).x == 0);
+    REQUIRE(point_at(bezier, 1).x == 4);
+    REQUIRE(point_at(bezier, 0.5).x == 2);
+    REQUIRE(point_at(bezier, 0.5).y == 1.5f);
+    REQUIRE(tangent_at(bezier, 0).x == 3);
+    REQUIRE(tangent_at(bezier, 0).y == 6);
+
+    // catmull-rom segments pass through their middle control points
+    catmull_rom<dvec3> const rom{{dvec3{0, 0, 0}, dvec3{1, 1, 0}, dvec3{2, 0, 1},
+                                  dvec3{3, 1, 1}}};
+    REQUIRE(point_at(rom, 0).y == 1);
+    REQUIRE(point_at(rom, 1).z == 1);
+    REQUIRE(tangent_at(rom, 0).x == 1);
+    REQUIRE(tangent_at(rom, 0).z == 0.5);
+
+    cubic_bspline<dvec2> const bspline{{dvec2{0, 0}, dvec2{6, 6}, dvec2{12, 0},
+                                        dvec2{18, 6}}};
+    REQUIRE(point_at(bspline, 0).x == Approx(6));
+    REQUIRE(point_at(bspline, 0).y == Approx(4));
+    REQUIRE(point_at(bspline, 1).x == Approx(12));
+    REQUIRE(point_at(bspline, 1).y == Approx(2));
+}
+
+TEST_CASE("points_at:sample", "[geometry][curves]") {
+    catmull_rom<vec2> const rom{{vec2{-1, 3}, vec2{0, 0}, vec2{5, 1}, vec2{7, -4}}};
+    std::vector<float> parameters;
+    for (int i = 0; i <= 1000; ++i) { parameters.push_back(i / 1000.f); }
+    std::vector<vec2> at(parameters.size());
+    REQUIRE(points_at(rom, parameters, at.begin()) == at.end());
+
+    // forward differences agree with evaluating each parameter
+    std::vector<vec2> sampled;
+    sample(rom, 1001, std::back_inserter(sampled));
+    REQUIRE(sampled.size() == 1001);
+    for (std::size_t i = 0; i < sampled.size(); ++i) {
+        auto const expected = point_at(rom, i / 1000.0);
+        REQUIRE(sampled[i].x == Approx(expected.x).margin(1e-5));
+        REQUIRE(sampled[i].y == Approx(expected.y).margin(1e-5));
+        REQUIRE(at[i].x == Approx(expected.x).margin(1e-5));
+    }
+    REQUIRE(sampled.back().x == 5);
+    REQUIRE(sampled.back().y == 1);
+
+    std::vector<vec2> one;
+    sample(rom, 1, std::back_inserter(one));
+    REQUIRE(one.size() == 1);
+    REQUIRE(one[0].x == 0);
+}
+
+TEST_CASE("arc_length_table", "[geometry][curves]") {
+    // evenly spaced control points on a line move at an even speed
+    cubic_bezier<dvec2> const line{{dvec2{0, 0}, dvec2{1, 1}, dvec2{2, 2}, dvec2{3, 3}}};
+    arc_length_table const straight(line);
+    REQUIRE(straight.length() == Approx(3 * std::sqrt(2.0)));
+    REQUIRE(straight.parameter_at(straight.length() / 2) == Approx(0.5));
+    REQUIRE(straight.parameter_at(-1) == 0);
+    REQUIRE(straight.parameter_at(100) == 1);
+
+    arc_length_table const lengths(quarter, 256);
+    REQUIRE(lengths.length() == Approx(std::numbers::pi / 2).epsilon(1e-3));
+
+    // points sampled by length are evenly spaced
+    std::vector<dvec2> points;
+    sample_by_length(quarter, lengths, 33, std::back_inserter(points));
+    REQUIRE(points.size() == 33);
+    double const step = distance(points[0], points[1]);
+    for (std::size_t i = 1; i < points.size(); ++i) {
+        REQUIRE(distance(points[i - 1], points[i]) == Approx(step).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("flatten", "[geometry][curves]") {
+    cubic_bezier<dvec2> const curve{{dvec2{0, 0}, dvec2{0, 10}, dvec2{10, -10},
+                                     dvec2{10, 0}}};
+    for (double tolerance : {1.0, 0.1, 0.01}) {
+        std::vector<dvec2> polyline(flattened_size(curve, tolerance));
+        REQUIRE(flatten(curve, tolerance, polyline.begin()) == polyline.end());
+        REQUIRE(polyline.front().x == 0);
+        REQUIRE(polyline.back().x == 10);
+
+        // every point of the curve is within tolerance of the polyline
+        for (int i = 0; i <= 2000; ++i) {
+            auto const p = point_at(curve, i / 2000.0);
+            double nearest = 1e9;
+            for (std::size_t k = 1; k < polyline.size(); ++k) {
+                nearest = std::min(nearest,
+                                   distance_to_segment(p, polyline[k - 1], polyline[k]));
+            }
+            REQUIRE(nearest <= tolerance);
+        }
+    }
+
+    // fewer points where the curve is straighter
+    cubic_bezier<dvec2> const straight{{dvec2{0, 0}, dvec2{1, 0}, dvec2{2, 0},
+                                        dvec2{3, 0}}};
+    REQUIRE(flattened_size(straight, 0.01) == 2);
+    REQUIRE(flattened_size(quarter, 0.01) < flattened_size(curve, 0.01));
+    REQUIRE_THROWS_AS(flattened_size(curve, 0.0), std::domain_error);
+}
+
+TEST_CASE("spline_segments", "[geometry][curves]") {
+    std::vector<vec2> const path{{0, 0}, {1, 2}, {3, 3}, {4, 1}, {6, 0}, {7, 2}, {9, 3}};
+
+    // sliding segments join where one ends and the next starts
+    auto const rom = spline_segments<catmull_rom<vec2>>(path);
+    REQUIRE(std::ranges::distance(rom) == 4);
+    for (std::size_t k = 0; k + 1 < 4; ++k) {
+        auto const end = point_at(rom[k], 1);
+        auto const start = point_at(rom[k + 1], 0);
+        REQUIRE(end.x == Approx(start.x));
+        REQUIRE(end.y == Approx(start.y));
+        REQUIRE(end.x == path[k + 2].x);
+    }
+    REQUIRE(std::ranges::distance(spline_segments<cubic_bspline<vec2>>(path)) == 4);
+
+    // bezier segments share their end points
+    auto const beziers = spline_segments<cubic_bezier<vec2>>(path);
+    REQUIRE(std::ranges::distance(beziers) == 2);
+    REQUIRE(beziers[1].points[0].x == 4);
+
+    std::vector<vec2> const few{{0, 0}, {1, 1}, {2, 2}};
+    REQUIRE(std::ranges::empty(spline_segments<catmull_rom<vec2>>(few)));
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+#include "spatula/oriented_boxes.hpp"
+
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace test_oriented_boxes {
+struct vec2 { float x, y; };
+struct dvec2 { double x, y; };
+struct dvec3 { double x, y, z; };
+
+// a rectangle of the given size rotated by angle, filled with random points
+std::vector<dvec2> rotated_rectangle(double width, double height, double angle,
+                                     std::size_t count, unsigned seed)
+{
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<double> u(-width / 2, width / 2);
+    std::uniform_real_distribution<double> v(-height / 2, height / 2);
+    double const c = std::cos(angle), s = std::sin(angle);
+    auto const place = [&](double x, double y) {
+        return dvec2{10 + c * x - s * y, -3 + s * x + c * y};
+    };
+    std::vector<dvec2> points;
+    for (std::size_t i = 0; i < count; ++i) { points.push_back(place(u(rng), v(rng))); }
+    for (double x : {-1., 1.}) {
+        for (double y : {-1., 1.}) {
+            points.push_back(place(x * width / 2, y * height / 2));
+        }
+    }
+    return points;
+}
+
+template<class Box, class Vector>
+bool contains(Box const & box, Vector const & p, double tolerance)
+{
+    double const d[2]{p.x - box.center.x, p.y - box.center.y};
+    double const e[2]{box.half_extents.x, box.half_extents.y};
+    for (std::size_t i = 0; i < 2; ++i) {
+        double const x = d[0] * box.axes[i].x + d[1] * box.axes[i].y;
+        if (std::abs(x) > e[i] + tolerance) { return false; }
+    }
+    return true;
+}
+}
+
+using namespace sp;
+using namespace test_oriented_boxes;
+
+TEST_CASE("convex_hull", "[geometry][oriented_boxes]") {
+    // a square with points inside, on its edges and repeated
+    std::vector<vec2> const points{{0, 0}, {2, 0}, {1, 0}, {2, 2}, {1, 1}, {0, 2},
+                                   {0.5f, 1.5f}, {2, 2}, {0, 1}, {1.5f, 0.25f}};
+    std::vector<vec2> hull;
+    convex_hull(points, std::back_inserter(hull));
+    REQUIRE(hull.size() == 4);
+    REQUIRE(hull[0].x == 0);
+    REQUIRE(hull[0].y == 0);
+    REQUIRE(hull[1].x == 2);
+    REQUIRE(hull[1].y == 0);
+    REQUIRE(hull[2].x == 2);
+    REQUIRE(hull[2].y == 2);
+    REQUIRE(hull[3].x == 0);
+    REQUIRE(hull[3].y == 2);
+
+    // every point is inside or on the hull of a random cloud
+    auto const cloud = rotated_rectangle(5, 3, 0.3, 5000, 1);
+    std::vector<dvec2> outline(cloud.size());
+    outline.erase(convex_hull(cloud, outline.begin()), outline.end());
+    REQUIRE(outline.size() == 4);
+    for (std::size_t i = 0; i < outline.size(); ++i) {
+        auto const & a = outline[i];
+        auto const & b = outline[(i + 1) % outline.size()];
+        for (auto const & p : cloud) { REQUIRE(orient2d(a, b, p) >= 0); }
+    }
+
+    std::vector<vec2> line;
+    convex_hull(std::vector<vec2>{{0, 0}, {1, 1}, {3, 3}, {2, 2}},
+                std::back_inserter(line));
+    REQUIRE(line.size() == 2);
+    REQUIRE(line[1].x == 3);
+}
+
+TEST_CASE("oriented_bounding_box:minimum_area", "[geometry][oriented_boxes]") {
+    double const angle = 0.4;
+    auto const points = rotated_rectangle(8, 2, angle, 2000, 3);
+    auto const box = oriented_bounding_box(points);
+    REQUIRE(box.center.x == Approx(10));
+    REQUIRE(box.center.y == Approx(-3));
+    REQUIRE(box.half_extents.x == Approx(4));
+    REQUIRE(box.half_extents.y == Approx(1));
+    REQUIRE(std::abs(box.axes[0].x) == Approx(std::cos(angle)));
+    REQUIRE(std::abs(box.axes[0].y) == Approx(std::sin(angle)));
+    // the frame is right-handed
+    REQUIRE(box.axes[0].x * box.axes[1].y - box.axes[0].y * box.axes[1].x == Approx(1));
+    for (auto const & p : points) { REQUIRE(contains(box, p, 1e-9)); }
+
+    // a triangle's least box is flush with one of its sides
+    std::vector<dvec2> const triangle{{0, 0}, {4, 0}, {1, 3}};
+    auto const tight = oriented_bounding_box<box_fit::minimum_area>(triangle);
+    REQUIRE(4 * tight.half_extents.x * tight.half_extents.y == Approx(12));
+
+    auto const dot = oriented_bounding_box(std::vector<vec2>{{1, 2}});
+    REQUIRE(dot.center.y == 2);
+    REQUIRE(dot.half_extents.x == 0);
+    REQUIRE_THROWS_AS(oriented_bounding_box(std::vector<vec2>{}), std::domain_error);
+}
+
+TEST_CASE("oriented_bounding_box:principal", "[geometry][oriented_boxes]") {
+    auto const points = rotated_rectangle(8, 2, 1.1, 5000, 5);
+    auto const box = oriented_bounding_box<box_fit::principal>(points);
+    REQUIRE(box.center.x == Approx(10).margin(0.1));
+    REQUIRE(box.center.y == Approx(-3).margin(0.1));
+    REQUIRE(box.half_extents.x == Approx(4).epsilon(0.02));
+    REQUIRE(box.half_extents.y == Approx(1).epsilon(0.1));
+    for (auto const & p : points) { REQUIRE(contains(box, p, 1e-9)); }
+
+    // a box in space is aligned with the principal axes, in a right-handed frame
+    std::mt19937 rng{9};
+    std::uniform_real_distribution<double> u(-1, 1);
+    std::vector<dvec3> cloud;
+    for (int i = 0; i < 10000; ++i) {
+        cloud.push_back({6 * u(rng), 0.5 * u(rng), 2 * u(rng)});
+    }
+    auto const solid = oriented_bounding_box(cloud);
+    REQUIRE(solid.half_extents.x == Approx(6).epsilon(0.01));
+    REQUIRE(solid.half_extents.y == Approx(2).epsilon(0.01));
+    REQUIRE(solid.half_extents.z == Approx(0.5).epsilon(0.03));
+    auto const & [a, b, c] = solid.axes;
+    REQUIRE(a.y * b.z - a.z * b.y == Approx(c.x).margin(1e-12));
+    REQUIRE(a.x * b.y - a.y * b.x == Approx(c.z).margin(1e-12));
+
+    // boxes of streamed points from a precomputed frame
+    moment_accumulator<2> accumulator;
+    for (auto const & p : points) { accumulator.add(p); }
+    auto const frame = principal_axes(accumulator.moments());
+    auto const streamed = oriented_bounding_box(points, frame);
+    REQUIRE(streamed.half_extents.x == box.half_extents.x);
+}
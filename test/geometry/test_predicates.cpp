@@ -0,0 +1,166 @@
+#include <catch2/catch.hpp>
+#include "spatula/predicates.hpp"
+
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace test_predicates {
+struct vec2 { double x, y; };
+struct vec3 { double x, y, z; };
+struct fvec2 { float x, y; };
+
+int sign(double value)
+{
+    return (value > 0.0) - (value < 0.0);
+}
+}
+
+using namespace sp;
+using namespace test_predicates;
+
+TEST_CASE("orient2d:signs", "[geometry][predicates]") {
+    REQUIRE(orient2d(vec2{0, 0}, vec2{1, 0}, vec2{0, 1}) > 0);
+    REQUIRE(orient2d(vec2{0, 0}, vec2{0, 1}, vec2{1, 0}) < 0);
+    REQUIRE(orient2d(vec2{0, 0}, vec2{1, 1}, vec2{3, 3}) == 0);
+    REQUIRE(orient2d(fvec2{0.f, 0.f}, fvec2{1.f, 0.f}, fvec2{0.5f, 1e-30f}) > 0);
+}
+
+TEST_CASE("orient2d:near-degenerate", "[geometry][predicates]") {
+    // the naive determinant gets many of these wrong, but q and r lie on the
+    // line y = x, so the sign only depends on which side of it p is
+    vec2 const q{12, 12};
+    vec2 const r{24, 24};
+    double const ulp = std::ldexp(1.0, -53);
+    std::vector<vec2> points;
+    for (int i = 0; i < 64; ++i) {
+        for (int j = 0; j < 64; ++j) {
+            points.push_back({0.5 + i * ulp, 0.5 + j * ulp});
+        }
+    }
+    std::vector<double> batch;
+    orient2d(q, r, points, std::back_inserter(batch));
+    REQUIRE(batch.size() == points.size());
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        auto const & p = points[k];
+        int const expected = sign(p.y - p.x);
+        REQUIRE(sign(orient2d(q, r, p)) == expected);
+        REQUIRE(sign(batch[k]) == expected);
+        // every permutation agrees
+        REQUIRE(sign(orient2d(r, p, q)) == expected);
+        REQUIRE(sign(orient2d(p, r, q)) == -expected);
+    }
+}
+
+TEST_CASE("orient3d:near-degenerate", "[geometry][predicates]") {
+    // a, b and c lie on the plane z = x
+    vec3 const a{12, 0, 12};
+    vec3 const b{24, 5, 24};
+    vec3 const c{0, 7, 0};
+    int const above = sign(orient3d(a, b, c, vec3{0, 0, 100}));
+    REQUIRE(above != 0);
+    REQUIRE(orient3d(a, b, c, vec3{3, 1, 3}) == 0);
+
+    double const ulp = std::ldexp(1.0, -53);
+    std::vector<vec3> points;
+    for (int i = 0; i < 32; ++i) {
+        for (int j = 0; j < 32; ++j) {
+            points.push_back({0.5 + i * ulp, 0.3, 0.5 + j * ulp});
+        }
+    }
+    std::vector<double> batch(points.size());
+    REQUIRE(orient3d(a, b, c, points, batch.begin()) == batch.end());
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        auto const & p = points[k];
+        int const expected = above * sign(p.z - p.x);
+        REQUIRE(sign(orient3d(a, b, c, p)) == expected);
+        REQUIRE(sign(batch[k]) == expected);
+    }
+}
+
+TEST_CASE("incircle:cocircular", "[geometry][predicates]") {
+    // a circle of radius 5 far from the origin, so that the differences of
+    // coordinates are exact but their lifts are not
+    double const o = 1 << 26;
+    vec2 const a{o + 5, o};
+    vec2 const b{o, o + 5};
+    vec2 const c{o - 5, o};
+    REQUIRE(orient2d(a, b, c) > 0);
+    REQUIRE(incircle(a, b, c, vec2{o, o}) > 0);
+    REQUIRE(incircle(a, b, c, vec2{o + 10, o}) < 0);
+    REQUIRE(incircle(a, b, c, vec2{o + 3, o + 4}) == 0);
+    REQUIRE(incircle(a, b, c, vec2{o - 4, o - 3}) == 0);
+
+    double const ulp = std::ldexp(o, -52);
+    std::vector<vec2> points{{o + 3, o + 4 + ulp}, {o + 3, o + 4 - ulp},
+                             {o - 4 - ulp, o - 3}, {o - 4 + ulp, o - 3},
+                             {o + 3, o + 4}};
+    std::vector<double> batch;
+    incircle(a, b, c, points, std::back_inserter(batch));
+    REQUIRE(sign(batch[0]) == -1);
+    REQUIRE(sign(batch[1]) == 1);
+    REQUIRE(sign(batch[2]) == -1);
+    REQUIRE(sign(batch[3]) == 1);
+    REQUIRE(batch[4] == 0);
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        REQUIRE(sign(incircle(a, b, c, points[k])) == sign(batch[k]));
+    }
+}
+
+TEST_CASE("insphere:cospherical", "[geometry][predicates]") {
+    double const o = 1 << 20;
+    vec3 a{o + 5, o, o};
+    vec3 b{o, o + 5, o};
+    vec3 c{o, o, o + 5};
+    vec3 const d{o - 5, o, o};
+    if (orient3d(a, b, c, d) < 0) { std::swap(a, b); }
+    REQUIRE(orient3d(a, b, c, d) > 0);
+    REQUIRE(insphere(a, b, c, d, vec3{o, o, o}) > 0);
+    REQUIRE(insphere(a, b, c, d, vec3{o, o, o + 20}) < 0);
+    REQUIRE(insphere(a, b, c, d, vec3{o + 3, o, o + 4}) == 0);
+    REQUIRE(insphere(a, b, c, d, vec3{o, o - 4, o - 3}) == 0);
+
+    double const ulp = std::ldexp(o, -52);
+    std::vector<vec3> points{{o + 3, o, o + 4 + ulp}, {o + 3, o, o + 4 - ulp},
+                             {o, o - 4, o - 3 - ulp}, {o, o - 4, o - 3 + ulp}};
+    std::vector<double> batch;
+    insphere(a, b, c, d, points, std::back_inserter(batch));
+    REQUIRE(sign(batch[0]) == -1);
+    REQUIRE(sign(batch[1]) == 1);
+    REQUIRE(sign(batch[2]) == -1);
+    REQUIRE(sign(batch[3]) == 1);
+    for (std::size_t k = 0; k < points.size(); ++k) {
+        REQUIRE(sign(insphere(a, b, c, d, points[k])) == sign(batch[k]));
+    }
+}
+
+TEST_CASE("predicates:batches", "[geometry][predicates]") {
+    // random inputs are decided by the filter, and the batches agree exactly
+    std::mt19937 rng{3};
+    std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+    std::vector<vec2> planar(517);
+    std::vector<vec3> spatial(517);
+    for (auto & p : planar) { p = {coordinate(rng), coordinate(rng)}; }
+    for (auto & p : spatial) { p = {coordinate(rng), coordinate(rng), coordinate(rng)}; }
+
+    std::vector<double> orientations(planar.size()), circles(planar.size());
+    orient2d(planar[0], planar[1], planar, orientations.begin());
+    incircle(planar[0], planar[1], planar[2], planar, circles.begin());
+    std::vector<double> orientations3(spatial.size()), spheres(spatial.size());
+    orient3d(spatial[0], spatial[1], spatial[2], spatial, orientations3.begin());
+    insphere(spatial[0], spatial[1], spatial[2], spatial[3], spatial, spheres.begin());
+    for (std::size_t k = 0; k < planar.size(); ++k) {
+        REQUIRE(orientations[k] == orient2d(planar[0], planar[1], planar[k]));
+        REQUIRE(circles[k] == incircle(planar[0], planar[1], planar[2], planar[k]));
+        REQUIRE(orientations3[k] ==
+                orient3d(spatial[0], spatial[1], spatial[2], spatial[k]));
+        REQUIRE(spheres[k] ==
+                insphere(spatial[0], spatial[1], spatial[2], spatial[3], spatial[k]));
+    }
+    // the defining points are degenerate with themselves
+    REQUIRE(orientations[0] == 0);
+    REQUIRE(circles[2] == 0);
+    REQUIRE(spheres[3] == 0);
+}
@@ -0,0 +1,166 @@
+#include <catch2/catch.hpp>
+#include "spatula/simplify.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace test_simplify {
+struct vec2 { float x, y; };
+struct dvec2 { double x, y; };
+struct dvec3 { double x, y, z; };
+
+bool operator==(dvec2 a, dvec2 b) { return a.x == b.x and a.y == b.y; }
+
+double distance_to_segment(dvec2 p, dvec2 a, dvec2 b)
+{
+    double const dx = b.x - a.x, dy = b.y - a.y;
+    double const length = dx * dx + dy * dy;
+    double const t = length > 0?
+        std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / length, 0.0, 1.0) : 0.0;
+    return std::hypot(a.x + t * dx - p.x, a.y + t * dy - p.y);
+}
+
+// a noisy trace moving steadily along x, so each point is known by its x
+std::vector<dvec2> trace(std::size_t count, unsigned seed)
+{
+    std::mt19937 rng{seed};
+    std::normal_distribution<double> wander(0, 0.2);
+    std::vector<dvec2> points;
+    double y = 0;
+    for (std::size_t k = 0; k < count; ++k) {
+        y += wander(rng);
+        points.push_back({static_cast<double>(k), y});
+    }
+    return points;
+}
+
+// the largest distance from a dropped point to the kept segment around it
+double largest_deviation(std::vector<dvec2> const & points,
+                         std::vector<dvec2> const & kept)
+{
+    double largest = 0;
+    for (std::size_t k = 1; k < kept.size(); ++k) {
+        auto const first = static_cast<std::size_t>(kept[k - 1].x);
+        auto const last = static_cast<std::size_t>(kept[k].x);
+        for (std::size_t i = first + 1; i < last; ++i) {
+            largest = std::max(largest, distance_to_segment(points[i], kept[k - 1],
+                                                            kept[k]));
+        }
+    }
+    return largest;
+}
+}
+
+using namespace sp;
+using namespace test_simplify;
+
+TEST_CASE("simplify:douglas_peucker", "[geometry][simplify]") {
+    std::vector<vec2> const corner{{0, 0}, {1, 0.05f}, {2, -0.05f}, {3, 0}, {3, 1},
+                                   {3.05f, 2}, {3, 3}};
+    std::vector<vec2> simplified;
+    simplify(corner, 0.1, std::back_inserter(simplified));
+    REQUIRE(simplified.size() == 3);
+    REQUIRE(simplified[1].x == 3);
+    REQUIRE(simplified[1].y == 0);
+    REQUIRE(simplified[2].y == 3);
+
+    simplified.clear();
+    simplify(corner, 0.01, std::back_inserter(simplified));
+    REQUIRE(simplified.size() == corner.size());
+
+    // every dropped point is within tolerance of the simplified polyline
+    auto const points = trace(200000, 3);
+    for (double tolerance : {0.5, 2.0, 10.0}) {
+        std::vector<dvec2> kept;
+        simplify(points, tolerance, std::back_inserter(kept));
+        REQUIRE(kept.front() == points.front());
+        REQUIRE(kept.back() == points.back());
+        REQUIRE(kept.size() < points.size() / 2);
+        REQUIRE(largest_deviation(points, kept) <= tolerance);
+    }
+
+    // collinear points are dropped even without tolerance
+    std::vector<dvec3> const line{{0, 0, 0}, {1, 1, 1}, {2, 2, 2}, {3, 3, 5}};
+    std::vector<dvec3> straight;
+    simplify(line, 0, std::back_inserter(straight));
+    REQUIRE(straight.size() == 3);
+    REQUIRE(straight[1].x == 2);
+}
+
+TEST_CASE("simplify:visvalingam_whyatt", "[geometry][simplify]") {
+    std::vector<dvec2> const spike{{0, 0}, {1, 0}, {2, 0.01}, {3, 0}, {4, 5}, {5, 0}};
+    std::vector<dvec2> simplified;
+    simplify<simplification::visvalingam_whyatt>(spike, 0.1,
+                                                 std::back_inserter(simplified));
+    REQUIRE(simplified == std::vector<dvec2>{{0, 0}, {3, 0}, {4, 5}, {5, 0}});
+
+    // larger areas keep a subset of the points smaller areas keep
+    auto const points = trace(50000, 5);
+    std::vector<dvec2> previous = points;
+    for (double area : {1.0, 10.0, 100.0}) {
+        std::vector<dvec2> kept;
+        simplify<simplification::visvalingam_whyatt>(points, area,
+                                                     std::back_inserter(kept));
+        REQUIRE(kept.front() == points.front());
+        REQUIRE(kept.back() == points.back());
+        REQUIRE(kept.size() < previous.size());
+        REQUIRE(std::ranges::includes(previous, kept, {}, &dvec2::x, &dvec2::x));
+        previous = kept;
+    }
+}
+
+TEST_CASE("polyline_simplifier", "[geometry][simplify]") {
+    auto const points = trace(100000, 7);
+    for (double tolerance : {0.5, 2.0, 10.0}) {
+        std::vector<dvec2> kept;
+        polyline_simplifier<dvec2> simplifier(tolerance);
+        auto out = std::back_inserter(kept);
+        for (auto const & p : points) { out = simplifier.add(p, out); }
+        simplifier.finish(out);
+        REQUIRE(kept.front() == points.front());
+        REQUIRE(kept.back() == points.back());
+        REQUIRE(kept.size() < points.size() / 2);
+        REQUIRE(largest_deviation(points, kept) <= tolerance);
+
+        // the same as a single pass of simplify, over a range without random access
+        std::vector<dvec2> streamed;
+        std::list<dvec2> const linked(points.begin(), points.end());
+        simplify<simplification::streaming>(linked, tolerance,
+                                            std::back_inserter(streamed));
+        REQUIRE(streamed == kept);
+    }
+
+    // a straight line still keeps a point whenever the capacity fills up
+    std::vector<dvec2> line;
+    for (int k = 0; k < 100; ++k) { line.push_back({static_cast<double>(k), 0}); }
+    std::vector<dvec2> kept;
+    polyline_simplifier<dvec2> small(1.0, 4);
+    auto out = std::back_inserter(kept);
+    for (auto const & p : line) { out = small.add(p, out); }
+    small.finish(out);
+    REQUIRE(kept.size() == 26);
+    REQUIRE(kept[1].x == 4);
+    REQUIRE(kept.back().x == 99);
+}
+
+TEST_CASE("simplify:short", "[geometry][simplify]") {
+    std::vector<vec2> simplified;
+    simplify(std::vector<vec2>{}, 1.0, std::back_inserter(simplified));
+    REQUIRE(simplified.empty());
+    simplify(std::vector<vec2>{{1, 2}}, 1.0, std::back_inserter(simplified));
+    simplify<simplification::visvalingam_whyatt>(std::vector<vec2>{{1, 2}, {3, 4}}, 1.0,
+                                                 std::back_inserter(simplified));
+    simplify<simplification::streaming>(std::vector<vec2>{{5, 6}}, 1.0,
+                                        std::back_inserter(simplified));
+    REQUIRE(simplified.size() == 4);
+    REQUIRE(simplified[3].x == 5);
+
+    REQUIRE_THROWS_AS(simplify(std::vector<vec2>{}, -1.0, std::back_inserter(simplified)),
+                      std::domain_error);
+    REQUIRE_THROWS_AS(polyline_simplifier<vec2>(-1.0), std::domain_error);
+}
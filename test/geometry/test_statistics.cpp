@@ -0,0 +1,178 @@
+#include <catch2/catch.hpp>
+#include "spatula/statistics.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace test_statistics {
+struct vec2 { float x, y; };
+struct vec3 { float x, y, z; };
+struct dvec3 { double x, y, z; };
+struct ivec2 { int x, y; };
+
+// points far from the origin, where naive float sums lose most of their digits
+std::vector<vec3> offset_points(std::size_t count, unsigned seed)
+{
+    std::mt19937 rng{seed};
+    std::normal_distribution<float> spread(0.f, 1.f);
+    std::vector<vec3> points(count);
+    for (auto & p : points) {
+        p = {1000.f + spread(rng), -2000.f + 2.f * spread(rng), 0.5f * spread(rng)};
+    }
+    return points;
+}
+
+template<std::size_t N, class Scalar>
+bool same_bits(sp::point_moments<N, Scalar> const & a,
+               sp::point_moments<N, Scalar> const & b)
+{
+    return a.count == b.count and
+           std::memcmp(a.mean.data(), b.mean.data(), sizeof(a.mean)) == 0 and
+           std::memcmp(a.scatter.data(), b.scatter.data(), sizeof(a.scatter)) == 0;
+}
+}
+
+using namespace sp;
+using namespace test_statistics;
+
+TEST_CASE("mean:exact", "[geometry][statistics]") {
+    std::vector<vec2> const points{{0, 0}, {4, 0}, {4, 2}, {0, 2}};
+    auto const c = centroid(points);
+    REQUIRE(c.x == 2.f);
+    REQUIRE(c.y == 1.f);
+
+    // integers are averaged in double and converted at the end
+    std::vector<ivec2> const cells{{1, 2}, {2, 2}};
+    REQUIRE(mean(cells).x == 1);
+    REQUIRE(mean<dvec3>(std::vector<vec3>{{1, 2, 3}, {2, 2, 2}}).x == 1.5);
+
+    // weighted centroids
+    std::vector<double> const weights{1, 1, 2, 0};
+    auto const heavy = centroid(points, weights);
+    REQUIRE(heavy.x == 3.f);
+    REQUIRE(heavy.y == 1.f);
+
+    REQUIRE_THROWS_AS(mean(std::vector<vec2>{}), std::domain_error);
+    REQUIRE_THROWS_AS(centroid(points, std::vector<double>(4, 0.)), std::domain_error);
+    REQUIRE_THROWS_AS(centroid(points, std::vector<double>(3, 1.)),
+                      std::invalid_argument);
+}
+
+TEST_CASE("mean:accuracy", "[geometry][statistics]") {
+    auto const points = offset_points(300001, 7);
+    long double x = 0, y = 0, z = 0;
+    for (auto const & p : points) { x += p.x; y += p.y; z += p.z; }
+    auto const n = static_cast<long double>(points.size());
+
+    auto const m = mean<dvec3>(points);
+    REQUIRE(std::abs(m.x - static_cast<double>(x / n)) < 1e-12);
+    REQUIRE(std::abs(m.y - static_cast<double>(y / n)) < 1e-12);
+    REQUIRE(std::abs(m.z - static_cast<double>(z / n)) < 1e-12);
+
+    // the result doesn't depend on the amount of threads or on random access
+    std::list<vec3> const linked(points.begin(), points.end());
+    for (std::size_t workers : {1, 2, 3, 8}) {
+        auto const other = mean<dvec3>(points, workers);
+        REQUIRE(std::memcmp(&other, &m, sizeof(m)) == 0);
+    }
+    auto const streamed = mean<dvec3>(linked);
+    REQUIRE(std::memcmp(&streamed, &m, sizeof(m)) == 0);
+}
+
+TEST_CASE("second_moments", "[geometry][statistics]") {
+    auto const small = second_moments(std::vector<vec2>{{1, 1}, {3, 1}, {1, 5}, {3, 5}});
+    REQUIRE(small.count == 4);
+    REQUIRE(small.mean[0] == 2);
+    REQUIRE(small.mean[1] == 3);
+    REQUIRE(small.scatter[0][0] == 4);
+    REQUIRE(small.scatter[1][1] == 16);
+    REQUIRE(small.scatter[0][1] == 0);
+    REQUIRE(second_moments(std::vector<vec3>{}).count == 0);
+
+    auto const points = offset_points(100003, 11);
+    long double mx = 0, my = 0;
+    for (auto const & p : points) { mx += p.x; my += p.y; }
+    mx /= points.size();
+    my /= points.size();
+    long double sxx = 0, sxy = 0, syy = 0;
+    for (auto const & p : points) {
+        sxx += (p.x - mx) * (p.x - mx);
+        sxy += (p.x - mx) * (p.y - my);
+        syy += (p.y - my) * (p.y - my);
+    }
+
+    auto const moments = second_moments(points);
+    REQUIRE(moments.count == points.size());
+    REQUIRE(moments.scatter[0][0] == Approx(static_cast<double>(sxx)).epsilon(1e-12));
+    REQUIRE(moments.scatter[0][1] == Approx(static_cast<double>(sxy)).epsilon(1e-9));
+    REQUIRE(moments.scatter[1][0] == moments.scatter[0][1]);
+    REQUIRE(moments.scatter[1][1] == Approx(static_cast<double>(syy)).epsilon(1e-12));
+    // the variances of the generating distributions
+    REQUIRE(moments.scatter[1][1] / moments.count == Approx(4).epsilon(0.02));
+    REQUIRE(moments.scatter[2][2] / moments.count == Approx(0.25).epsilon(0.02));
+
+    for (std::size_t workers : {1, 3, 5}) {
+        REQUIRE(same_bits(second_moments(points, workers), moments));
+    }
+    REQUIRE(same_bits(second_moments(std::list<vec3>(points.begin(), points.end())),
+                      moments));
+}
+
+TEST_CASE("moment_accumulator", "[geometry][statistics]") {
+    // streaming the points one at a time gives the same bits as the batch
+    for (std::size_t count : {0, 1, 4095, 4096, 4097, 3 * 4096 + 5, 7 * 4096 + 1}) {
+        auto const points = offset_points(count, 13);
+        moment_accumulator<3> accumulator;
+        for (auto const & p : points) { accumulator.add(p); }
+        REQUIRE(same_bits(accumulator.moments(), second_moments(points)));
+    }
+}
+
+TEST_CASE("covariance", "[geometry][statistics]") {
+    std::vector<vec2> const points{{1, 1}, {3, 1}, {1, 5}, {3, 5}};
+    auto const c = covariance(points);
+    REQUIRE(c[0][0] == Approx(4.0 / 3));
+    REQUIRE(c[1][1] == Approx(16.0 / 3));
+    REQUIRE(c[0][1] == 0);
+    REQUIRE_THROWS_AS(covariance(std::vector<vec2>{{1, 1}}), std::domain_error);
+}
+
+TEST_CASE("principal_axes", "[geometry][statistics]") {
+    // an elongated cloud along (3, 4) / 5 with a little spread across it
+    std::mt19937 rng{17};
+    std::normal_distribution<double> spread(0, 1);
+    std::vector<dvec3> points;
+    for (int i = 0; i < 20000; ++i) {
+        double const t = 10 * spread(rng), s = spread(rng), u = 0.1 * spread(rng);
+        points.push_back({5 + 0.6 * t - 0.8 * s, -1 + 0.8 * t + 0.6 * s, 2 + u});
+    }
+    auto const pca = principal_axes(points);
+    REQUIRE(pca.mean[0] == Approx(5).margin(0.3));
+    REQUIRE(pca.axes[0][0] == Approx(0.6).margin(0.01));
+    REQUIRE(pca.axes[0][1] == Approx(0.8).margin(0.01));
+    REQUIRE(std::abs(pca.axes[1][0]) == Approx(0.8).margin(0.01));
+    REQUIRE(std::abs(pca.axes[2][2]) == Approx(1).margin(0.01));
+    REQUIRE(pca.variances[0] == Approx(100).epsilon(0.05));
+    REQUIRE(pca.variances[1] == Approx(1).epsilon(0.05));
+    REQUIRE(pca.variances[2] == Approx(0.01).epsilon(0.05));
+
+    // the axes are orthonormal
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            double dot = 0;
+            for (std::size_t k = 0; k < 3; ++k) {
+                dot += pca.axes[i][k] * pca.axes[j][k];
+            }
+            REQUIRE(dot == Approx(i == j? 1 : 0).margin(1e-12));
+        }
+    }
+
+    auto const single = principal_axes(std::vector<vec2>{{3, 4}});
+    REQUIRE(single.mean[1] == 4);
+    REQUIRE(single.variances[0] == 0);
+    REQUIRE_THROWS_AS(principal_axes(std::vector<vec2>{}), std::domain_error);
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+#include "spatula/distances.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace test_distances {
+
+sp::grid<std::uint8_t> random_cells(std::size_t width, std::size_t height,
+                                    double density, unsigned seed)
+{
+    std::mt19937 rng{seed};
+    std::bernoulli_distribution occupied(density);
+    sp::grid<std::uint8_t> cells(width, height);
+    for (auto & cell : cells) { cell = occupied(rng); }
+    return cells;
+}
+
+// the distance to the nearest obstacle by checking every obstacle
+template<class Distance>
+sp::grid<double> brute_force(sp::grid<std::uint8_t> const & cells,
+                             Distance distance)
+{
+    sp::grid<double> result(cells.width(), cells.height());
+    for (std::size_t y = 0; y < cells.height(); ++y) {
+    for (std::size_t x = 0; x < cells.width(); ++x) {
+        double best = std::numeric_limits<double>::infinity();
+        for (std::size_t v = 0; v < cells.height(); ++v) {
+        for (std::size_t u = 0; u < cells.width(); ++u) {
+            if (cells(u, v) == 0) { continue; }
+            int const dx = static_cast<int>(u) - static_cast<int>(x);
+            int const dy = static_cast<int>(v) - static_cast<int>(y);
+            best = std::min(best, distance(dx, dy));
+        }}
+        result(x, y) = best;
+    }}
+    return result;
+}
+
+template<sp::grid_metric Metric, class Distance, class Expected>
+void require_matches_brute_force(Expected distance)
+{
+    for (unsigned seed = 0; seed < 6; ++seed) {
+        double const density = seed < 3? 0.05 : 0.4;
+        auto const cells = random_cells(31 + seed, 23, density, seed);
+        auto const expected = brute_force(cells, distance);
+        for (std::size_t workers : {1, 3, 8}) {
+            auto const actual = sp::distance_transform<Metric, Distance>(
+                cells, [](std::uint8_t cell) { return cell != 0; }, workers);
+            REQUIRE(actual.width() == cells.width());
+            REQUIRE(actual.height() == cells.height());
+            for (std::size_t i = 0; i < cells.size(); ++i) {
+                REQUIRE(static_cast<double>(actual.data()[i]) ==
+                        Approx(expected.data()[i]));
+            }
+        }
+    }
+}
+}
+
+using namespace sp;
+using namespace test_distances;
+
+TEST_CASE("distance_transform:empty", "[distances][grid]") {
+    auto const none = distance_transform<metric::euclidean>(grid<std::uint8_t>{});
+    REQUIRE(none.size() == 0);
+
+    auto const open = distance_transform<metric::manhattan>(grid<std::uint8_t>(4, 3));
+    for (auto const d : open) {
+        REQUIRE(d == std::numeric_limits<float>::infinity());
+    }
+    auto const open_int =
+        distance_transform<metric::chebyshev, int>(grid<std::uint8_t>(4, 3));
+    for (auto const d : open_int) {
+        REQUIRE(d == std::numeric_limits<int>::max());
+    }
+}
+
+TEST_CASE("distance_transform:single", "[distances][grid]") {
+    grid<std::uint8_t> cells(7, 5);
+    cells(2, 1) = 1;
+
+    auto const euclidean = distance_transform<metric::euclidean, double>(cells);
+    REQUIRE(euclidean(2, 1) == 0.0);
+    REQUIRE(euclidean(5, 4) == Approx(std::sqrt(18.0)));
+
+    auto const squared = distance_transform<metric::squared_euclidean, int>(cells);
+    REQUIRE(squared(6, 4) == 25);
+
+    auto const manhattan = distance_transform<metric::manhattan, int>(cells);
+    REQUIRE(manhattan(6, 4) == 7);
+
+    auto const chebyshev = distance_transform<metric::chebyshev, int>(cells);
+    REQUIRE(chebyshev(6, 4) == 4);
+
+    auto const hex = distance_transform<metric::hex, int>(cells);
+    REQUIRE(hex(6, 4) == 7);
+    REQUIRE(hex(0, 4) == 3);
+}
+
+TEST_CASE("distance_transform:euclidean", "[distances][grid]") {
+    require_matches_brute_force<metric::euclidean, float>([](int dx, int dy) {
+        return std::sqrt(static_cast<double>(dx*dx + dy*dy));
+    });
+    require_matches_brute_force<metric::squared_euclidean, std::uint32_t>(
+        [](int dx, int dy) { return static_cast<double>(dx*dx + dy*dy); });
+}
+
+TEST_CASE("distance_transform:manhattan", "[distances][grid]") {
+    require_matches_brute_force<metric::manhattan, std::int32_t>(
+        [](int dx, int dy) { return static_cast<double>(std::abs(dx) + std::abs(dy)); });
+}
+
+TEST_CASE("distance_transform:chebyshev", "[distances][grid]") {
+    require_matches_brute_force<metric::chebyshev, float>([](int dx, int dy) {
+        return static_cast<double>(std::max(std::abs(dx), std::abs(dy)));
+    });
+}
+
+TEST_CASE("distance_transform:hex", "[distances][hex][grid]") {
+    require_matches_brute_force<metric::hex, std::uint16_t>([](int dx, int dy) {
+        return static_cast<double>(
+            std::max({std::abs(dx), std::abs(dy), std::abs(dx + dy)}));
+    });
+}
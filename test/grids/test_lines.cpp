@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+#include "spatula/lines.hpp"
+
+#include <vector>
+#include <ranges>
+
+namespace test_lines {
+struct point { int x, y; };
+bool operator==(point const & a, point const & b)
+{
+    return a.x == b.x and a.y == b.y;
+}
+
+template<class Range>
+std::vector<point> collect(Range && cells)
+{
+    std::vector<point> points;
+    for (point const & p : cells) { points.push_back(p); }
+    return points;
+}
+}
+
+using namespace sp;
+using namespace test_lines;
+
+TEST_CASE("line:concepts", "[line][grid]") {
+    REQUIRE(std::ranges::forward_range<line_view<point>>);
+    REQUIRE(std::ranges::view<line_view<point>>);
+    REQUIRE(std::ranges::sized_range<line_view<point>>);
+    REQUIRE(std::ranges::forward_range<hex_line_view<point>>);
+    REQUIRE(std::ranges::view<hex_line_view<point>>);
+}
+
+TEST_CASE("line:single point", "[line][grid]") {
+    auto const cells = collect(line(point{3, -2}, point{3, -2}));
+    REQUIRE(cells == std::vector<point>{{3, -2}});
+}
+
+TEST_CASE("line:axis aligned", "[line][grid]") {
+    REQUIRE(collect(line(point{0, 0}, point{3, 0})) ==
+            std::vector<point>{{0, 0}, {1, 0}, {2, 0}, {3, 0}});
+    REQUIRE(collect(line(point{0, 0}, point{0, -2})) ==
+            std::vector<point>{{0, 0}, {0, -1}, {0, -2}});
+}
+
+TEST_CASE("line:diagonal", "[line][grid]") {
+    REQUIRE(collect(line(point{0, 0}, point{-2, 2})) ==
+            std::vector<point>{{0, 0}, {-1, 1}, {-2, 2}});
+}
+
+TEST_CASE("line:every octant", "[line][grid]") {
+    for (int x = -5; x <= 5; ++x) {
+    for (int y = -5; y <= 5; ++y) {
+        point const to{x, y};
+        auto const view = line(point{0, 0}, to);
+        auto const cells = collect(view);
+
+        REQUIRE(cells.size() == view.size());
+        REQUIRE(cells.front() == point{0, 0});
+        REQUIRE(cells.back() == to);
+        for (std::size_t i = 1; i < cells.size(); ++i) {
+            REQUIRE(chebyshev_distance(cells[i-1], cells[i]) == 1);
+        }
+    }}
+}
+
+TEST_CASE("hex_line:neighbors", "[line][hex][grid]") {
+    REQUIRE(collect(hex_line(point{0, 0}, point{3, 0})) ==
+            std::vector<point>{{0, 0}, {1, 0}, {2, 0}, {3, 0}});
+    REQUIRE(collect(hex_line(point{0, 0}, point{2, -2})) ==
+            std::vector<point>{{0, 0}, {1, -1}, {2, -2}});
+}
+
+TEST_CASE("hex_line:every direction", "[line][hex][grid]") {
+    for (int q = -5; q <= 5; ++q) {
+    for (int r = -5; r <= 5; ++r) {
+        point const to{q, r};
+        auto const view = hex_line(point{1, 1}, to);
+        auto const cells = collect(view);
+
+        REQUIRE(cells.size() == view.size());
+        REQUIRE(cells.front() == point{1, 1});
+        REQUIRE(cells.back() == to);
+        for (std::size_t i = 1; i < cells.size(); ++i) {
+            REQUIRE(hex_distance(cells[i-1], cells[i]) == 1);
+        }
+    }}
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+#include "spatula/regions.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <queue>
+
+namespace test_regions {
+struct point { int x, y; };
+
+// label components by flood fill, numbering them in row-major order
+template<sp::ranged_enum Connectivity>
+sp::grid<std::uint32_t> flood_labels(sp::grid<std::uint8_t> const & cells)
+{
+    auto const & offsets = sp::direction_offsets_v<Connectivity>;
+    sp::grid<std::uint32_t> labels(cells.width(), cells.height());
+    std::uint32_t next = 0;
+    for (std::size_t y = 0; y < cells.height(); ++y) {
+    for (std::size_t x = 0; x < cells.width(); ++x) {
+        if (cells(x, y) == 0 or labels(x, y) != 0) { continue; }
+        labels(x, y) = ++next;
+        std::queue<point> frontier;
+        frontier.push({static_cast<int>(x), static_cast<int>(y)});
+        while (not frontier.empty()) {
+            auto const p = frontier.front();
+            frontier.pop();
+            for (auto const & [dx, dy] : offsets) {
+                point const n{p.x + dx, p.y + dy};
+                if (cells.contains(n) and cells(n.x, n.y) != 0 and
+                    labels(n.x, n.y) == 0) {
+                    labels(n.x, n.y) = next;
+                    frontier.push(n);
+                }
+            }
+        }
+    }}
+    return labels;
+}
+
+sp::grid<std::uint8_t> random_cells(std::size_t width, std::size_t height,
+                                    double density, unsigned seed)
+{
+    std::mt19937 rng{seed};
+    std::bernoulli_distribution occupied(density);
+    sp::grid<std::uint8_t> cells(width, height);
+    for (auto & cell : cells) { cell = occupied(rng); }
+    return cells;
+}
+
+template<sp::ranged_enum Connectivity>
+void require_matches_flood_fill(std::size_t workers)
+{
+    for (unsigned seed = 0; seed < 4; ++seed) {
+        auto const cells = random_cells(37, 29, 0.55, seed);
+        auto const expected = flood_labels<Connectivity>(cells);
+        auto const actual = sp::label_components<Connectivity, point>(
+            cells, [](std::uint8_t cell) { return cell != 0; }, workers);
+
+        REQUIRE(std::ranges::equal(actual.labels, expected));
+
+        std::vector<std::size_t> sizes(actual.components.size());
+        for (auto const label : expected) {
+            if (label != 0) { ++sizes[label - 1]; }
+        }
+        for (std::size_t i = 0; i < sizes.size(); ++i) {
+            REQUIRE(actual.components[i].size == sizes[i]);
+        }
+    }
+}
+}
+
+using namespace sp;
+using namespace test_regions;
+
+TEST_CASE("label_components:empty", "[regions][grid]") {
+    auto const result = label_components<cardinal::direction_name, point>(
+        grid<std::uint8_t>{});
+    REQUIRE(result.labels.size() == 0);
+    REQUIRE(result.components.empty());
+}
+
+TEST_CASE("label_components:stats", "[regions][grid]") {
+    grid<std::uint8_t> cells(6, 4);
+    cells(1, 1) = cells(2, 1) = cells(2, 2) = 1;
+    cells(4, 0) = cells(5, 1) = 1;
+
+    auto const four = label_components<cardinal::direction_name, point>(cells);
+    REQUIRE(four.components.size() == 3);
+    REQUIRE(four.labels(4, 0) == 1);
+    REQUIRE(four.labels(1, 1) == 2);
+    REQUIRE(four.labels(5, 1) == 3);
+    REQUIRE(four.components[1].size == 3);
+    REQUIRE(four.components[1].corners.first.x == 1);
+    REQUIRE(four.components[1].corners.first.y == 1);
+    REQUIRE(four.components[1].corners.second.x == 2);
+    REQUIRE(four.components[1].corners.second.y == 2);
+
+    auto const eight = label_components<ordinal::direction_name, point>(cells);
+    REQUIRE(eight.components.size() == 2);
+    REQUIRE(eight.components[0].size == 2);
+}
+
+TEST_CASE("label_components:bool", "[regions][grid]") {
+    // a grid of bool holds real cells, not packed bits
+    grid<bool> cells(5, 3);
+    cells(0, 0) = cells(1, 0) = true;
+    cells(3, 2) = true;
+    bool & cell = cells(4, 2);
+    cell = true;
+    REQUIRE(cells.data()[14]);
+
+    auto const copy = cells;
+    REQUIRE(copy(1, 0));
+    REQUIRE(std::ranges::count(copy, true) == 4);
+
+    auto const four = label_components<cardinal::direction_name, point>(cells);
+    REQUIRE(four.components.size() == 2);
+    REQUIRE(four.labels(1, 0) == 1);
+    REQUIRE(four.labels(4, 2) == 2);
+    REQUIRE(four.components[1].size == 2);
+}
+
+TEST_CASE("label_components:4-connected", "[regions][grid]") {
+    for (std::size_t workers : {1, 2, 3, 8, 64}) {
+        require_matches_flood_fill<cardinal::direction_name>(workers);
+    }
+}
+
+TEST_CASE("label_components:8-connected", "[regions][grid]") {
+    for (std::size_t workers : {1, 2, 5, 29}) {
+        require_matches_flood_fill<ordinal::direction_name>(workers);
+    }
+}
+
+TEST_CASE("label_components:hex", "[regions][hex][grid]") {
+    for (std::size_t workers : {1, 4, 7}) {
+        require_matches_flood_fill<flat_hex::direction_name>(workers);
+        require_matches_flood_fill<pointed_hex::direction_name>(workers);
+    }
+}
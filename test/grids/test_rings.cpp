@@ -0,0 +1,128 @@
+#include <catch2/catch.hpp>
+#include "spatula/rings.hpp"
+
+#include <vector>
+#include <array>
+#include <ranges>
+#include <algorithm>
+
+namespace test_rings {
+struct point {
+    int x, y;
+    constexpr auto operator<=>(point const &) const = default;
+};
+
+template<class Range>
+std::vector<point> collect(Range && cells)
+{
+    std::vector<point> points;
+    for (point const & p : cells) { points.push_back(p); }
+    return points;
+}
+
+// a precomputed stencil of the offsets within two hexes of the origin
+constexpr auto hex_stencil()
+{
+    using flat = sp::flat_hex::direction_name;
+    std::array<point, 19> offsets{};
+    std::ranges::copy(sp::views::hex_spiral<flat>(point{0, 0}, 2),
+                      offsets.begin());
+    return offsets;
+}
+}
+
+using namespace sp;
+using namespace test_rings;
+
+using flat = flat_hex::direction_name;
+using pointed = pointed_hex::direction_name;
+
+TEST_CASE("hex_ring:concepts", "[rings][hex]") {
+    REQUIRE(std::ranges::forward_range<views::ring_view<point, 6>>);
+    REQUIRE(std::ranges::view<views::ring_view<point, 6>>);
+    REQUIRE(std::ranges::forward_range<views::hex_range_view<point>>);
+    REQUIRE(std::ranges::view<views::hex_range_view<point>>);
+}
+
+TEST_CASE("hex_ring:radius zero", "[rings][hex]") {
+    REQUIRE(collect(views::hex_ring<flat>(point{2, 3}, 0)) ==
+            std::vector<point>{{2, 3}});
+}
+
+TEST_CASE("hex_ring:negative radius", "[rings][hex]") {
+    // negative radii are empty, as they are for hex_range
+    REQUIRE(views::hex_ring<flat>(point{2, 3}, -1).size() == 0);
+    REQUIRE(collect(views::hex_ring<flat>(point{2, 3}, -1)).empty());
+    REQUIRE(collect(views::hex_spiral<pointed>(point{0, 0}, -3)).empty());
+    REQUIRE(collect(views::manhattan_ring(point{0, 0}, -2)).empty());
+    REQUIRE(collect(views::chebyshev_ring(point{0, 0}, -2)).empty());
+    REQUIRE(views::hex_range(point{0, 0}, -1).size() == 0);
+}
+
+TEST_CASE("hex_ring:distance", "[rings][hex]") {
+    for (int k = 1; k <= 5; ++k) {
+        auto const ring = views::hex_ring<pointed>(point{1, -1}, k);
+        auto cells = collect(ring);
+        REQUIRE(cells.size() == 6 * static_cast<std::size_t>(k));
+        REQUIRE(cells.size() == ring.size());
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            REQUIRE(hex_distance(cells[i], point{1, -1}) == k);
+            REQUIRE(hex_distance(cells[i], cells[(i + 1) % cells.size()]) == 1);
+        }
+        std::ranges::sort(cells);
+        REQUIRE(std::ranges::adjacent_find(cells) == cells.end());
+    }
+}
+
+TEST_CASE("hex_ring:direction order", "[rings][hex]") {
+    auto const & directions = direction_offsets_v<flat>;
+    auto const cells = collect(views::hex_ring<flat>(point{0, 0}, 1));
+    REQUIRE(cells.front() == point{directions[4][0], directions[4][1]});
+    REQUIRE(cells[1] == point{directions[5][0], directions[5][1]});
+}
+
+TEST_CASE("hex_spiral:matches hex_range", "[rings][hex]") {
+    auto spiral = collect(views::hex_spiral<flat>(point{0, 4}, 4));
+    auto range = collect(views::hex_range(point{0, 4}, 4));
+    REQUIRE(spiral.size() == 61);
+    REQUIRE(range.size() == views::hex_range(point{0, 4}, 4).size());
+    REQUIRE(spiral.front() == point{0, 4});
+
+    std::ranges::sort(spiral);
+    REQUIRE(spiral == range);
+}
+
+TEST_CASE("hex_spiral:constant expression", "[rings][hex]") {
+    constexpr auto stencil = hex_stencil();
+    static_assert(stencil[0] == point{0, 0});
+    static_assert(std::ranges::distance(
+        views::hex_ring<pointed>(point{0, 0}, 3)) == 18);
+    for (point const & p : stencil) {
+        REQUIRE(hex_distance(p, point{0, 0}) <= 2);
+    }
+}
+
+TEST_CASE("manhattan_ring:distance", "[rings][square]") {
+    for (int k = 0; k <= 5; ++k) {
+        auto cells = collect(views::manhattan_ring(point{3, 3}, k));
+        REQUIRE(cells.size() == (k == 0? 1 : 4 * static_cast<std::size_t>(k)));
+        for (point const & p : cells) {
+            REQUIRE(manhattan_distance(p, point{3, 3}) == k);
+        }
+        std::ranges::sort(cells);
+        REQUIRE(std::ranges::adjacent_find(cells) == cells.end());
+    }
+}
+
+TEST_CASE("chebyshev_ring:distance", "[rings][square]") {
+    for (int k = 0; k <= 5; ++k) {
+        auto cells = collect(views::chebyshev_ring(point{-2, 0}, k));
+        REQUIRE(cells.size() == (k == 0? 1 : 8 * static_cast<std::size_t>(k)));
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            REQUIRE(chebyshev_distance(cells[i], point{-2, 0}) == k);
+            REQUIRE(chebyshev_distance(cells[i], cells[(i + 1) % cells.size()]) <= 1);
+        }
+        std::ranges::sort(cells);
+        REQUIRE(std::ranges::adjacent_find(cells) == cells.end());
+    }
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch.hpp>
+#include "spatula/visibility.hpp"
+#include "spatula/lines.hpp"
+
+#include <vector>
+
+namespace test_visibility {
+struct point { int x, y; };
+
+// an open room with a single pillar to the east of the center
+struct room {
+    bool operator()(point const & p) const
+    {
+        return p.x == 7 and p.y == 5;
+    }
+};
+}
+
+using namespace sp;
+using namespace test_visibility;
+
+TEST_CASE("field_of_view:open room", "[field_of_view][grid]") {
+    bit_grid visible(11, 11);
+    field_of_view(point{5, 5}, 20, [](point const &) { return false; },
+                  visible);
+    REQUIRE(visible.count() == visible.size());
+}
+
+TEST_CASE("field_of_view:radius", "[field_of_view][grid]") {
+    bit_grid visible(11, 11);
+    field_of_view(point{5, 5}, 2, [](point const &) { return false; },
+                  visible);
+    for (int x = 0; x < 11; ++x) {
+    for (int y = 0; y < 11; ++y) {
+        int const dx = x - 5, dy = y - 5;
+        REQUIRE(visible.test(x, y) == (dx*dx + dy*dy <= 4));
+    }}
+}
+
+TEST_CASE("field_of_view:shadow", "[field_of_view][grid]") {
+    bit_grid visible(11, 11);
+    field_of_view(point{5, 5}, 10, room{}, visible);
+
+    REQUIRE(visible.test(5, 5));
+    REQUIRE(visible.test(6, 5));
+    REQUIRE(visible.test(7, 5));
+    REQUIRE(not visible.test(8, 5));
+    REQUIRE(not visible.test(10, 5));
+    REQUIRE(visible.test(5, 10));
+    REQUIRE(visible.test(0, 5));
+}
+
+TEST_CASE("field_of_view:clear lines are visible", "[field_of_view][grid]") {
+    bit_grid visible(11, 11);
+    field_of_view(point{5, 5}, 10, room{}, visible);
+
+    // any cell that a bresenham line reaches without passing through the
+    // pillar should be visible
+    for (int x = 0; x < 11; ++x) {
+    for (int y = 0; y < 11; ++y) {
+        bool clear = true;
+        for (point const & p : line(point{5, 5}, point{x, y})) {
+            if (p.x == x and p.y == y) { break; }
+            clear = clear and not room{}(p);
+        }
+        if (clear) { REQUIRE(visible.test(x, y)); }
+    }}
+}
+
+TEST_CASE("field_of_view:batch", "[field_of_view][grid]") {
+    std::vector<point> const viewers{{1, 1}, {5, 5}, {9, 5}, {3, 8}, {0, 0}};
+    std::vector<bit_grid> visible(viewers.size(), bit_grid(11, 11));
+    field_of_view(viewers, 6, room{}, visible);
+
+    for (std::size_t i = 0; i < viewers.size(); ++i) {
+        bit_grid expected(11, 11);
+        field_of_view(viewers[i], 6, room{}, expected);
+        for (int x = 0; x < 11; ++x) {
+        for (int y = 0; y < 11; ++y) {
+            REQUIRE(visible[i].test(x, y) == expected.test(x, y));
+        }}
+    }
+}
+
+TEST_CASE("hex_field_of_view:open map", "[field_of_view][hex][grid]") {
+    bit_grid visible(11, 11);
+    hex_field_of_view(point{5, 5}, 3, [](point const &) { return false; },
+                      visible);
+    for (int q = 0; q < 11; ++q) {
+    for (int r = 0; r < 11; ++r) {
+        REQUIRE(visible.test(q, r) == (hex_distance(point{q, r}, point{5, 5}) <= 3));
+    }}
+}
+
+TEST_CASE("hex_field_of_view:shadow", "[field_of_view][hex][grid]") {
+    bit_grid visible(11, 11);
+    auto const wall = [](point const & p) { return p.x == 6 and p.y == 5; };
+    hex_field_of_view(point{5, 5}, 5, wall, visible);
+
+    REQUIRE(visible.test(6, 5));
+    REQUIRE(not visible.test(7, 5));
+    REQUIRE(not visible.test(9, 5));
+    REQUIRE(visible.test(4, 5));
+    REQUIRE(visible.test(5, 7));
+}
+
+TEST_CASE("hex_field_of_view:batch", "[field_of_view][hex][grid]") {
+    auto const wall = [](point const & p) { return p.x == 6 and p.y == 5; };
+    std::vector<point> const viewers{{5, 5}, {2, 8}, {9, 1}};
+    std::vector<bit_grid> visible(viewers.size(), bit_grid(11, 11));
+    hex_field_of_view(viewers, 4, wall, visible);
+
+    for (std::size_t i = 0; i < viewers.size(); ++i) {
+        bit_grid expected(11, 11);
+        hex_field_of_view(viewers[i], 4, wall, expected);
+        REQUIRE(visible[i].count() == expected.count());
+    }
+}
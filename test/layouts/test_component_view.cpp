@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+#include "spatula/layouts.hpp"
+#include <spatula_extensions/eigen.hpp>
+
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace test_layouts {
+struct point2 { int x, y; };
+struct point3 { float x, y, z; };
+struct yx_point { double y, x; };
+struct padded { float x, y; std::uint64_t tag; };
+}
+
+using namespace sp;
+using namespace test_layouts;
+
+TEST_CASE("component_layout:aggregates", "[layouts][component_view]") {
+    STATIC_REQUIRE(has_component_layout<point2>);
+    STATIC_REQUIRE(component_offsets_v<point3>[2] == 2 * sizeof(float));
+    STATIC_REQUIRE(component_offsets_v<yx_point>[0] == sizeof(double));
+    STATIC_REQUIRE(component_offsets_v<yx_point>[1] == 0);
+    STATIC_REQUIRE(component_stride_v<point3> == 3);
+    STATIC_REQUIRE(not has_component_layout<padded>);
+}
+
+TEST_CASE("component_layout:Eigen", "[layouts][component_view][Eigen]") {
+    STATIC_REQUIRE(has_component_layout<Eigen::Vector3f>);
+    STATIC_REQUIRE(component_offsets_v<Eigen::Vector4d>[3] == 3 * sizeof(double));
+    STATIC_REQUIRE(component_stride_v<Eigen::Vector2i> == 2);
+}
+
+TEST_CASE("component_view:aggregates", "[layouts][component_view]") {
+    std::vector<point3> points{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    auto ys = component_view<1>(points);
+    STATIC_REQUIRE(decltype(ys)::stride() == 3);
+    STATIC_REQUIRE(ranges::random_access_range<decltype(ys)>);
+    REQUIRE(ys.size() == 3);
+    REQUIRE(std::ranges::equal(ys, std::vector<float>{2, 5, 8}));
+
+    for (float & z : component_view<2>(points)) { z = 0; }
+    REQUIRE(points[1].z == 0);
+    REQUIRE(points[1].y == 5);
+
+    std::vector<yx_point> const swapped{{1, 2}, {3, 4}};
+    auto xs = component_view<0>(swapped);
+    STATIC_REQUIRE(std::is_const_v<decltype(xs)::element_type>);
+    REQUIRE(xs[0] == 2);
+    REQUIRE(xs[1] == 4);
+    REQUIRE(std::ranges::max(xs) == 4);
+}
+
+TEST_CASE("component_view:Eigen", "[layouts][component_view][Eigen]") {
+    std::vector<Eigen::Vector2d> points{{1, 2}, {3, 4}, {5, 6}, {7, 8}};
+    auto const ys = component_view<1>(points);
+    REQUIRE(std::accumulate(ys.begin(), ys.end(), 0.0) == 20.0);
+
+    auto const it = std::ranges::find(ys, 6.0);
+    REQUIRE(it - ys.begin() == 2);
+    REQUIRE(ys.end() - it == 2);
+    REQUIRE(it[1] == 8.0);
+}
+
+TEST_CASE("component_view:empty", "[layouts][component_view]") {
+    std::vector<point2> points;
+    auto const xs = component_view<0>(points);
+    REQUIRE(xs.empty());
+    REQUIRE(xs.begin() == xs.end());
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch.hpp>
+#include "spatula/layouts.hpp"
+#include <spatula_extensions/eigen.hpp>
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <vector>
+
+namespace test_convert_range {
+struct point2 { int x, y; };
+struct other_point2 { int x, y; };
+struct yx_point { int y, x; };
+struct point3 { float x, y, z; };
+struct dpoint3 { double x, y, z; };
+}
+
+using namespace sp;
+using namespace test_convert_range;
+
+TEST_CASE("layout_compatible", "[layouts][convert_range]") {
+    STATIC_REQUIRE(layout_compatible<point2, other_point2>);
+    STATIC_REQUIRE(layout_compatible<point3, Eigen::Vector3f>);
+    STATIC_REQUIRE(not layout_compatible<point2, yx_point>);
+    STATIC_REQUIRE(not layout_compatible<point3, dpoint3>);
+    STATIC_REQUIRE(not layout_compatible<point3, Eigen::Vector3i>);
+}
+
+TEST_CASE("convert_range:compatible", "[layouts][convert_range]") {
+    std::vector<point2> const points{{1, 2}, {3, 4}, {5, 6}};
+    auto const others = convert_range<other_point2>(points);
+    REQUIRE(others.size() == 3);
+    REQUIRE(others[2].x == 5);
+    REQUIRE(others[2].y == 6);
+
+    std::vector<point3> const floats{{1, 2, 3}, {4, 5, 6}};
+    auto const eigen = convert_range<Eigen::Vector3f>(floats);
+    REQUIRE(eigen[1] == Eigen::Vector3f(4, 5, 6));
+    auto const back = convert_range<point3>(eigen);
+    REQUIRE(back[0].z == 3);
+
+    std::vector<point2> none;
+    REQUIRE(convert_range<other_point2>(none).empty());
+}
+
+TEST_CASE("convert_range:shuffle", "[layouts][convert_range]") {
+    std::vector<point2> const points{{1, 2}, {3, 4}};
+    std::vector<yx_point> swapped(2);
+    auto const end = convert_range<yx_point>(points, swapped.begin());
+    REQUIRE(end == swapped.end());
+    REQUIRE(swapped[1].x == 3);
+    REQUIRE(swapped[1].y == 4);
+}
+
+TEST_CASE("convert_range:widening", "[layouts][convert_range]") {
+    std::list<point3> const floats{{0.5f, 1, 2}, {3, 4, 5.25f}};
+    auto const doubles = convert_range<dpoint3>(floats);
+    REQUIRE(doubles[0].x == 0.5);
+    REQUIRE(doubles[1].z == 5.25);
+
+    auto const ints = convert_range<Eigen::Vector3i>(doubles);
+    REQUIRE(ints[1] == Eigen::Vector3i(3, 4, 5));
+}
+
+TEST_CASE("convert_range:contiguous_other_value", "[layouts][convert_range]") {
+    // contiguous output of another value type is written element by element
+    std::vector<point2> const points{{1, 2}, {3, 4}};
+    std::vector<std::optional<other_point2>> wrapped(2);
+    auto const end = convert_range<other_point2>(points, wrapped.begin());
+    REQUIRE(end == wrapped.end());
+    REQUIRE(wrapped[0].has_value());
+    REQUIRE(wrapped[1]->x == 3);
+    REQUIRE(wrapped[1]->y == 4);
+}
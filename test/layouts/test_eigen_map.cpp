@@ -0,0 +1,51 @@
+#include <catch2/catch.hpp>
+#include "spatula/layouts.hpp"
+#include <spatula_extensions/eigen.hpp>
+
+#include <vector>
+
+namespace test_eigen_map {
+struct point2 { int x, y; };
+struct point3 { float x, y, z; };
+struct yx_point { float y, x; };
+}
+
+using namespace sp;
+using namespace test_eigen_map;
+
+TEST_CASE("eigen_map:layouts", "[layouts][eigen_map][Eigen]") {
+    STATIC_REQUIRE(packed_layout<point2>);
+    STATIC_REQUIRE(packed_layout<Eigen::Vector3d>);
+    STATIC_REQUIRE(ordered_layout<point3>);
+    STATIC_REQUIRE(not ordered_layout<yx_point>);
+    STATIC_REQUIRE(std::same_as<eigen_map_t<point3>,
+                                Eigen::Map<Eigen::Matrix<float, 3, Eigen::Dynamic>>>);
+}
+
+TEST_CASE("eigen_map:transform", "[layouts][eigen_map][Eigen]") {
+    std::vector<point3> points{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}};
+    auto columns = eigen_map(points);
+    REQUIRE(columns.rows() == 3);
+    REQUIRE(columns.cols() == 4);
+    REQUIRE(columns(2, 1) == 6);
+
+    Eigen::Matrix3f scale = Eigen::Vector3f(2, 1, 0).asDiagonal();
+    columns = scale * columns;
+    columns.colwise() += Eigen::Vector3f(0, 1, 1);
+    REQUIRE(points[0].x == 2);
+    REQUIRE(points[3].x == 20);
+    REQUIRE(points[2].y == 9);
+    REQUIRE(points[1].z == 1);
+}
+
+TEST_CASE("eigen_map:reduce", "[layouts][eigen_map][Eigen]") {
+    std::vector<point2> const points{{1, -4}, {3, 2}, {-2, 8}};
+    auto const columns = eigen_map(points);
+    STATIC_REQUIRE(std::same_as<decltype(columns)::PlainObject,
+                                Eigen::Matrix<int, 2, Eigen::Dynamic>>);
+    REQUIRE(columns.rowwise().sum() == Eigen::Vector2i(2, 6));
+    REQUIRE(columns.rowwise().maxCoeff() == Eigen::Vector2i(3, 8));
+
+    std::vector<point2> empty;
+    REQUIRE(eigen_map(empty).cols() == 0);
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+#include "spatula/point_codec.hpp"
+#include "../util/random_points.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace test_point_codec {
+struct vec2 { double x, y; };
+struct vec3 { float x, y, z; };
+struct ivec3 { std::int32_t x, y, z; };
+
+bool operator<(ivec3 const & a, ivec3 const & b)
+{
+    return std::array{a.x, a.y, a.z} < std::array{b.x, b.y, b.z};
+}
+
+bool operator==(ivec3 const & a, ivec3 const & b)
+{
+    return a.x == b.x and a.y == b.y and a.z == b.z;
+}
+
+std::vector<vec3> random_points(std::size_t count, unsigned seed)
+{
+    return test_util::random_points<vec3>(count, seed, -50.f, 50.f);
+}
+}
+
+using namespace sp;
+using namespace test_point_codec;
+
+TEST_CASE("encode_points:integers", "[points][codec]") {
+    // integer points on a unit grid come back exactly, in some order
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<std::int32_t> coordinate(-100000, 100000);
+    std::vector<ivec3> points(1001);
+    for (auto & p : points) { p = {coordinate(rng), coordinate(rng), coordinate(rng)}; }
+
+    auto const bytes = encode_points(points, {.step = 1.0, .block_size = 256});
+    auto decoded = decode_points<ivec3>(bytes);
+    REQUIRE(decoded.size() == points.size());
+    std::sort(points.begin(), points.end());
+    std::sort(decoded.begin(), decoded.end());
+    REQUIRE(decoded == points);
+}
+
+TEST_CASE("encode_points:quantized", "[points][codec]") {
+    auto const points = random_points(5000, 3);
+    double const step = 1.0 / 4096.0;
+    auto const bytes = encode_points(points, {.step = step, .morton_order = false});
+    auto const decoded = decode_points<vec3>(bytes);
+    REQUIRE(decoded.size() == points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        REQUIRE(std::abs(decoded[i].x - points[i].x) <= step);
+        REQUIRE(std::abs(decoded[i].y - points[i].y) <= step);
+        REQUIRE(std::abs(decoded[i].z - points[i].z) <= step);
+    }
+    // nearby points in morton order take fewer bytes than in random order
+    auto const sorted = encode_points(points, {.step = step});
+    REQUIRE(sorted.size() < bytes.size());
+    REQUIRE(bytes.size() < points.size() * sizeof(vec3));
+}
+
+TEST_CASE("point_decoder:streaming", "[points][codec]") {
+    std::vector<vec2> points;
+    for (int i = 0; i < 1003; ++i) { points.push_back({i * 0.5, -i * 0.25}); }
+    auto const bytes = encode_points(points, {.step = 0.25, .morton_order = false,
+                                              .block_size = 64});
+
+    // buffers of every awkward size see the same points as one big buffer
+    for (std::size_t const buffer_size : {1u, 3u, 4u, 7u, 100u}) {
+        point_decoder<vec2> decoder{bytes};
+        REQUIRE(decoder.size() == points.size());
+        std::vector<vec2> buffer(buffer_size);
+        std::vector<vec2> decoded;
+        while (std::size_t const n = decoder.decode(buffer)) {
+            decoded.insert(decoded.end(), buffer.begin(), buffer.begin() + n);
+        }
+        REQUIRE(decoder.remaining() == 0);
+        REQUIRE(decoded.size() == points.size());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            REQUIRE(decoded[i].x == points[i].x);
+            REQUIRE(decoded[i].y == points[i].y);
+        }
+    }
+}
+
+TEST_CASE("point_decoder:invalid", "[points][codec]") {
+    REQUIRE(decode_points<vec3>(encode_points(std::vector<vec3>{})).empty());
+    REQUIRE_THROWS_AS(encode_points(random_points(4, 1), {.step = 0.0}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(encode_points(random_points(4, 1), {.step = 1e-9}),
+                      std::invalid_argument);
+
+    auto const bytes = encode_points(random_points(100, 1));
+    REQUIRE_THROWS_AS(decode_points<vec2>(bytes), std::runtime_error);
+    REQUIRE_THROWS_AS(decode_points<vec3>(std::span{bytes}.first(10)), std::runtime_error);
+    REQUIRE_THROWS_AS(decode_points<vec3>(std::span{bytes}.first(bytes.size() - 1)),
+                      std::runtime_error);
+
+    // a corrupt count is rejected before the points are allocated
+    auto huge = bytes;
+    point_stream_header header;
+    std::memcpy(&header, huge.data(), sizeof(header));
+    header.count = std::uint64_t{1} << 60;
+    std::memcpy(huge.data(), &header, sizeof(header));
+    REQUIRE_THROWS_AS(point_decoder<vec3>(huge), std::runtime_error);
+    REQUIRE_THROWS_AS(decode_points<vec3>(huge), std::runtime_error);
+
+    auto const nan = std::numeric_limits<float>::quiet_NaN();
+    auto const inf = std::numeric_limits<float>::infinity();
+    REQUIRE_THROWS_AS(encode_points(std::vector<vec3>{{0, 0, 0}, {1, nan, 2}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(encode_points(std::vector<vec3>{{0, 0, inf}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(encode_points(std::vector<vec2>{{-1e300, 0}, {1e300, 0}}),
+                      std::invalid_argument);
+}
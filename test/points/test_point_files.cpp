@@ -0,0 +1,134 @@
+#include <catch2/catch.hpp>
+#include "spatula/point_files.hpp"
+#include "../util/random_points.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <stdexcept>
+#include <vector>
+
+namespace test_point_files {
+struct vec3 { float x, y, z; };
+struct dvec3 { double x, y, z; };
+struct ivec2 { std::int32_t x, y; };
+
+// a file in the temporary directory that's removed when the test ends
+struct temporary_file {
+    std::filesystem::path path;
+
+    explicit temporary_file(char const * name)
+        : path(std::filesystem::temp_directory_path() / name)
+    {
+    }
+    ~temporary_file() { std::filesystem::remove(path); }
+};
+
+std::vector<vec3> random_points(std::size_t count, unsigned seed)
+{
+    return test_util::random_points<vec3>(count, seed, -1000.f, 1000.f);
+}
+
+bool same(vec3 const & a, vec3 const & b)
+{
+    return a.x == b.x and a.y == b.y and a.z == b.z;
+}
+}
+
+using namespace sp;
+using namespace test_point_files;
+
+TEST_CASE("point_file:aos", "[points][files]") {
+    temporary_file const file{"spatula_test_aos.spp"};
+    auto const points = random_points(200'000, 1);
+    write_point_file(file.path, points);
+
+    point_file const mapped{file.path};
+    REQUIRE(mapped.size() == points.size());
+    REQUIRE(mapped.dimension() == 3);
+    REQUIRE(mapped.layout() == point_layout::aos);
+    REQUIRE(mapped.header().scalar == point_scalar::float32);
+
+    auto const view = mapped.points<vec3>();
+    REQUIRE(view.size() == points.size());
+    REQUIRE(std::ranges::equal(view, points, same));
+    REQUIRE_THROWS_AS(mapped.points<ivec2>(), std::runtime_error);
+    REQUIRE_THROWS_AS(mapped.component<float>(0), std::runtime_error);
+
+    std::vector<dvec3> widened(points.size());
+    REQUIRE(mapped.copy_points<dvec3>(widened.begin()) == widened.end());
+    REQUIRE(widened[123].y == static_cast<double>(points[123].y));
+}
+
+TEST_CASE("point_file:soa", "[points][files]") {
+    temporary_file const file{"spatula_test_soa.spp"};
+    auto const points = random_points(100'003, 2);
+    write_point_file(file.path, points, point_layout::soa);
+
+    point_file const mapped{file.path};
+    REQUIRE(mapped.size() == points.size());
+    REQUIRE(mapped.layout() == point_layout::soa);
+    for (std::size_t i = 0; i < 3; ++i) {
+        auto const component = mapped.component<float>(i);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(component.data()) % 64 == 0);
+        REQUIRE(component.size() == points.size());
+    }
+    auto const y = mapped.component<float>(1);
+    for (std::size_t i = 0; i < points.size(); ++i) { REQUIRE(y[i] == points[i].y); }
+    REQUIRE_THROWS_AS(mapped.component<float>(3), std::runtime_error);
+    REQUIRE_THROWS_AS(mapped.component<double>(0), std::runtime_error);
+    REQUIRE_THROWS_AS(mapped.points<vec3>(), std::runtime_error);
+
+    std::vector<vec3> copied;
+    mapped.copy_points<vec3>(std::back_inserter(copied));
+    REQUIRE(std::ranges::equal(copied, points, same));
+
+    // ranges without a size are buffered to find the capacity
+    std::list<vec3> const listed(points.begin(), points.begin() + 10);
+    write_point_file(file.path, listed, point_layout::soa);
+    REQUIRE(point_file{file.path}.component<float>(2)[9] == points[9].z);
+}
+
+TEST_CASE("point_file_writer:streaming", "[points][files]") {
+    temporary_file const file{"spatula_test_stream.spp"};
+    {
+        point_file_writer<ivec2> writer{file.path};
+        for (std::int32_t i = 0; i < 70'000; ++i) { writer.push_back({i, -i}); }
+        std::vector<ivec2> const more{{1, 2}, {3, 4}};
+        writer.append(more);
+        REQUIRE(writer.size() == 70'002);
+    }
+    point_file const mapped{file.path};
+    auto const points = mapped.points<ivec2>();
+    REQUIRE(points.size() == 70'002);
+    REQUIRE(points[69'999].x == 69'999);
+    REQUIRE(points[69'999].y == -69'999);
+    REQUIRE(points[70'001].y == 4);
+
+    point_file_writer<ivec2> soa{file.path, point_layout::soa, 2};
+    soa.push_back({1, 1});
+    soa.push_back({2, 2});
+    REQUIRE_THROWS_AS(soa.push_back({3, 3}), std::length_error);
+    soa.finish();
+    REQUIRE(point_file{file.path}.component<std::int32_t>(1)[1] == 2);
+}
+
+TEST_CASE("point_file:invalid", "[points][files]") {
+    temporary_file const file{"spatula_test_invalid.spp"};
+    REQUIRE_THROWS_AS(point_file{file.path}, std::system_error);
+
+    std::ofstream{file.path} << "x y z\n1 2 3\n";
+    REQUIRE_THROWS_AS(point_file{file.path}, std::runtime_error);
+
+    // a header that claims more points than the file holds
+    write_point_file(file.path, random_points(100, 3));
+    std::filesystem::resize_file(file.path, sizeof(point_file_header) + 99 * sizeof(vec3));
+    REQUIRE_THROWS_AS(point_file{file.path}, std::runtime_error);
+
+    point_file_header header;
+    header.magic[0] = 'S';
+    std::ofstream{file.path, std::ios::binary}.write(
+        reinterpret_cast<char const *>(&header), sizeof(header));
+    REQUIRE_THROWS_AS(point_file{file.path}, std::runtime_error);
+}
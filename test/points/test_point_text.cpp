@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+#include "spatula/point_text.hpp"
+#include "../util/random_points.hpp"
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace test_point_text {
+struct vec2 { double x, y; };
+struct vec3 { float x, y, z; };
+struct ivec3 { std::int32_t x, y, z; };
+
+bool same(vec3 const & a, vec3 const & b)
+{
+    return a.x == b.x and a.y == b.y and a.z == b.z;
+}
+
+// write the points in the shortest form that parses back exactly
+std::string xyz_text(std::vector<vec3> const & points, char const * separator)
+{
+    std::string text = "x y z r g b\n";
+    char buffer[64];
+    for (auto const & p : points) {
+        for (float const c : {p.x, p.y, p.z}) {
+            auto const end = std::to_chars(buffer, buffer + sizeof(buffer), c).ptr;
+            text.append(buffer, end);
+            text += separator;
+        }
+        text += "255 128 0\n";
+    }
+    return text;
+}
+
+std::vector<vec3> random_points(std::size_t count, unsigned seed)
+{
+    return test_util::random_points<vec3>(count, seed, -1e4f, 1e4f);
+}
+}
+
+using namespace sp;
+using namespace test_point_text;
+
+TEST_CASE("read_points:formats", "[points][text]") {
+    auto const csv = read_points<vec2>("x,y\n1,2\n\n  3.5 , -4e2\r\n# comment\n+5;6");
+    REQUIRE(csv.size() == 3);
+    REQUIRE(csv[1].x == 3.5);
+    REQUIRE(csv[1].y == -400.0);
+    REQUIRE(csv[2].x == 5.0);
+
+    auto const integers = read_points<ivec3>("1\t2\t3\t99\n-4 -5 -6");
+    REQUIRE(integers.size() == 2);
+    REQUIRE(integers[1].z == -6);
+
+    REQUIRE(read_points<vec3>("").empty());
+    REQUIRE(read_points<vec3>("x y z\n").empty());
+}
+
+TEST_CASE("read_points:exact", "[points][text]") {
+    // the fast decimal path has to agree with from_chars on every input
+    auto const require_same_as_from_chars = []<class Float>(std::string const & text, Float) {
+        char const * first = text.data();
+        char const * last = first + text.size();
+        Float fast{}, slow{};
+        auto const fast_end = detail::parse_scalar(first, last, fast);
+        auto const slow_end = std::from_chars(first, last, slow);
+        REQUIRE(fast_end.ec == slow_end.ec);
+        if (slow_end.ec == std::errc{}) {
+            INFO(text);
+            REQUIRE(fast_end.ptr == slow_end.ptr);
+            REQUIRE(std::bit_cast<std::array<char, sizeof(Float)>>(fast) ==
+                    std::bit_cast<std::array<char, sizeof(Float)>>(slow));
+        }
+    };
+    for (std::string const text : {"0", "-0", ".5", "5.", "-.25e1", "1e", "1e+",
+                                   "1E-3", "16777216", "16777217", "0.1", "-",
+                                   ".", "12345678901234567890", "1e22", "1e23",
+                                   "123456789.123456789", "0x10", "inf", "4e-10 "}) {
+        require_same_as_from_chars(text, float{});
+        require_same_as_from_chars(text, double{});
+    }
+
+    std::mt19937 rng{4};
+    std::uniform_int_distribution<int> digit('0', '9');
+    std::uniform_int_distribution<int> length(0, 12);
+    std::uniform_int_distribution<int> power(-30, 30);
+    for (int i = 0; i < 20'000; ++i) {
+        std::string text = i % 2 == 0? "" : "-";
+        for (int n = length(rng); n > 0; --n) { text += static_cast<char>(digit(rng)); }
+        text += '.';
+        for (int n = length(rng); n > 0; --n) { text += static_cast<char>(digit(rng)); }
+        if (i % 3 == 0) { text += "e" + std::to_string(power(rng)); }
+        require_same_as_from_chars(text, float{});
+        require_same_as_from_chars(text, double{});
+    }
+}
+
+TEST_CASE("read_points:malformed", "[points][text]") {
+    REQUIRE_THROWS_WITH(read_points<vec2>("1 2\n3\n"), "malformed point on line 2");
+    REQUIRE_THROWS_WITH(read_points<ivec3>("1 2 3\n4 5.5 6\n"), "malformed point on line 2");
+    REQUIRE_THROWS_WITH(read_points<vec2>("x y\nx y\n"), "malformed point on line 2");
+
+    std::istringstream stream{"0 0\n1 1\n2 two\n"};
+    REQUIRE_THROWS_WITH(read_points<vec2>(stream), "malformed point on line 3");
+}
+
+TEST_CASE("read_points:parallel", "[points][text]") {
+    auto const points = random_points(300'000, 1);
+    auto const text = xyz_text(points, ", ");
+    REQUIRE(text.size() > 4 * detail::min_text_chunk);
+
+    for (std::size_t workers : {1, 2, 5}) {
+        auto const parsed = read_points<vec3>(text, workers);
+        REQUIRE(parsed.size() == points.size());
+        REQUIRE(std::ranges::equal(parsed, points, same));
+    }
+
+    // errors in later chunks still report the line of the whole text
+    auto broken = text;
+    auto const line = 250'000;
+    std::size_t offset = 0;
+    for (int i = 0; i < line; ++i) { offset = broken.find('\n', offset) + 1; }
+    broken[offset] = '?';
+    REQUIRE_THROWS_WITH(read_points<vec3>(broken, 4),
+                        "malformed point on line " + std::to_string(line + 1));
+}
+
+TEST_CASE("read_points:stream", "[points][text]") {
+    auto const points = random_points(200'000, 2);
+    std::istringstream stream{xyz_text(points, " ")};
+    auto const parsed = read_points<vec3>(stream);
+    REQUIRE(std::ranges::equal(parsed, points, same));
+
+    // a last line without a line break
+    std::istringstream unterminated{"1 2\n3 4"};
+    REQUIRE(read_points<vec2>(unterminated).size() == 2);
+}
+
+TEST_CASE("read_points_file", "[points][text]") {
+    auto const path = std::filesystem::temp_directory_path() / "spatula_test_points.xyz";
+    auto const points = random_points(1000, 3);
+    std::ofstream{path} << xyz_text(points, "\t");
+    auto const parsed = read_points_file<vec3>(path);
+    std::filesystem::remove(path);
+    REQUIRE(std::ranges::equal(parsed, points, same));
+
+    REQUIRE_THROWS_AS(read_points_file<vec3>(path), std::system_error);
+}
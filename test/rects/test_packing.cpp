@@ -0,0 +1,135 @@
+#include <catch2/catch.hpp>
+#include "spatula/packing.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace test_packing {
+struct rect { std::int32_t x, y, w, h; };
+
+std::vector<rect> random_sizes(std::size_t count, unsigned seed)
+{
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<int> side(4, 40);
+    std::vector<rect> sizes(count);
+    for (auto & r : sizes) { r = rect{0, 0, side(rng), side(rng)}; }
+    return sizes;
+}
+
+// every placement lies within the bin, has its requested size, and doesn't
+// overlap any other placement
+void require_valid(std::vector<rect> const & sizes,
+                   std::vector<rect> const & placements, int width, int height)
+{
+    for (std::size_t i = 0; i < placements.size(); ++i) {
+        auto const & p = placements[i];
+        if (sp::is_empty(p)) { continue; }
+        REQUIRE(p.w == sizes[i].w);
+        REQUIRE(p.h == sizes[i].h);
+        REQUIRE(p.x >= 0);
+        REQUIRE(p.y >= 0);
+        REQUIRE(p.x + p.w <= width);
+        REQUIRE(p.y + p.h <= height);
+        for (std::size_t j = i + 1; j < placements.size(); ++j) {
+            REQUIRE(not sp::overlaps(p, placements[j]));
+        }
+    }
+}
+
+template<class Packer>
+void require_packs_well(double min_occupancy)
+{
+    auto const sizes = random_sizes(800, 11);
+    Packer packer(512, 512);
+    std::vector<rect> placements(sizes.size());
+    auto const placed = sp::pack_rects(packer, sizes, placements.begin());
+    require_valid(sizes, placements, 512, 512);
+
+    std::size_t area = 0;
+    std::size_t count = 0;
+    for (auto const & p : placements) {
+        if (sp::is_empty(p)) { continue; }
+        area += static_cast<std::size_t>(p.w * p.h);
+        ++count;
+    }
+    REQUIRE(count == placed);
+    REQUIRE(packer.used_area() == area);
+    REQUIRE(static_cast<double>(area) / (512.0 * 512.0) > min_occupancy);
+}
+}
+
+using namespace sp;
+using namespace test_packing;
+
+TEST_CASE("skyline_packer:insert", "[packing][rects]") {
+    skyline_packer<rect> packer(10, 10);
+    auto const a = packer.insert(6, 4);
+    REQUIRE(a);
+    REQUIRE(a->x == 0);
+    REQUIRE(a->y == 0);
+    auto const b = packer.insert(4, 2);
+    REQUIRE(b);
+    REQUIRE(b->x == 6);
+    REQUIRE(b->y == 0);
+    auto const c = packer.insert(10, 6);
+    REQUIRE(c);
+    REQUIRE(c->y == 4);
+    REQUIRE(not packer.insert(1, 1));
+    REQUIRE(not packer.insert(0, 3));
+
+    packer.clear();
+    REQUIRE(packer.used_area() == 0);
+    REQUIRE(packer.insert(10, 10));
+}
+
+TEST_CASE("max_rects_packer:insert", "[packing][rects]") {
+    max_rects_packer<rect> packer(10, 10);
+    auto const a = packer.insert(6, 4);
+    REQUIRE(a);
+    REQUIRE(packer.free_rects().size() == 2);
+
+    // the gap to the right of a is filled exactly
+    auto const b = packer.insert(4, 4);
+    REQUIRE(b);
+    REQUIRE(b->x == 6);
+    REQUIRE(b->y == 0);
+    REQUIRE(packer.insert(10, 6));
+    REQUIRE(packer.free_rects().empty());
+    REQUIRE(not packer.insert(1, 1));
+    REQUIRE(not packer.insert(11, 1));
+}
+
+TEST_CASE("pack_rects:skyline", "[packing][rects]") {
+    require_packs_well<skyline_packer<rect>>(0.85);
+}
+
+TEST_CASE("pack_rects:max_rects", "[packing][rects]") {
+    require_packs_well<max_rects_packer<rect>>(0.95);
+}
+
+TEST_CASE("pack_rects:incremental", "[packing][rects]") {
+    auto const sizes = random_sizes(60, 3);
+    max_rects_packer<rect> packer(256, 256);
+    std::vector<rect> placements(sizes.size());
+    REQUIRE(pack_rects(packer, sizes, placements.begin()) == sizes.size());
+
+    auto const more = random_sizes(40, 4);
+    std::vector<rect> all_sizes = sizes;
+    for (auto const & size : more) {
+        auto const placed = packer.insert(size.w, size.h);
+        REQUIRE(placed);
+        all_sizes.push_back(size);
+        placements.push_back(*placed);
+    }
+    require_valid(all_sizes, placements, 256, 256);
+}
+
+TEST_CASE("pack_rects:overflow", "[packing][rects]") {
+    std::vector<rect> const sizes{{0, 0, 8, 8}, {0, 0, 20, 2}, {0, 0, 8, 8}};
+    skyline_packer<rect> packer(16, 8);
+    std::vector<rect> placements(sizes.size());
+    REQUIRE(pack_rects(packer, sizes, placements.begin()) == 2);
+    REQUIRE(is_empty(placements[1]));
+    require_valid(sizes, placements, 16, 8);
+}
@@ -0,0 +1,147 @@
+#include <catch2/catch.hpp>
+#include "spatula/rects.hpp"
+
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace test_rects {
+struct rect { std::int32_t x, y, w, h; };
+struct frect { float x, y, w, h; };
+
+template<class Rect>
+bool same(Rect const & a, Rect const & b)
+{
+    return a.x == b.x and a.y == b.y and a.w == b.w and a.h == b.h;
+}
+
+template<class Rect>
+std::vector<Rect> random_rects(std::size_t count, unsigned seed)
+{
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<int> corner(-50, 250);
+    std::uniform_int_distribution<int> extent(-5, 60);
+    std::vector<Rect> rects(count);
+    for (auto & r : rects) {
+        r = Rect{static_cast<decltype(r.x)>(corner(rng)),
+                 static_cast<decltype(r.x)>(corner(rng)),
+                 static_cast<decltype(r.x)>(extent(rng)),
+                 static_cast<decltype(r.x)>(extent(rng))};
+    }
+    return rects;
+}
+}
+
+using namespace sp;
+using namespace test_rects;
+
+TEST_CASE("rectangle:concept", "[rects]") {
+    STATIC_REQUIRE(rectangle<rect>);
+    STATIC_REQUIRE(rectangle<frect>);
+    STATIC_REQUIRE(detail::is_simd_rect<rect>);
+    STATIC_REQUIRE(not detail::is_simd_rect<frect>);
+}
+
+TEST_CASE("rectangle:operations", "[rects]") {
+    rect const a{0, 0, 10, 10};
+    rect const b{5, 8, 10, 10};
+    rect const c{10, 0, 5, 5};
+
+    REQUIRE(overlaps(a, b));
+    REQUIRE(not overlaps(a, c));
+    REQUIRE(not overlaps(a, rect{2, 2, 0, 3}));
+    REQUIRE(same(intersection(a, b), rect{5, 8, 5, 2}));
+    REQUIRE(is_empty(intersection(a, c)));
+    REQUIRE(same(bounding_rect(a, b), rect{0, 0, 15, 18}));
+    REQUIRE(same(bounding_rect(rect{}, c), c));
+}
+
+TEST_CASE("clip_rects", "[rects]") {
+    rect const viewport{0, 0, 160, 120};
+    for (std::size_t count : {0, 3, 4, 17, 1000}) {
+        auto const rects = random_rects<rect>(count, static_cast<unsigned>(count));
+        std::vector<rect> clipped(count);
+        auto const end = clip_rects(rects, viewport, clipped.begin());
+        REQUIRE(end == clipped.end());
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const expected = intersection(rects[i], viewport);
+            REQUIRE(is_empty(clipped[i]) == is_empty(expected));
+            if (not is_empty(expected)) { REQUIRE(same(clipped[i], expected)); }
+        }
+    }
+
+    auto const floats = random_rects<frect>(9, 1);
+    std::vector<frect> clipped;
+    clip_rects(floats, frect{0, 0, 100, 100}, std::back_inserter(clipped));
+    REQUIRE(clipped.size() == 9);
+    REQUIRE(same(clipped[4], intersection(floats[4], frect{0, 0, 100, 100})));
+}
+
+TEST_CASE("cull_rects", "[rects]") {
+    rect const viewport{20, 10, 100, 80};
+    for (std::size_t count : {0, 5, 8, 31, 2000}) {
+        auto const rects = random_rects<rect>(count, 7);
+        std::vector<std::size_t> expected, actual;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (overlaps(rects[i], viewport)) { expected.push_back(i); }
+        }
+        cull_rects(rects, viewport, std::back_inserter(actual));
+        REQUIRE(actual == expected);
+    }
+    std::vector<std::size_t> none;
+    cull_rects(random_rects<rect>(10, 2), rect{}, std::back_inserter(none));
+    REQUIRE(none.empty());
+}
+
+TEST_CASE("overlap_mask", "[rects]") {
+    auto const rows = random_rects<rect>(37, 3);
+    auto const columns = random_rects<rect>(71, 4);
+    bit_grid mask;
+    overlap_mask(rows, columns, mask);
+    REQUIRE(mask.width() == columns.size());
+    REQUIRE(mask.height() == rows.size());
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+    for (std::size_t j = 0; j < columns.size(); ++j) {
+        REQUIRE(mask.test(j, i) == overlaps(rows[i], columns[j]));
+    }}
+
+    auto const floats = random_rects<frect>(13, 5);
+    overlap_mask(floats, floats, mask);
+    for (std::size_t i = 0; i < floats.size(); ++i) {
+    for (std::size_t j = 0; j < floats.size(); ++j) {
+        REQUIRE(mask.test(j, i) == overlaps(floats[i], floats[j]));
+    }}
+}
+
+TEST_CASE("bounding_rect:range", "[rects]") {
+    std::vector<rect> const rects{{5, 5, 2, 2}, {0, 0, 0, 9}, {-3, 4, 4, 10}};
+    REQUIRE(same(bounding_rect(rects), rect{-3, 4, 10, 10}));
+    REQUIRE(is_empty(bounding_rect(std::vector<rect>{})));
+}
+
+TEST_CASE("merge_rects", "[rects]") {
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        auto const rects = random_rects<rect>(300, seed);
+        auto const merged = merge_rects(rects);
+
+        // no two merged rectangles overlap, and they cover every input
+        for (std::size_t i = 0; i < merged.size(); ++i) {
+            for (std::size_t j = i + 1; j < merged.size(); ++j) {
+                REQUIRE(not overlaps(merged[i], merged[j]));
+            }
+        }
+        for (auto const & r : rects) {
+            if (is_empty(r)) { continue; }
+            REQUIRE(std::ranges::any_of(merged, [&](rect const & m) {
+                return same(intersection(r, m), r);
+            }));
+        }
+    }
+
+    std::vector<frect> const floats{{0, 0, 2, 2}, {1, 1, 2, 2}, {5, 5, 1, 1}};
+    auto const merged = merge_rects(floats);
+    REQUIRE(merged.size() == 2);
+    REQUIRE(same(merged[0], frect{0, 0, 3, 3}));
+}
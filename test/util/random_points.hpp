@@ -0,0 +1,30 @@
+#pragma once
+
+// data types and data structures
+#include "spatula/vectors.hpp"
+#include <vector>
+
+// algorithms
+#include <random>
+
+namespace test_util {
+
+// points with coordinates drawn uniformly from [lower, upper)
+template<class Vector>
+std::vector<Vector> random_points(std::size_t count, unsigned seed,
+                                  float lower, float upper)
+{
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<float> coordinate(lower, upper);
+    std::vector<Vector> points(count);
+    for (auto & p : points) {
+        if constexpr (sp::dimension_v<Vector> == 2) {
+            p = {coordinate(rng), coordinate(rng)};
+        }
+        else {
+            p = {coordinate(rng), coordinate(rng), coordinate(rng)};
+        }
+    }
+    return points;
+}
+}
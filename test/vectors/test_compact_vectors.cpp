@@ -0,0 +1,132 @@
+#include <catch2/catch.hpp>
+#include "spatula/compact_vectors.hpp"
+#include "../util/random_points.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace test_compact_vectors {
+struct vec2 { float x, y; };
+struct vec3 { float x, y, z; };
+struct dvec3 { double x, y, z; };
+
+std::vector<vec3> random_points(std::size_t count, unsigned seed)
+{
+    return test_util::random_points<vec3>(count, seed, -300.f, 700.f);
+}
+}
+
+using namespace sp;
+using namespace test_compact_vectors;
+
+TEST_CASE("half_vector:semivector", "[semivector][compact]") {
+    REQUIRE(semivector2<half_vector<2>>);
+    REQUIRE(semivector3<half_vector<3>>);
+    REQUIRE(semivector4<half_vector<4>>);
+    REQUIRE(semivector3<quantized_vector<3, 16>>);
+    REQUIRE(semivector2<quantized_vector<2, 8>>);
+    REQUIRE(packed_layout<half_vector<3>>);
+    REQUIRE(packed_layout<quantized_vector<3, 12>>);
+    REQUIRE(sizeof(half_vector<3>) == 6);
+    REQUIRE(sizeof(quantized_vector<4, 8>) == 4);
+
+    // algorithms over semivectors accept compact vectors
+    std::vector<half_vector<2>> points{{half{1.f}, half{-2.f}}, {half{-3.f}, half{4.f}}};
+    auto const [lower, upper] = bounding_corners2d(points);
+    REQUIRE(float(lower.x) == -3.f);
+    REQUIRE(float(upper.y) == 4.f);
+}
+
+TEST_CASE("half:conversion", "[compact][half]") {
+    // every finite half converts to a float and back to itself
+    for (std::uint32_t bits = 0; bits < 0x10000; ++bits) {
+        auto const h = half::from_bits(static_cast<std::uint16_t>(bits));
+        float const f = h;
+        if (std::isnan(f)) { continue; }
+        REQUIRE(half{f}.bits() == h.bits());
+    }
+    REQUIRE(float(half{1.f / 3.f}) == 0.333251953125f);
+    REQUIRE(half{65520.f}.bits() == 0x7c00);              // rounds to infinity
+    REQUIRE(half{65519.f}.bits() == 0x7bff);
+    REQUIRE(half{std::ldexp(1.f, -24)}.bits() == 0x0001);  // smallest subnormal
+    REQUIRE(half{std::ldexp(1.f, -26)}.bits() == 0x0000);
+    REQUIRE(half{-0.f}.bits() == 0x8000);
+    REQUIRE(std::isnan(float(half{std::numeric_limits<float>::quiet_NaN()})));
+
+    // ties round to even
+    REQUIRE(half{1.f + std::ldexp(1.f, -11)}.bits() == 0x3c00);
+    REQUIRE(half{1.f + 3 * std::ldexp(1.f, -11)}.bits() == 0x3c02);
+
+    REQUIRE(float(half{1.5f} + half{2.25f}) == 3.75f);
+    REQUIRE(half{-1.f} < half{0.5f});
+}
+
+TEST_CASE("quantized:arithmetic", "[compact][quantized]") {
+    REQUIRE(quantized<16>{0.5f}.bits() == 16384);
+    REQUIRE(quantized<16>{1.f}.bits() == 32767);
+    REQUIRE(quantized<16>{-2.f}.bits() == -32767);
+    REQUIRE(quantized<8>{-1.f}.bits() == -127);
+    REQUIRE(float(quantized<8>{0.5f} + quantized<8>{0.75f}) == 1.f);
+    REQUIRE(float(quantized<12>{0.5f} * quantized<12>{0.5f}) == Approx(0.25f).margin(1e-3));
+    REQUIRE(quantized<16>{-0.25f} < quantized<16>{0.25f});
+}
+
+TEST_CASE("encode_halves:ranges", "[compact][half]") {
+    auto const points = random_points(1003, 5);
+    std::vector<half_vector<3>> halves(points.size());
+    REQUIRE(encode_halves(points, halves.begin()) == halves.end());
+
+    std::vector<vec3> decoded(points.size());
+    decode_halves<vec3>(halves, decoded.begin());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        REQUIRE(halves[i].x.bits() == half{points[i].x}.bits());
+        REQUIRE(decoded[i].z == float(half{points[i].z}));
+        REQUIRE(decoded[i].y == Approx(points[i].y).epsilon(1e-3));
+    }
+
+    // other vector types take the component-wise path
+    std::vector<dvec3> wide;
+    decode_halves<dvec3>(halves, std::back_inserter(wide));
+    REQUIRE(wide.size() == points.size());
+    REQUIRE(wide[7].x == double(float(halves[7].x)));
+}
+
+TEST_CASE("quantize:ranges", "[compact][quantized]") {
+    auto const points = random_points(1003, 9);
+    std::pair<vec3, vec3> const bounds{{-300.f, -300.f, -300.f}, {700.f, 700.f, 700.f}};
+
+    std::vector<quantized_vector<3, 16>> compact(points.size());
+    REQUIRE(quantize<16>(points, bounds, compact.begin()) == compact.end());
+    std::vector<vec3> decoded(points.size());
+    dequantize<vec3>(compact, bounds, decoded.begin());
+
+    // the contiguous kernels agree with the one-at-a-time path
+    std::vector<quantized_vector<3, 16>> slow;
+    quantize<16>(points, bounds, std::back_inserter(slow));
+    std::vector<dvec3> wide;
+    std::pair<dvec3, dvec3> const wide_bounds{{-300.0, -300.0, -300.0},
+                                              {700.0, 700.0, 700.0}};
+    dequantize<dvec3>(compact, wide_bounds, std::back_inserter(wide));
+
+    float const step = 1000.f / 65534.f;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        REQUIRE(slow[i].x == compact[i].x);
+        REQUIRE(slow[i].z == compact[i].z);
+        REQUIRE(std::abs(decoded[i].x - points[i].x) <= step);
+        REQUIRE(std::abs(decoded[i].y - points[i].y) <= step);
+        REQUIRE(wide[i].z == double(decoded[i].z));
+    }
+
+    // points outside of the box saturate to its sides
+    std::vector<vec2> outside{{-1000.f, 1000.f}};
+    std::pair<vec2, vec2> const unit{{0.f, 0.f}, {1.f, 1.f}};
+    std::vector<quantized_vector<2, 8>> saturated(1);
+    quantize<8>(outside, unit, saturated.begin());
+    REQUIRE(saturated[0].x.bits() == -127);
+    REQUIRE(saturated[0].y.bits() == 127);
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+#include "spatula/expressions.hpp"
+
+#include <iterator>
+#include <vector>
+
+namespace test_expressions {
+struct vec2 { float x, y; };
+struct vec3 { float x, y, z; };
+struct ivec2 { int x, y; };
+struct dvec3 { double x, y, z; };
+}
+
+using namespace sp;
+using namespace test_expressions;
+
+TEST_CASE("expr:vectors", "[expressions]") {
+    vec3 const a{1, 2, 3};
+    vec3 const b{4, 5, 6};
+    vec3 const c{0.5f, 0.5f, 0.5f};
+
+    auto const e = expr(a) + expr(b) * 2.f - c;
+    REQUIRE(vector_expression<decltype(e)>);
+    auto const v = evaluate(e);
+    REQUIRE((std::same_as<decltype(v), vec3 const>));
+    REQUIRE(v.x == 8.5f);
+    REQUIRE(v.y == 11.5f);
+    REQUIRE(v.z == 14.5f);
+
+    // component-wise products and quotients, negation and scalars on the left
+    auto const w = evaluate(-(0.5f * expr(a)) + expr(a) * b / c);
+    REQUIRE(w.x == 7.5f);
+    REQUIRE(w.z == 34.5f);
+
+    // integer vectors are computed in the type of each operation and
+    // converted back at the end
+    auto const half = evaluate(expr(ivec2{3, 5}) * 0.5);
+    REQUIRE(half.x == 1);
+    REQUIRE(half.y == 2);
+    auto const wide = evaluate<dvec3>(expr(a) / 4.0);
+    REQUIRE(wide.z == 0.75);
+}
+
+TEST_CASE("assign:vectors", "[expressions]") {
+    vec2 position{1, 1};
+    vec2 const velocity{2, -4};
+    assign(position, expr(position) + expr(velocity) * 0.25f);
+    REQUIRE(position.x == 1.5f);
+    REQUIRE(position.y == 0.f);
+
+    // the target can be mixed into the expression more than once
+    assign(position, expr(position) * position - position);
+    REQUIRE(position.x == 0.75f);
+    REQUIRE(position.y == 0.f);
+}
+
+TEST_CASE("expr:ranges", "[expressions]") {
+    std::vector<vec3> a, b;
+    for (int i = 0; i < 100; ++i) {
+        a.push_back({float(i), float(2 * i), float(3 * i)});
+        b.push_back({1.f, float(-i), 0.5f});
+    }
+    vec3 const offset{10, 20, 30};
+
+    std::vector<vec3> out;
+    auto const e = expr(a) + expr(b) * 2.f + offset;
+    REQUIRE(e.size() == a.size());
+    evaluate(e, std::back_inserter(out));
+    REQUIRE(out.size() == a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        REQUIRE(out[i].x == a[i].x + b[i].x * 2.f + 10.f);
+        REQUIRE(out[i].y == a[i].y + b[i].y * 2.f + 20.f);
+        REQUIRE(out[i].z == a[i].z + b[i].z * 2.f + 30.f);
+    }
+
+    // assigning in place updates each element from its own old value
+    assign(a, expr(a) - b);
+    REQUIRE(a[7].x == 6.f);
+    REQUIRE(a[7].y == 21.f);
+
+    // ranges held by value outlive the statement that made them
+    auto const owned = expr(std::vector<vec2>{{1, 2}, {3, 4}}) * 3.f;
+    std::vector<vec2> tripled(2);
+    REQUIRE(evaluate(owned, tripled.begin()) == tripled.end());
+    REQUIRE(tripled[1].y == 12.f);
+}
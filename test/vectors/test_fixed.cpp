@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+#include "spatula/fixed.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace test_fixed {
+using real = sp::fixed<16, 16>;
+using precise = sp::fixed<24, 40>;
+
+struct point2 { real x, y; };
+struct point3 { real x, y, z; };
+}
+
+using namespace sp;
+using namespace test_fixed;
+
+TEST_CASE("fixed:field", "[field][fixed]") {
+    REQUIRE(field<real>);
+    REQUIRE(field<precise>);
+    REQUIRE(field<fixed<8, 0>>);
+    REQUIRE(has_field_closure<real>);
+    REQUIRE(semivector2<point2>);
+    REQUIRE(semivector3<point3>);
+    REQUIRE(packed_layout<point3>);
+    REQUIRE(sizeof(real) == 4);
+    REQUIRE(sizeof(precise) == 8);
+}
+
+TEST_CASE("fixed:arithmetic", "[fixed]") {
+    REQUIRE(real{3}.raw() == 3 << 16);
+    REQUIRE(real{-2.5}.raw() == -5 << 15);
+    REQUIRE(double(real{1.0 / 3.0}) == Approx(1.0 / 3.0).margin(1.0 / 65536));
+
+    REQUIRE(real{3} + real{4} == real{7});
+    REQUIRE(real{3} - real{4.5} == real{-1.5});
+    REQUIRE(real{1.5} * real{-2.5} == real{-3.75});
+    REQUIRE(real{7} / real{2} == real{3.5});
+    REQUIRE(real{-7} / real{2} == real{-3.5});
+    REQUIRE(real{2} * 3 == real{6});
+    REQUIRE(int(real{-2.25}) == -3);
+    REQUIRE(real{-1} < real{0.5});
+
+    // products round to the nearest representable value
+    auto const ulp = real::from_raw(1);
+    REQUIRE(ulp * real{0.5} == ulp);
+    REQUIRE(ulp * real{0.25} == real{});
+    REQUIRE((-ulp) * real{0.25} == real{});
+
+    // overflow wraps and division by zero saturates instead of trapping
+    auto const largest = real::from_raw(std::numeric_limits<std::int32_t>::max());
+    REQUIRE(largest + ulp == real::from_raw(std::numeric_limits<std::int32_t>::min()));
+    REQUIRE(real{5} / real{} == largest);
+    REQUIRE(real{-5} / real{} == real::from_raw(std::numeric_limits<std::int32_t>::min()));
+
+    REQUIRE(precise{1.5} * precise{1e6} == precise{1.5e6});
+    REQUIRE(double(precise{1} / precise{3}) == Approx(1.0 / 3.0).epsilon(1e-12));
+}
+
+TEST_CASE("fixed:sqrt", "[fixed]") {
+    REQUIRE(sqrt(real{4}) == real{2});
+    REQUIRE(sqrt(real{-4}) == real{});
+    REQUIRE(sqrt(precise{2.25}) == precise{1.5});
+
+    // the result is the floor of the exact root of the representation
+    std::mt19937_64 rng{11};
+    for (int i = 0; i < 10000; ++i) {
+        auto const x = real::from_raw(static_cast<std::int32_t>(rng() >> 33));
+        auto const n = static_cast<std::uint64_t>(x.raw()) << 16;
+        auto const root = static_cast<std::uint64_t>(sqrt(x).raw());
+        REQUIRE(root * root <= n);
+        REQUIRE((root + 1) * (root + 1) > n);
+
+        auto const y = precise::from_raw(static_cast<std::int64_t>(rng() >> 1));
+        REQUIRE(double(sqrt(y)) == Approx(std::sqrt(double(y))).epsilon(1e-12));
+    }
+}
+
+TEST_CASE("fixed:trigonometry", "[fixed]") {
+    REQUIRE(sin(real{}) == real{});
+    REQUIRE(cos(real{}) == real{1});
+    for (double angle = -10.0; angle < 10.0; angle += 0.01) {
+        REQUIRE(double(sin(real{angle})) == Approx(std::sin(angle)).margin(3e-5));
+        REQUIRE(double(cos(real{angle})) == Approx(std::cos(angle)).margin(3e-5));
+        REQUIRE(double(sin(precise{angle})) == Approx(std::sin(angle)).margin(1e-6));
+    }
+}
+
+TEST_CASE("fixed:deterministic", "[fixed]") {
+    // a fixed sequence of operations always ends with the same bits
+    point2 position{real{0}, real{100}};
+    point2 velocity{real{3.5}, real{0}};
+    real const dt{1.0 / 60.0};
+    real const gravity{-9.81};
+    for (int step = 0; step < 600; ++step) {
+        velocity.y += gravity * dt;
+        real const spin = sin(real{step} * dt) * real{0.25};
+        position.x += (velocity.x + spin) * dt;
+        position.y += velocity.y * dt;
+        if (position.y < real{}) {
+            position.y = -position.y;
+            velocity.y = -velocity.y * real{0.8};
+        }
+    }
+    REQUIRE(position.x.raw() == 2323436);
+    REQUIRE(position.y.raw() == 3067624);
+}
+
+TEST_CASE("fixed:batches", "[fixed]") {
+    std::mt19937 rng{5};
+    std::uniform_int_distribution<std::int32_t> raw(-(1 << 24), 1 << 24);
+    std::vector<real> a(1003), b(1003);
+    for (auto & x : a) { x = real::from_raw(raw(rng)); }
+    for (auto & x : b) { x = real::from_raw(raw(rng)); }
+
+    std::vector<real> products(a.size());
+    REQUIRE(multiply(a, b, products.begin()) == products.end());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        REQUIRE(products[i] == a[i] * b[i]);
+    }
+
+    std::vector<point3> points(a.size() / 3);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        points[i] = {a[3 * i], a[3 * i + 1], a[3 * i + 2]};
+    }
+    std::vector<point3> scaled(points.size());
+    std::vector<point3> slow;
+    scale(points, real{-1.75}, scaled.begin());
+    scale(points, real{-1.75}, std::back_inserter(slow));
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        REQUIRE(scaled[i].x == points[i].x * real{-1.75});
+        REQUIRE(scaled[i].z == slow[i].z);
+    }
+}
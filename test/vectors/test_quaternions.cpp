@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+#include "spatula/quaternions.hpp"
+
+#include <Eigen/Dense>
+#include "spatula_extensions/eigen.hpp"
+
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace test_quaternions {
+struct quat { float x, y, z, w; };
+struct dquat { double x, y, z, w; };
+struct vec3 { float x, y, z; };
+struct dvec3 { double x, y, z; };
+
+std::vector<quat> random_rotations(std::size_t count, unsigned seed)
+{
+    std::mt19937 rng{seed};
+    std::uniform_real_distribution<float> axis(-1.f, 1.f);
+    std::uniform_real_distribution<float> angle(-3.f, 3.f);
+    std::vector<quat> rotations(count);
+    for (auto & q : rotations) {
+        q = sp::axis_angle<quat>(vec3{axis(rng), axis(rng), axis(rng) + 2.f}, angle(rng));
+    }
+    return rotations;
+}
+
+bool near(quat const & a, quat const & b, float margin)
+{
+    return std::abs(a.x - b.x) <= margin and std::abs(a.y - b.y) <= margin and
+           std::abs(a.z - b.z) <= margin and std::abs(a.w - b.w) <= margin;
+}
+}
+
+using namespace sp;
+using namespace test_quaternions;
+
+TEST_CASE("quaternion:concept", "[quaternion]") {
+    REQUIRE(quaternion<quat>);
+    REQUIRE(quaternion<dquat>);
+    REQUIRE(quaternion<Eigen::Vector4f>);
+    REQUIRE_FALSE(quaternion<vec3>);
+
+    // library vectors hold rotations too
+    auto const q = axis_angle<Eigen::Vector4f>(Eigen::Vector3f{0, 0, 1},
+                                               std::numbers::pi_v<float> / 2);
+    Eigen::Vector3f const turned = rotate(q, Eigen::Vector3f{1, 0, 0});
+    REQUIRE(turned.x() == Approx(0).margin(1e-6));
+    REQUIRE(turned.y() == Approx(1));
+}
+
+TEST_CASE("quaternion:rotation", "[quaternion]") {
+    auto const yaw = axis_angle<dquat>(dvec3{0, 0, 1}, std::numbers::pi / 2);
+    auto const pitch = axis_angle<dquat>(dvec3{0, 1, 0}, std::numbers::pi / 2);
+    auto const x = rotate(yaw, dvec3{1, 0, 0});
+    REQUIRE(x.x == Approx(0).margin(1e-12));
+    REQUIRE(x.y == Approx(1));
+
+    // products rotate by the right-hand side first, like matrices
+    auto const both = rotate(quaternion_product(pitch, yaw), dvec3{1, 0, 0});
+    auto const twice = rotate(pitch, rotate(yaw, dvec3{1, 0, 0}));
+    REQUIRE(both.x == Approx(twice.x).margin(1e-12));
+    REQUIRE(both.y == Approx(twice.y).margin(1e-12));
+    REQUIRE(both.z == Approx(twice.z).margin(1e-12));
+
+    auto const back = rotate(conjugate(yaw), x);
+    REQUIRE(back.x == Approx(1));
+
+    // the matrix of a quaternion rotates the same way
+    auto const m = to_affine(quaternion_product(pitch, yaw));
+    auto const p = transform_point(m, dvec3{1, 2, 3});
+    auto const r = rotate(quaternion_product(pitch, yaw), dvec3{1, 2, 3});
+    REQUIRE(p.x == Approx(r.x));
+    REQUIRE(p.y == Approx(r.y));
+    REQUIRE(p.z == Approx(r.z));
+
+    auto const unit = normalize(quat{1, 2, 2, 4});
+    REQUIRE(unit.w == Approx(0.8f));
+}
+
+TEST_CASE("quaternion:interpolation", "[quaternion]") {
+    auto const a = axis_angle<dquat>(dvec3{0, 0, 1}, 0.2);
+    auto const b = axis_angle<dquat>(dvec3{0, 0, 1}, 1.4);
+    auto const halfway = slerp(a, b, 0.25);
+    auto const expected = axis_angle<dquat>(dvec3{0, 0, 1}, 0.5);
+    REQUIRE(halfway.z == Approx(expected.z));
+    REQUIRE(halfway.w == Approx(expected.w));
+
+    // the negation of a quaternion is the same rotation, and interpolation
+    // takes the shorter way around either way
+    dquat const negated{-b.x, -b.y, -b.z, -b.w};
+    auto const flipped = slerp(a, negated, 0.25);
+    REQUIRE(std::abs(flipped.w) == Approx(expected.w));
+    auto const cheap = nlerp(a, negated, 0.5);
+    REQUIRE(std::abs(cheap.w) == Approx(std::cos(0.4)));
+
+    REQUIRE(slerp(a, a, 0.7).w == Approx(a.w));
+}
+
+TEST_CASE("quaternion:batches", "[quaternion]") {
+    auto const a = random_rotations(1003, 1);
+    auto b = random_rotations(1003, 2);
+    b[5] = a[5];
+    b[6] = quat{-a[6].x, -a[6].y, -a[6].z, -a[6].w};
+
+    std::vector<quat> scaled(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        float const s = 0.5f + static_cast<float>(i % 7);
+        scaled[i] = {a[i].x * s, a[i].y * s, a[i].z * s, a[i].w * s};
+    }
+    std::vector<quat> unit(a.size());
+    REQUIRE(normalize(scaled, unit.begin()) == unit.end());
+
+    std::vector<quat> fast(a.size()), cheap(a.size());
+    std::vector<quat> slow;
+    slerp(a, b, 0.3f, fast.begin());
+    slerp(a, b, 0.3f, std::back_inserter(slow));
+    nlerp(a, b, 0.3f, cheap.begin());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        REQUIRE(near(unit[i], a[i], 1e-6f));
+        REQUIRE(near(fast[i], slerp(a[i], b[i], 0.3f), 1e-6f));
+        REQUIRE(near(slow[i], slerp(a[i], b[i], 0.3f), 0.f));
+        REQUIRE(near(cheap[i], nlerp(a[i], b[i], 0.3f), 1e-6f));
+    }
+
+    std::mt19937 rng{3};
+    std::uniform_real_distribution<float> coordinate(-10.f, 10.f);
+    std::vector<vec3> points(a.size());
+    for (auto & p : points) { p = {coordinate(rng), coordinate(rng), coordinate(rng)}; }
+
+    std::vector<vec3> rotated(points.size());
+    std::vector<vec3> turned(points.size());
+    rotate(a, points, rotated.begin());
+    rotate(a[3], points, turned.begin());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        auto const expected = rotate(a[i], points[i]);
+        REQUIRE(rotated[i].x == Approx(expected.x).margin(1e-5));
+        REQUIRE(rotated[i].y == Approx(expected.y).margin(1e-5));
+        REQUIRE(rotated[i].z == Approx(expected.z).margin(1e-5));
+        auto const same = rotate(a[3], points[i]);
+        REQUIRE(turned[i].x == Approx(same.x).margin(1e-5));
+        REQUIRE(turned[i].z == Approx(same.z).margin(1e-5));
+    }
+
+    // rotating in place, and back again
+    auto moved = points;
+    rotate(a, moved, moved.begin());
+    REQUIRE(moved[1000].y == rotated[1000].y);
+    std::vector<quat> inverses(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) { inverses[i] = conjugate(a[i]); }
+    rotate(inverses, moved, moved.begin());
+    REQUIRE(moved[17].x == Approx(points[17].x).margin(1e-4));
+}
@@ -0,0 +1,94 @@
+#include <catch2/catch.hpp>
+#include "spatula/views.hpp"
+
+#include <ranges>
+#include <vector>
+
+namespace test_views {
+struct vec2 { float x, y; };
+struct vec3 { float x, y, z; };
+struct ivec2 { int x, y; };
+}
+
+using namespace sp;
+using namespace test_views;
+
+TEST_CASE("views:adaptors", "[views]") {
+    std::vector<vec2> const points{{1, 2}, {-3, 4}, {5, -6}};
+
+    auto moved = points | views::add(vec2{10, 20});
+    REQUIRE(std::ranges::random_access_range<decltype(moved)>);
+    REQUIRE(moved.size() == points.size());
+    REQUIRE(moved[1].x == 7.f);
+    REQUIRE(moved[1].y == 24.f);
+
+    auto const scaled = views::scale(points, 2.f);
+    REQUIRE(scaled[2].y == -12.f);
+    auto const stretched = points | views::scale(vec2{2, -1});
+    REQUIRE(stretched[0].x == 2.f);
+    REQUIRE(stretched[0].y == -2.f);
+
+    auto const halfway = points | views::lerp(vec2{1, 0}, 0.5f);
+    REQUIRE(halfway[1].x == -1.f);
+    REQUIRE(halfway[1].y == 2.f);
+
+    auto const clamped = points | views::clamp(-2, vec2{4, 3});
+    REQUIRE(clamped[1].x == -2.f);
+    REQUIRE(clamped[2].x == 4.f);
+    REQUIRE(clamped[2].y == -2.f);
+
+    auto const shifted = views::subtract(std::vector<vec3>{{1, 1, 1}}, 1);
+    REQUIRE(shifted[0].z == 0.f);
+
+    // integer vectors are computed in the type of the operation
+    std::vector<ivec2> const cells{{3, 5}};
+    REQUIRE((points | views::scale(0.5))[0].x == 0.5f);
+    REQUIRE((cells | views::scale(0.5))[0].y == 2);
+}
+
+TEST_CASE("views:pipelines", "[views]") {
+    std::vector<vec2> points;
+    for (int i = 0; i < 50; ++i) {
+        points.push_back({float(i % 7) - 3.f, float(i % 11) - 5.f});
+    }
+
+    // fused adaptors apply the same steps as a chain of separate views
+    auto const steps = views::add(vec2{1, 1}) | views::scale(3.f) | views::clamp(-6, 12);
+    auto const fused = points | steps;
+    auto const chained = points | views::add(vec2{1, 1}) | views::scale(3.f) |
+                         views::clamp(-6, 12);
+    REQUIRE(std::ranges::equal(fused, chained, [](vec2 a, vec2 b) {
+        return a.x == b.x and a.y == b.y;
+    }));
+
+    auto const [lower, upper] = bounding_corners2d(fused);
+    REQUIRE(lower.x == -6.f);
+    REQUIRE(lower.y == -6.f);
+    REQUIRE(upper.x == 12.f);
+    REQUIRE(upper.y == 12.f);
+
+    // the adaptors mix with the standard views, which may not be const-iterable
+    auto positive = points | std::views::filter([](vec2 p) { return p.x > 0; }) |
+                    views::subtract(vec2{1, 0}) | std::views::take(3);
+    auto const [low, high] = bounding_corners2d(positive);
+    REQUIRE(low.x == 0.f);
+    REQUIRE(high.x == 2.f);
+    REQUIRE(low.y == -1.f);
+    REQUIRE(high.y == 1.f);
+}
+
+TEST_CASE("bounding_corners2d:single pass", "[views]") {
+    // each point is produced once, even through a lazy view
+    int visits = 0;
+    std::vector<vec2> const points{{4, -1}, {-2, 3}, {0, 0}};
+    auto const counted = points | std::views::transform([&](vec2 p) {
+        ++visits;
+        return p;
+    });
+    auto const [lower, upper] = bounding_corners2d(counted);
+    REQUIRE(visits == 3);
+    REQUIRE(lower.x == -2.f);
+    REQUIRE(lower.y == -1.f);
+    REQUIRE(upper.x == 4.f);
+    REQUIRE(upper.y == 3.f);
+}